@@ -0,0 +1,173 @@
+// ============================================================================
+// Arquivo: anel_io_uring.cpp
+// Finalidade: Implementa o anel io_uring (io_uring_setup, mmap das filas e
+//             io_uring_enter). Fora do Linux, abrir() sempre falha.
+// ============================================================================
+#include "anel_io_uring.hpp"
+#include <cerrno>
+
+#ifdef __linux__
+#include <cstring>              // std::memset
+#include <fcntl.h>              // AT_SYMLINK_NOFOLLOW
+#include <linux/io_uring.h>     // io_uring_params, io_uring_sqe, io_uring_cqe
+#include <sys/mman.h>           // mmap, munmap
+#include <sys/stat.h>           // struct statx
+#include <sys/syscall.h>        // __NR_io_uring_setup, __NR_io_uring_enter
+#include <unistd.h>             // close, syscall
+
+// As cabeças e caudas são compartilhadas com o kernel: leituras com acquire
+// e escritas com release, como na liburing
+static unsigned lerAdquirindo(const unsigned* p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+static void gravarLiberando(unsigned* p, unsigned valor) {
+    __atomic_store_n(p, valor, __ATOMIC_RELEASE);
+}
+
+AnelIoUring::~AnelIoUring() {
+    fechar();
+}
+
+void AnelIoUring::fechar() {
+    if (sqes) ::munmap(sqes, bytesSqes);
+    if (mapaCq && mapaCq != mapaSq) ::munmap(mapaCq, bytesCq);
+    if (mapaSq) ::munmap(mapaSq, bytesSq);
+    if (descritor >= 0) ::close(descritor);
+    sqes = nullptr;
+    mapaSq = mapaCq = nullptr;
+    descritor = -1;
+    entradasSq = preparados = 0;
+}
+
+// ============================================================================
+// Método: abrir
+// ============================================================================
+bool AnelIoUring::abrir(unsigned entradas, int* erro) {
+    io_uring_params p;
+    std::memset(&p, 0, sizeof(p));
+    int fd = static_cast<int>(::syscall(__NR_io_uring_setup, entradas, &p));
+    if (fd < 0) {
+        if (erro) *erro = errno;
+        return false;
+    }
+    descritor = fd;
+    entradasSq = p.sq_entries;
+
+    bytesSq = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    bytesCq = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    bool mapaUnico = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (mapaUnico && bytesCq > bytesSq) bytesSq = bytesCq;
+
+    auto mapear = [&](size_t bytes, off_t deslocamento) -> void* {
+        void* m = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, fd, deslocamento);
+        return m == MAP_FAILED ? nullptr : m;
+    };
+    mapaSq = mapear(bytesSq, IORING_OFF_SQ_RING);
+    mapaCq = mapaUnico ? mapaSq : mapear(bytesCq, IORING_OFF_CQ_RING);
+    bytesSqes = p.sq_entries * sizeof(io_uring_sqe);
+    sqes = static_cast<io_uring_sqe*>(mapear(bytesSqes, IORING_OFF_SQES));
+    if (!mapaSq || !mapaCq || !sqes) {
+        if (erro) *erro = errno;
+        return false;                   // O destrutor desfaz o que foi feito
+    }
+
+    char* sq = static_cast<char*>(mapaSq);
+    sqCabeca  = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+    sqCauda   = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+    sqMascara = reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+    sqIndices = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+
+    char* cq = static_cast<char*>(mapaCq);
+    cqCabeca  = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+    cqCauda   = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+    cqMascara = reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+    cqes      = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+    return true;
+}
+
+// ============================================================================
+// Método: prepararStatx
+// ============================================================================
+bool AnelIoUring::prepararStatx(int dirfd, const char* nome, int flags, unsigned mascara,
+                                struct statx* destino, uint64_t dado) {
+    unsigned cauda = *sqCauda;                  // Só esta thread escreve a cauda
+    if (cauda - lerAdquirindo(sqCabeca) >= entradasSq) return false;
+
+    unsigned indice = cauda & *sqMascara;
+    io_uring_sqe* sqe = &sqes[indice];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_STATX;
+    sqe->fd = dirfd;
+    sqe->addr = reinterpret_cast<uint64_t>(nome);
+    sqe->len = mascara;
+    sqe->off = reinterpret_cast<uint64_t>(destino);
+    sqe->statx_flags = static_cast<uint32_t>(flags);
+    sqe->user_data = dado;
+    sqIndices[indice] = indice;
+
+    gravarLiberando(sqCauda, cauda + 1);
+    ++preparados;
+    return true;
+}
+
+// ============================================================================
+// Método: enviar
+// ============================================================================
+int AnelIoUring::enviar(unsigned minimo) {
+    unsigned flags = minimo > 0 ? IORING_ENTER_GETEVENTS : 0;
+    while (true) {
+        long r = ::syscall(__NR_io_uring_enter, descritor, preparados, minimo, flags,
+                           nullptr, 0);
+        if (r >= 0) {
+            preparados -= static_cast<unsigned>(r);
+            return static_cast<int>(r);
+        }
+        if (errno != EINTR) return -errno;
+    }
+}
+
+// ============================================================================
+// Método: esperarConclusoes
+// ============================================================================
+int AnelIoUring::esperarConclusoes(unsigned minimo) {
+    while (true) {
+        long r = ::syscall(__NR_io_uring_enter, descritor, 0, minimo, IORING_ENTER_GETEVENTS,
+                           nullptr, 0);
+        if (r >= 0) return 0;
+        if (errno != EINTR) return -errno;
+    }
+}
+
+bool AnelIoUring::proximaConclusao(uint64_t& dado, int& resultado) {
+    unsigned cabeca = *cqCabeca;                // Só esta thread escreve a cabeça
+    if (cabeca == lerAdquirindo(cqCauda)) return false;
+    const io_uring_cqe& cqe = cqes[cabeca & *cqMascara];
+    dado = cqe.user_data;
+    resultado = cqe.res;
+    gravarLiberando(cqCabeca, cabeca + 1);
+    return true;
+}
+
+#else  // !__linux__
+
+AnelIoUring::~AnelIoUring() {}
+
+void AnelIoUring::fechar() {}
+
+bool AnelIoUring::abrir(unsigned, int* erro) {
+    if (erro) *erro = ENOSYS;
+    return false;
+}
+
+bool AnelIoUring::prepararStatx(int, const char*, int, unsigned, struct statx*, uint64_t) {
+    return false;
+}
+
+int AnelIoUring::enviar(unsigned) { return -ENOSYS; }
+
+int AnelIoUring::esperarConclusoes(unsigned) { return -ENOSYS; }
+
+bool AnelIoUring::proximaConclusao(uint64_t&, int&) { return false; }
+
+#endif // __linux__
@@ -0,0 +1,107 @@
+// ============================================================================
+// Arquivo: anel_io_uring.hpp
+// Finalidade: Declarar um anel io_uring mínimo, usado pela varredura para
+//             manter muitas consultas de metadados (statx) em voo a partir de
+//             poucas threads. Usa as chamadas de sistema diretamente, sem a
+//             liburing.
+// ============================================================================
+#ifndef ANEL_IO_URING_HPP
+#define ANEL_IO_URING_HPP
+
+#include <cstddef>                    // size_t
+#include <cstdint>                    // uint64_t
+
+struct statx;
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+// ============================================================================
+// Classe: AnelIoUring
+// Objetivo: Fila de submissão e fila de conclusão mapeadas em memória. Uso:
+//           prepararStatx() para cada pedido (até capacidade() sem resposta),
+//           enviar() para entregar ao kernel e, opcionalmente, esperar, e
+//           colher() para ler as respostas. Cada anel pertence a uma thread.
+//           Se enviar() falhar, esperarConclusoes() recolhe o que o kernel já
+//           aceitou antes de os destinos serem liberados, e fechar() desfaz o
+//           anel (os pedidos não entregues são descartados).
+// ============================================================================
+class AnelIoUring {
+public:
+    AnelIoUring() = default;
+    ~AnelIoUring();
+
+    AnelIoUring(const AnelIoUring&) = delete;
+    AnelIoUring& operator=(const AnelIoUring&) = delete;
+
+    // Cria o anel com "entradas" posições (arredondado pelo kernel para
+    // potência de 2). Retorna false se o io_uring não estiver disponível
+    // (kernel antigo ou bloqueado por seccomp); "erro" recebe o errno.
+    bool abrir(unsigned entradas, int* erro = nullptr);
+
+    bool aberto() const { return descritor >= 0; }
+    unsigned capacidade() const { return entradasSq; }
+    unsigned naoEnviados() const { return preparados; }   // Preparados, ainda não entregues
+
+    // Libera as filas e o descritor (também feito pelo destrutor)
+    void fechar();
+
+    // Enfileira um statx de "nome" relativo a "dirfd"; "dado" volta na
+    // conclusão. "nome" e "destino" precisam valer até a resposta chegar.
+    // Retorna false se a fila de submissão estiver cheia.
+    bool prepararStatx(int dirfd, const char* nome, int flags, unsigned mascara,
+                       struct statx* destino, uint64_t dado);
+
+    // Entrega os pedidos preparados e espera até "minimo" conclusões
+    // Retorno: pedidos aceitos pelo kernel ou -errno
+    int enviar(unsigned minimo);
+
+    // Espera até "minimo" conclusões sem entregar novos pedidos
+    // Retorno: 0 ou -errno
+    int esperarConclusoes(unsigned minimo);
+
+    // Chama acao(dado, resultado) para cada conclusão disponível (resultado
+    // negativo = -errno). Retorna o número de conclusões lidas.
+    template <typename Acao>
+    unsigned colher(Acao acao);
+
+private:
+    bool proximaConclusao(uint64_t& dado, int& resultado);
+
+    int descritor = -1;
+    unsigned entradasSq = 0;
+    unsigned preparados = 0;              // Na fila, ainda não entregues
+
+    // Fila de submissão
+    unsigned* sqCabeca = nullptr;
+    unsigned* sqCauda = nullptr;
+    unsigned* sqMascara = nullptr;
+    unsigned* sqIndices = nullptr;
+    io_uring_sqe* sqes = nullptr;
+
+    // Fila de conclusão
+    unsigned* cqCabeca = nullptr;
+    unsigned* cqCauda = nullptr;
+    unsigned* cqMascara = nullptr;
+    io_uring_cqe* cqes = nullptr;
+
+    // Regiões mapeadas (a de conclusão pode coincidir com a de submissão)
+    void* mapaSq = nullptr;
+    size_t bytesSq = 0;
+    void* mapaCq = nullptr;
+    size_t bytesCq = 0;
+    size_t bytesSqes = 0;
+};
+
+template <typename Acao>
+unsigned AnelIoUring::colher(Acao acao) {
+    unsigned lidas = 0;
+    uint64_t dado;
+    int resultado;
+    while (proximaConclusao(dado, resultado)) {
+        acao(dado, resultado);
+        ++lidas;
+    }
+    return lidas;
+}
+
+#endif // ANEL_IO_URING_HPP
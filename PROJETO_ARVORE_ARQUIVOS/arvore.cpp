@@ -7,6 +7,14 @@
 #include "arvore.hpp"           // Protótipos das funções e definição de Nodo
 #include <iostream>             // Para saída no terminal (std::cout)
 #include <filesystem>           // Para leitura do sistema de arquivos
+#include <algorithm>            // std::partial_sort
+#include <cstdint>              // SIZE_MAX
+#include <mutex>                // std::shared_lock
+#include <shared_mutex>         // Trava das pastas (modo observador)
+#include <utility>              // std::pair
+#include <vector>               // Pilha e filhos selecionados
+#include "percurso.hpp"         // percorrerArvore() e VisitanteArvore
+#include "serializadores.hpp"   // SerializadorTerminal
 
 namespace fs = std::filesystem; // Alias para facilitar a escrita
 
@@ -15,10 +23,13 @@ namespace fs = std::filesystem; // Alias para facilitar a escrita
 // Objetivo: Construir recursivamente uma árvore de diretórios/arquivos
 // Entrada: Caminho inicial (std::filesystem::path)
 // Retorno: Ponteiro para o nó da árvore correspondente ao caminho
+// Erros:   Usa as sobrecargas com std::error_code: o que não puder ser lido
+//          fica de fora (pastas sem permissão aparecem vazias)
 // ============================================================================
 std::shared_ptr<Nodo> construirArvore(const fs::path& caminho) {
-    // Ignora links simbólicos e caminhos inexistentes
-    if (!fs::exists(caminho) || fs::is_symlink(caminho))
+    // Ignora links simbólicos e caminhos inexistentes ou inacessíveis
+    std::error_code ec;
+    if (!fs::exists(caminho, ec) || fs::is_symlink(caminho, ec) || ec)
         return nullptr;
 
     // Cria um novo nó para o caminho atual
@@ -27,17 +38,20 @@ std::shared_ptr<Nodo> construirArvore(const fs::path& caminho) {
     nodo->nome = caminho.filename().string();
     nodo->tamanho = 0;
 
-    if (fs::is_regular_file(caminho)) {
+    if (fs::is_regular_file(caminho, ec)) {
         // Caso seja um arquivo comum
         nodo->tipo = "arquivo";
-        nodo->tamanho = fs::file_size(caminho);
+        uintmax_t tamanho = fs::file_size(caminho, ec);
+        if (ec) return nullptr;                 // Sumiu entre as consultas
+        nodo->tamanho = tamanho;
     }
-    else if (fs::is_directory(caminho)) {
+    else if (fs::is_directory(caminho, ec)) {
         // Caso seja um diretório
         nodo->tipo = "pasta";
-        for (const auto& entry : fs::directory_iterator(caminho)) {
+        fs::directory_iterator it(caminho, ec);
+        for (fs::directory_iterator fim; !ec && it != fim; it.increment(ec)) {
             // Chamada recursiva para construir os filhos
-            auto filho = construirArvore(entry.path());
+            auto filho = construirArvore(it->path());
             if (filho) {
                 nodo->filhos.push_back(filho);
                 nodo->tamanho += filho->tamanho; // Soma os tamanhos dos filhos
@@ -51,30 +65,210 @@ std::shared_ptr<Nodo> construirArvore(const fs::path& caminho) {
     return nodo;
 }
 
+// ----------------------------------------------------------------------------
+// Escreve na saída padrão pelo serializador de terminal, com buffer próprio
+// (o que estiver pendente em std::cout é enviado antes)
+// ----------------------------------------------------------------------------
+static void exibir(const Percurso& percorrer, int nivelBase) {
+    std::cout.flush();
+    SaidaBufferizada out(1);
+    SerializadorTerminal serializador(out, nivelBase);
+    serializarArvore(percorrer, serializador);
+    out.fechar();
+}
+
 // ============================================================================
 // Função: exibirArvore
 // Objetivo: Exibir a árvore de arquivos no terminal com indentação hierárquica
 // Entrada: Nodo atual (raiz ou subdiretório), nível de indentação (inicialmente 0)
 // ============================================================================
 void exibirArvore(const std::shared_ptr<Nodo>& nodo, int nivel) {
-    if (!nodo) return;
+    exibir([&](VisitanteArvore& v) { percorrerArvore(nodo, v); }, nivel);
+}
+
+// ============================================================================
+// Função: exibirArvore (árvore compacta)
+// ============================================================================
+void exibirArvore(const ArvoreCompacta& arvore) {
+    exibir([&](VisitanteArvore& v) { percorrerArvore(arvore, v); }, 0);
+}
+
+// ============================================================================
+// Exibição resumida
+// ----------------------------------------------------------------------------
+// Cada representação fornece uma "fonte" com:
+//   - info(id, nivel):                InfoNodo do nó;
+//   - tamanho(id):                    bytes do nó;
+//   - listarFilhos(id, limite, saida): até "limite" filhos em "saida",
+//                                      devolvendo o total de filhos.
+// ============================================================================
+namespace {
 
-    // Gera o prefixo de indentação de acordo com o nível
-    std::string prefixo(nivel * 4, ' '); // 4 espaços por nível
+struct FonteNodo {
+    using Id = std::shared_ptr<Nodo>;
 
-    if (nodo->tipo == "arquivo") {
-        // Imprime informações do arquivo
-        std::cout << prefixo << "├── " << nodo->nome
-                  << " (" << nodo->tamanho << " bytes)" << std::endl;
-    } else {
-        // Imprime informações do diretório
-        std::cout << prefixo << "├── " << nodo->nome
-                  << " (" << nodo->filhos.size() << " filhos, "
-                  << nodo->tamanho << " bytes)" << std::endl;
-
-        // Imprime recursivamente os filhos com maior indentação
-        for (const auto& filho : nodo->filhos) {
-            exibirArvore(filho, nivel + 1);
+    InfoNodo info(const Id& nodo, int nivel) const {
+        bool pasta = (nodo->tipo == "pasta");
+        size_t numFilhos = 0;
+        if (pasta) {
+            std::shared_lock<std::shared_mutex> lock(travaFilhos(*nodo));
+            numFilhos = nodo->filhos.size();
+        }
+        return InfoNodo{nodo->nome, nodo->caminho,
+                        pasta ? TipoNodo::Pasta : TipoNodo::Arquivo,
+                        tamanho(nodo), nodo->alocado.load(std::memory_order_relaxed),
+                        numFilhos, nivel,
+                        nodo->vinculoRepetido.load(std::memory_order_relaxed)};
+    }
+
+    uintmax_t tamanho(const Id& nodo) const {
+        return nodo->tamanho.load(std::memory_order_relaxed);
+    }
+
+    // Cópia sob a trava: o observador pode alterar a pasta durante a exibição
+    size_t listarFilhos(const Id& pasta, size_t limite, std::vector<Id>& saida) const {
+        std::shared_lock<std::shared_mutex> lock(travaFilhos(*pasta));
+        for (const auto& filho : pasta->filhos) {
+            if (saida.size() == limite) break;
+            if (filho) saida.push_back(filho);
+        }
+        return pasta->filhos.size();
+    }
+};
+
+struct FonteCompacta {
+    using Id = uint32_t;
+    const ArvoreCompacta& arvore;
+
+    // O caminho não é montado: a exibição só usa o nome
+    InfoNodo info(Id id, int nivel) const {
+        return InfoNodo{arvore.nome(id), {}, arvore.tipo(id), arvore.tamanho(id),
+                        arvore.alocado(id), arvore.numFilhos(id), nivel,
+                        arvore.vinculoRepetido(id)};
+    }
+
+    uintmax_t tamanho(Id id) const { return arvore.tamanho(id); }
+
+    size_t listarFilhos(Id pasta, size_t limite, std::vector<Id>& saida) const {
+        for (Id f = arvore.primeiroFilho(pasta);
+             f != ArvoreCompacta::NENHUM && saida.size() < limite;
+             f = arvore.proximoIrmao(f)) {
+            saida.push_back(f);
         }
+        return arvore.numFilhos(pasta);
     }
+};
+
+// ----------------------------------------------------------------------------
+// Pasta aberta na pilha: filhos a mostrar e o resumo dos que ficaram de fora
+// ----------------------------------------------------------------------------
+template <typename Id>
+struct QuadroExibicao {
+    std::vector<Id> filhos;
+    size_t proximo = 0;
+    size_t ocultos = 0;
+    uintmax_t bytesOcultos = 0;
+    int nivel = 0;                     // Nível dos filhos
+};
+
+// Seleciona os filhos de uma pasta conforme as opções
+template <typename Fonte>
+QuadroExibicao<typename Fonte::Id> abrirPasta(const Fonte& fonte, const typename Fonte::Id& pasta,
+                                              const InfoNodo& info, const OpcoesExibicao& opcoes) {
+    QuadroExibicao<typename Fonte::Id> quadro;
+    quadro.nivel = info.nivel + 1;
+    size_t limite = opcoes.filhosPorPasta ? opcoes.filhosPorPasta : SIZE_MAX;
+
+    // Sem ordenação, só os primeiros "limite" filhos são lidos
+    size_t total = fonte.listarFilhos(pasta, opcoes.ordenarPorTamanho ? SIZE_MAX : limite,
+                                      quadro.filhos);
+    if (opcoes.ordenarPorTamanho) {
+        // Ordena (tamanho, posição) só até "limite": empates mantêm a ordem da pasta
+        std::vector<std::pair<uintmax_t, size_t>> ordem;
+        ordem.reserve(quadro.filhos.size());
+        for (size_t i = 0; i < quadro.filhos.size(); ++i) {
+            ordem.emplace_back(fonte.tamanho(quadro.filhos[i]), i);
+        }
+        size_t k = std::min(limite, ordem.size());
+        std::partial_sort(ordem.begin(), ordem.begin() + k, ordem.end(),
+                          [](const auto& a, const auto& b) {
+                              return a.first != b.first ? a.first > b.first : a.second < b.second;
+                          });
+        std::vector<typename Fonte::Id> escolhidos;
+        escolhidos.reserve(k);
+        for (size_t i = 0; i < k; ++i) escolhidos.push_back(std::move(quadro.filhos[ordem[i].second]));
+        quadro.filhos = std::move(escolhidos);
+    }
+
+    uintmax_t mostrados = 0;
+    for (const auto& f : quadro.filhos) mostrados += fonte.tamanho(f);
+    quadro.ocultos = total > quadro.filhos.size() ? total - quadro.filhos.size() : 0;
+    quadro.bytesOcultos = info.tamanho > mostrados ? info.tamanho - mostrados : 0;
+    return quadro;
+}
+
+// ----------------------------------------------------------------------------
+// Pré-ordem limitada com pilha explícita, escrevendo pelo serializador de
+// terminal. Cada linha é contada; ao completar uma página, o buffer é
+// enviado e "proximaPagina" decide se continua.
+// ----------------------------------------------------------------------------
+template <typename Fonte>
+void exibirLimitado(const Fonte& fonte, const typename Fonte::Id& raiz,
+                    const OpcoesExibicao& opcoes) {
+    std::cout.flush();
+    SaidaBufferizada out(1);
+    SerializadorTerminal terminal(out);
+
+    size_t linhas = 0;
+    auto continuar = [&]() {
+        if (opcoes.linhasPorPagina == 0 || ++linhas % opcoes.linhasPorPagina != 0) return true;
+        out.descarregar();
+        return !opcoes.proximaPagina || opcoes.proximaPagina();
+    };
+    auto podeAbrir = [&](const InfoNodo& info) {
+        return info.tipo == TipoNodo::Pasta && info.numFilhos > 0 &&
+               (opcoes.profundidadeMaxima < 0 || info.nivel < opcoes.profundidadeMaxima);
+    };
+
+    std::vector<QuadroExibicao<typename Fonte::Id>> pilha;
+    InfoNodo infoRaiz = fonte.info(raiz, 0);
+    terminal.entrar(infoRaiz);
+    if (continuar() && podeAbrir(infoRaiz)) {
+        pilha.push_back(abrirPasta(fonte, raiz, infoRaiz, opcoes));
+    }
+
+    while (!pilha.empty()) {
+        auto& topo = pilha.back();
+        if (topo.proximo == topo.filhos.size()) {
+            bool segue = true;
+            if (topo.ocultos > 0) {
+                terminal.resumo(topo.nivel, topo.ocultos, topo.bytesOcultos);
+                segue = continuar();
+            }
+            pilha.pop_back();
+            if (!segue) break;
+            continue;
+        }
+        typename Fonte::Id filho = std::move(topo.filhos[topo.proximo++]);
+        InfoNodo info = fonte.info(filho, topo.nivel);
+        terminal.entrar(info);
+        if (!continuar()) break;
+        if (podeAbrir(info)) {
+            pilha.push_back(abrirPasta(fonte, filho, info, opcoes));   // "topo" deixa de ser válido
+        }
+    }
+    out.fechar();
+}
+
+} // namespace
+
+// ============================================================================
+// Função: exibirArvore (resumida)
+// ============================================================================
+void exibirArvore(const std::shared_ptr<Nodo>& raiz, const OpcoesExibicao& opcoes) {
+    if (raiz) exibirLimitado(FonteNodo{}, raiz, opcoes);
+}
+
+void exibirArvore(const ArvoreCompacta& arvore, const OpcoesExibicao& opcoes) {
+    if (!arvore.vazia()) exibirLimitado(FonteCompacta{arvore}, arvore.raiz(), opcoes);
 }
@@ -8,7 +8,9 @@
 
 #include <memory>                     // Para std::shared_ptr
 #include <filesystem>                 // Para std::filesystem::path
+#include <functional>                 // Para std::function (paginação)
 #include "nodo.hpp"                   // Estrutura de dados Nodo
+#include "arvore_compacta.hpp"        // ArvoreCompacta
 
 // ============================================================================
 // Função: construirArvore
@@ -26,4 +28,35 @@ std::shared_ptr<Nodo> construirArvore(const std::filesystem::path& caminho);
 // ============================================================================
 void exibirArvore(const std::shared_ptr<Nodo>& nodo, int nivel = 0);
 
+// ============================================================================
+// Função: exibirArvore (árvore compacta)
+// Objetivo: Mesma exibição, sobre a representação compacta.
+// ============================================================================
+void exibirArvore(const ArvoreCompacta& arvore);
+
+// ============================================================================
+// Estrutura: OpcoesExibicao
+// Objetivo: Limites da exibição resumida. Só são lidos os filhos das pastas
+//           que aparecem na tela, então o custo acompanha o que é mostrado,
+//           não o tamanho da árvore.
+// ============================================================================
+struct OpcoesExibicao {
+    int profundidadeMaxima = -1;       // Pastas abaixo disso não são abertas (-1 = sem limite)
+    size_t filhosPorPasta = 0;         // Demais filhos viram "... N mais" (0 = todos)
+    bool ordenarPorTamanho = false;    // Maiores filhos primeiro
+    size_t linhasPorPagina = 0;        // 0 = tudo de uma vez
+
+    // Chamada ao fim de cada página (já enviada ao terminal); false encerra
+    std::function<bool()> proximaPagina;
+};
+
+// ============================================================================
+// Função: exibirArvore (resumida)
+// Objetivo: Exibe a árvore no mesmo formato, respeitando os limites pedidos.
+//           A saída passa por um único buffer, enviado ao fim de cada página
+//           (ou ao final, sem paginação).
+// ============================================================================
+void exibirArvore(const std::shared_ptr<Nodo>& raiz, const OpcoesExibicao& opcoes);
+void exibirArvore(const ArvoreCompacta& arvore, const OpcoesExibicao& opcoes);
+
 #endif // ARVORE_HPP
@@ -0,0 +1,395 @@
+// ============================================================================
+// Arquivo: arvore_compacta.cpp
+// Finalidade: Implementa a conversão para a árvore compacta, a reconstrução
+//             de caminhos e o relatório de memória.
+// ============================================================================
+#include "arvore_compacta.hpp"
+#include <algorithm>            // std::sort, std::binary_search
+#include <fstream>              // /proc/self/status
+#include <functional>           // std::hash<std::string_view>
+#include <stdexcept>            // std::length_error
+#include <type_traits>          // std::is_pointer_v
+#include <unordered_map>        // Links físicos (vinculoRepetido)
+#include <unordered_set>        // Internação de nomes
+#include <utility>
+#include <vector>
+#include <sys/resource.h>       // getrusage (pico de memória sem /proc)
+#ifdef __GLIBC__
+#include <malloc.h>             // malloc_trim
+#endif
+
+// Vetores próprios de uma árvore compacta construída em memória
+struct DadosCompactos {
+    std::vector<uint32_t> pai, primeiroFilho, proximoIrmao, numFilhos, nomeId;
+    std::vector<uint64_t> tamanho, assinatura, alocado, vinculo;
+    std::vector<uint8_t>  tipo;
+    std::vector<uint32_t> nomeInicio{0};
+    std::vector<char>     nomes;
+
+    std::string_view nome(uint32_t id) const {
+        return std::string_view(nomes.data() + nomeInicio[id],
+                                nomeInicio[id + 1] - nomeInicio[id]);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Conjunto de nomes já internados. Os elementos são índices de nome; o hash e
+// a comparação leem os caracteres diretamente do bloco de nomes.
+// ----------------------------------------------------------------------------
+struct HashNome {
+    const DadosCompactos* dados;
+    size_t operator()(uint32_t id) const {
+        return std::hash<std::string_view>()(dados->nome(id));
+    }
+};
+struct IgualNome {
+    const DadosCompactos* dados;
+    bool operator()(uint32_t a, uint32_t b) const {
+        return dados->nome(a) == dados->nome(b);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Devolve o índice do nome, acrescentando-o ao bloco apenas se for novo.
+// O nome é anexado provisoriamente e removido se já existia.
+// ----------------------------------------------------------------------------
+static uint32_t internarNome(DadosCompactos& d,
+                             std::unordered_set<uint32_t, HashNome, IgualNome>& conjunto,
+                             const std::string& nome) {
+    if (d.nomes.size() + nome.size() > 0xFFFFFFFFu) {
+        throw std::length_error("bloco de nomes da árvore compacta excede 4 GiB");
+    }
+    uint32_t candidato = static_cast<uint32_t>(d.nomeInicio.size() - 1);
+    d.nomes.insert(d.nomes.end(), nome.begin(), nome.end());
+    d.nomeInicio.push_back(static_cast<uint32_t>(d.nomes.size()));
+
+    auto [it, novo] = conjunto.insert(candidato);
+    if (!novo) {
+        d.nomeInicio.pop_back();
+        d.nomes.resize(d.nomeInicio.back());
+    }
+    return *it;
+}
+
+// ----------------------------------------------------------------------------
+// Numera os nós em pré-ordem (pilha explícita) e preenche os vetores, ligando
+// cada nó ao pai e ao irmão anterior. "Ref" é const Nodo* (a árvore de Nodo
+// é preservada) ou std::shared_ptr<Nodo>: nesse caso os filhos saem do nó
+// para a pilha, e cada nó é liberado logo depois de convertido.
+// ----------------------------------------------------------------------------
+constexpr uint32_t NODOS_POR_DEVOLUCAO = 32768;   // Nós liberados entre dois malloc_trim
+
+template <typename Ref>
+static void preencherVetores(DadosCompactos& d, Ref raiz) {
+    constexpr uint32_t NENHUM = ArvoreCompacta::NENHUM;
+    std::unordered_set<uint32_t, HashNome, IgualNome> conjunto(
+        1024, HashNome{&d}, IgualNome{&d});
+    std::vector<uint32_t> ultimoFilho;          // Temporário: último filho ligado
+
+    std::vector<std::pair<Ref, uint32_t>> pilha;   // (nó, id do pai)
+    pilha.emplace_back(std::move(raiz), NENHUM);
+    while (!pilha.empty()) {
+        auto [nodo, paiId] = std::move(pilha.back());
+        pilha.pop_back();
+
+        if (d.pai.size() >= NENHUM) {
+            throw std::length_error("árvore compacta limitada a 2^32 - 1 nós");
+        }
+        uint32_t id = static_cast<uint32_t>(d.pai.size());
+        d.pai.push_back(paiId);
+        d.primeiroFilho.push_back(NENHUM);
+        d.proximoIrmao.push_back(NENHUM);
+        d.numFilhos.push_back(0);
+        d.nomeId.push_back(internarNome(d, conjunto, nodo->nome));
+        d.tamanho.push_back(nodo->tamanho);
+        d.assinatura.push_back(nodo->assinatura);
+        d.alocado.push_back(nodo->alocado);
+        d.vinculo.push_back(nodo->vinculo);
+        d.tipo.push_back(static_cast<uint8_t>(
+            nodo->tipo == "pasta" ? TipoNodo::Pasta : TipoNodo::Arquivo));
+        ultimoFilho.push_back(NENHUM);
+
+        if (paiId != NENHUM) {
+            if (ultimoFilho[paiId] == NENHUM) d.primeiroFilho[paiId] = id;
+            else d.proximoIrmao[ultimoFilho[paiId]] = id;
+            ultimoFilho[paiId] = id;
+            ++d.numFilhos[paiId];
+        }
+
+        // Empilha os filhos em ordem inversa para visitá-los na ordem original
+        for (auto it = nodo->filhos.rbegin(); it != nodo->filhos.rend(); ++it) {
+            if (!*it) continue;
+            if constexpr (std::is_pointer_v<Ref>) pilha.emplace_back(it->get(), id);
+            else pilha.emplace_back(std::move(*it), id);
+        }
+#ifdef __GLIBC__
+        // Os nós liberados continuam residentes no heap, e os vetores (grandes)
+        // vêm de páginas novas: devolvê-los ao sistema de tempos em tempos é o
+        // que impede que o pico some as duas árvores
+        if constexpr (!std::is_pointer_v<Ref>) {
+            if (id % NODOS_POR_DEVOLUCAO == NODOS_POR_DEVOLUCAO - 1) {
+                nodo.reset();
+                malloc_trim(0);
+            }
+        }
+#endif
+    }
+#ifdef __GLIBC__
+    if constexpr (!std::is_pointer_v<Ref>) malloc_trim(0);
+#endif
+}
+
+// Aponta a árvore para os vetores próprios de "d"
+static ArvoreCompacta montarArvore(std::shared_ptr<DadosCompactos> d, std::string caminhoRaiz) {
+    ArvoreCompacta::Vetores v;
+    v.numNodos = static_cast<uint32_t>(d->pai.size());
+    v.numNomes = static_cast<uint32_t>(d->nomeInicio.size() - 1);
+    v.bytesNomes = d->nomes.size();
+    v.pai = d->pai.data();
+    v.primeiroFilho = d->primeiroFilho.data();
+    v.proximoIrmao = d->proximoIrmao.data();
+    v.numFilhos = d->numFilhos.data();
+    v.nomeId = d->nomeId.data();
+    v.tamanho = d->tamanho.data();
+    v.assinatura = d->assinatura.data();
+    v.alocado = d->alocado.data();
+    v.vinculo = d->vinculo.data();
+    v.tipo = d->tipo.data();
+    v.nomeInicio = d->nomeInicio.data();
+    v.nomes = d->nomes.data();
+    return ArvoreCompacta::deVetores(v, std::move(caminhoRaiz), std::move(d));
+}
+
+// ============================================================================
+// Função: ArvoreCompacta::deNodo
+// ============================================================================
+ArvoreCompacta ArvoreCompacta::deNodo(const std::shared_ptr<Nodo>& raiz) {
+    if (!raiz) return ArvoreCompacta();
+    auto d = std::make_shared<DadosCompactos>();
+    preencherVetores<const Nodo*>(*d, raiz.get());
+    return montarArvore(std::move(d), raiz->caminho);
+}
+
+// Consome a árvore: o pico de memória fica perto do maior dos dois formatos,
+// e não da soma deles (se não houver outras referências aos nós)
+ArvoreCompacta ArvoreCompacta::deNodo(std::shared_ptr<Nodo>&& raiz) {
+    if (!raiz) return ArvoreCompacta();
+    auto d = std::make_shared<DadosCompactos>();
+    std::string caminhoRaiz = raiz->caminho;
+    preencherVetores<std::shared_ptr<Nodo>>(*d, std::move(raiz));
+    return montarArvore(std::move(d), std::move(caminhoRaiz));
+}
+
+ArvoreCompacta ArvoreCompacta::deVetores(const Vetores& v, std::string caminhoRaiz,
+                                         std::shared_ptr<const void> dono) {
+    ArvoreCompacta arvore;
+    arvore.quantidade = v.numNodos;
+    arvore.quantidadeNomes = v.numNomes;
+    arvore.bytesNomes = v.bytesNomes;
+    arvore.raizCaminho = std::move(caminhoRaiz);
+    arvore.vPai = v.pai;
+    arvore.vPrimeiroFilho = v.primeiroFilho;
+    arvore.vProximoIrmao = v.proximoIrmao;
+    arvore.vNumFilhos = v.numFilhos;
+    arvore.vNomeId = v.nomeId;
+    arvore.vTamanho = v.tamanho;
+    arvore.vAssinatura = v.assinatura;
+    arvore.vAlocado = v.alocado;
+    arvore.vVinculo = v.vinculo;
+    arvore.vTipo = v.tipo;
+    arvore.vNomeInicio = v.nomeInicio;
+    arvore.vNomes = v.nomes;
+    arvore.dono = std::move(dono);
+    if (v.vinculo) arvore.marcas = std::make_shared<MarcasVinculo>();
+    return arvore;
+}
+
+// ============================================================================
+// Método: vinculoRepetido
+// Objetivo: Na primeira consulta de um arquivo com vínculo, percorre o vetor
+//           de vínculos e escolhe, para cada inode, o link de menor caminho;
+//           os demais ficam na lista ordenada de repetidos.
+// ============================================================================
+bool ArvoreCompacta::vinculoRepetido(uint32_t id) const {
+    if (!marcas || vVinculo[id] == 0) return false;
+    std::call_once(marcas->calculadas, [this] {
+        std::unordered_map<uint64_t, uint32_t> donos;   // Vínculo -> link que conta
+        std::unordered_map<uint32_t, std::string> caminhos;
+        auto caminhoDe = [&](uint32_t n) -> const std::string& {
+            auto it = caminhos.find(n);
+            if (it == caminhos.end()) it = caminhos.emplace(n, caminho(n)).first;
+            return it->second;
+        };
+        std::vector<uint32_t>& repetidos = marcas->repetidos;
+        for (uint32_t n = 0; n < quantidade; ++n) {
+            if (vVinculo[n] == 0) continue;
+            auto [it, novo] = donos.emplace(vVinculo[n], n);
+            if (novo) continue;
+            if (caminhoDe(n) < caminhoDe(it->second)) {
+                repetidos.push_back(it->second);
+                it->second = n;
+            } else {
+                repetidos.push_back(n);
+            }
+        }
+        std::sort(repetidos.begin(), repetidos.end());
+    });
+    return std::binary_search(marcas->repetidos.begin(), marcas->repetidos.end(), id);
+}
+
+ArvoreCompacta::Vetores ArvoreCompacta::vetores() const {
+    Vetores v;
+    v.numNodos = quantidade;
+    v.numNomes = quantidadeNomes;
+    v.bytesNomes = bytesNomes;
+    v.pai = vPai;
+    v.primeiroFilho = vPrimeiroFilho;
+    v.proximoIrmao = vProximoIrmao;
+    v.numFilhos = vNumFilhos;
+    v.nomeId = vNomeId;
+    v.tamanho = vTamanho;
+    v.assinatura = vAssinatura;
+    v.alocado = vAlocado;
+    v.vinculo = vVinculo;
+    v.tipo = vTipo;
+    v.nomeInicio = vNomeInicio;
+    v.nomes = vNomes;
+    return v;
+}
+
+std::string_view ArvoreCompacta::nome(uint32_t id) const {
+    uint32_t n = vNomeId[id];
+    return std::string_view(vNomes + vNomeInicio[n], vNomeInicio[n + 1] - vNomeInicio[n]);
+}
+
+// ----------------------------------------------------------------------------
+// Sobe do nó até a raiz guardando os nomes e depois os junta a partir do
+// caminho da raiz (sem separador duplicado quando ele já termina em '/').
+// ----------------------------------------------------------------------------
+std::string ArvoreCompacta::caminho(uint32_t id) const {
+    std::vector<std::string_view> partes;
+    size_t total = raizCaminho.size();
+    for (uint32_t atual = id; atual != raiz(); atual = vPai[atual]) {
+        partes.push_back(nome(atual));
+        total += 1 + partes.back().size();
+    }
+
+    std::string resultado;
+    resultado.reserve(total);
+    resultado = raizCaminho;
+    for (auto it = partes.rbegin(); it != partes.rend(); ++it) {
+        if (!resultado.empty() && resultado.back() != '/') resultado += '/';
+        resultado.append(it->data(), it->size());
+    }
+    return resultado;
+}
+
+uint64_t ArvoreCompacta::bytesUsados() const {
+    uint64_t porNodo = 5 * sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint8_t)
+                     + (vAssinatura ? sizeof(uint64_t) : 0)
+                     + (vAlocado ? sizeof(uint64_t) : 0)
+                     + (vVinculo ? sizeof(uint64_t) : 0);
+    return quantidade * porNodo
+         + (quantidadeNomes + 1) * sizeof(uint32_t)
+         + bytesNomes
+         + raizCaminho.size();
+}
+
+// ============================================================================
+// Função: expandirArvore
+// Objetivo: Como os nós estão em pré-ordem, o pai de cada nó já foi criado
+//           quando ele é visitado, e os irmãos aparecem na ordem original.
+//           A marca de link repetido vem de vinculoRepetido().
+// ============================================================================
+std::shared_ptr<Nodo> expandirArvore(const ArvoreCompacta& arvore) {
+    if (arvore.vazia()) return nullptr;
+
+    std::vector<Nodo*> porId(arvore.numNodos());
+    std::shared_ptr<Nodo> raiz;
+    for (uint32_t id = 0; id < arvore.numNodos(); ++id) {
+        auto nodo = std::make_shared<Nodo>();
+        nodo->nome = std::string(arvore.nome(id));
+        nodo->tipo = arvore.tipo(id) == TipoNodo::Pasta ? "pasta" : "arquivo";
+        nodo->tamanho = arvore.tamanho(id);
+        nodo->assinatura = arvore.assinatura(id);
+        nodo->alocado = arvore.alocado(id);
+        nodo->vinculo = arvore.vinculo(id);
+        nodo->vinculoRepetido = arvore.vinculoRepetido(id);
+        nodo->filhos.reserve(arvore.numFilhos(id));
+        porId[id] = nodo.get();
+
+        if (id == arvore.raiz()) {
+            nodo->caminho = arvore.caminhoRaiz();
+            raiz = std::move(nodo);
+            continue;
+        }
+        Nodo* pai = porId[arvore.pai(id)];
+        nodo->caminho = pai->caminho;
+        if (!nodo->caminho.empty() && nodo->caminho.back() != '/') nodo->caminho += '/';
+        nodo->caminho += nodo->nome;
+        pai->filhos.push_back(std::move(nodo));
+    }
+    return raiz;
+}
+
+// ============================================================================
+// Função: estimarBytesNodo
+// ============================================================================
+uint64_t estimarBytesNodo(const std::shared_ptr<Nodo>& raiz) {
+    // Strings curtas ficam no buffer interno; as longas alocam capacity()+1
+    auto heapString = [](const std::string& s) -> uint64_t {
+        return s.capacity() > 15 ? s.capacity() + 1 : 0;
+    };
+    // make_shared aloca objeto e contadores juntos (vtable + 2 contadores)
+    const uint64_t blocoControle = sizeof(void*) + 2 * sizeof(int);
+
+    uint64_t total = 0;
+    std::vector<const Nodo*> pilha;
+    if (raiz) pilha.push_back(raiz.get());
+    while (!pilha.empty()) {
+        const Nodo* nodo = pilha.back();
+        pilha.pop_back();
+        total += sizeof(Nodo) + blocoControle
+               + heapString(nodo->caminho) + heapString(nodo->nome) + heapString(nodo->tipo)
+               + nodo->filhos.capacity() * sizeof(std::shared_ptr<Nodo>);
+        for (const auto& filho : nodo->filhos) {
+            if (filho) pilha.push_back(filho.get());
+        }
+    }
+    return total;
+}
+
+// ============================================================================
+// Função: picoMemoriaKb
+// ============================================================================
+uint64_t picoMemoriaKb() {
+    std::ifstream status("/proc/self/status");
+    std::string linha;
+    while (std::getline(status, linha)) {
+        if (linha.compare(0, 6, "VmHWM:") == 0) return std::stoull(linha.substr(6));
+    }
+    rusage uso{};
+    getrusage(RUSAGE_SELF, &uso);
+    return static_cast<uint64_t>(uso.ru_maxrss);
+}
+
+// ============================================================================
+// Função: imprimirRelatorioMemoria
+// ============================================================================
+void imprimirRelatorioMemoria(uint64_t bytesNodo, const ArvoreCompacta& compacta,
+                              std::ostream& out) {
+    uint64_t nodos = compacta.numNodos();
+    if (nodos == 0) {
+        out << "[INFO] Árvore vazia, nada a medir.\n";
+        return;
+    }
+    uint64_t depois = compacta.bytesUsados();
+
+    out << "[INFO] Memória (" << nodos << " nós)\n"
+        << "[INFO]   Árvore de Nodo:   " << bytesNodo << " bytes ("
+        << static_cast<double>(bytesNodo) / nodos << " bytes/nó)\n"
+        << "[INFO]   Árvore compacta:  " << depois << " bytes ("
+        << static_cast<double>(depois) / nodos << " bytes/nó, "
+        << compacta.numNomesDistintos() << " nomes distintos)\n"
+        << "[INFO]   Pico do processo: " << picoMemoriaKb() << " KiB residentes\n";
+}
@@ -0,0 +1,165 @@
+// ============================================================================
+// Arquivo: arvore_compacta.hpp
+// Finalidade: Declarar uma representação compacta da árvore de arquivos, em
+//             vetores contíguos (estrutura de arrays) indexados por número de
+//             nó, com nomes internados em um único bloco de caracteres.
+// ============================================================================
+#ifndef ARVORE_COMPACTA_HPP
+#define ARVORE_COMPACTA_HPP
+
+#include <cstdint>                    // uint8_t, uint32_t, uint64_t
+#include <memory>                     // std::shared_ptr
+#include <mutex>                      // std::once_flag (marcas de link)
+#include <ostream>                    // Relatório de memória
+#include <string>                     // Caminho reconstruído
+#include <string_view>                // Nomes sem cópia
+#include <vector>                     // Links repetidos
+#include "nodo.hpp"                   // Conversão a partir da árvore de Nodo
+
+// Tipo do nó em um único byte (no Nodo é a string "arquivo"/"pasta")
+enum class TipoNodo : uint8_t { Arquivo = 0, Pasta = 1 };
+
+// ============================================================================
+// Classe: ArvoreCompacta
+// Objetivo: Guardar a árvore sem um objeto alocado por nó. Os nós são
+//           numerados em pré-ordem (a raiz é o nó 0) e cada campo fica em seu
+//           próprio vetor: pai, primeiro filho, próximo irmão, número de
+//           filhos, nome, tipo e tamanhos. Nomes repetidos (ex.: "README.md")
+//           são armazenados uma única vez, e o caminho completo é reconstruído
+//           sob demanda subindo pelos pais.
+//           Os vetores são acessados por ponteiros, o que permite que os dados
+//           venham tanto da memória própria quanto de outra origem.
+// ============================================================================
+class ArvoreCompacta {
+public:
+    static constexpr uint32_t NENHUM = 0xFFFFFFFFu;  // Ausência de pai/filho/irmão
+
+    // Ponteiros para os vetores brutos e suas dimensões (ex.: para gravar ou
+    // carregar a árvore de um arquivo sem copiar nó a nó)
+    struct Vetores {
+        uint32_t numNodos = 0;
+        uint32_t numNomes = 0;        // Nomes distintos
+        uint64_t bytesNomes = 0;
+        const uint32_t* pai = nullptr;
+        const uint32_t* primeiroFilho = nullptr;
+        const uint32_t* proximoIrmao = nullptr;
+        const uint32_t* numFilhos = nullptr;
+        const uint32_t* nomeId = nullptr;
+        const uint64_t* tamanho = nullptr;
+        const uint64_t* assinatura = nullptr;   // Pode ser nulo (snapshot v1)
+        const uint64_t* alocado = nullptr;      // Pode ser nulo (snapshot v1/v2)
+        const uint64_t* vinculo = nullptr;      // Idem
+        const uint8_t*  tipo = nullptr;
+        const uint32_t* nomeInicio = nullptr;   // numNomes + 1 elementos
+        const char*     nomes = nullptr;
+    };
+
+    ArvoreCompacta() = default;
+
+    // Converte uma árvore de Nodo (a raiz pode ser nula: árvore vazia)
+    static ArvoreCompacta deNodo(const std::shared_ptr<Nodo>& raiz);
+
+    // Idem, liberando cada nó assim que é convertido: a árvore de Nodo não
+    // convive inteira com a compacta ("raiz" fica nula)
+    static ArvoreCompacta deNodo(std::shared_ptr<Nodo>&& raiz);
+
+    // Cria uma árvore que apenas aponta para vetores existentes; "dono"
+    // mantém esses dados vivos enquanto houver cópias da árvore
+    static ArvoreCompacta deVetores(const Vetores& vetores, std::string caminhoRaiz,
+                                    std::shared_ptr<const void> dono);
+
+    // Vetores brutos desta árvore
+    Vetores vetores() const;
+
+    bool vazia() const { return quantidade == 0; }
+    uint32_t numNodos() const { return quantidade; }
+    uint32_t raiz() const { return 0; }
+
+    uint32_t pai(uint32_t id) const { return vPai[id]; }
+    uint32_t primeiroFilho(uint32_t id) const { return vPrimeiroFilho[id]; }
+    uint32_t proximoIrmao(uint32_t id) const { return vProximoIrmao[id]; }
+    uint32_t numFilhos(uint32_t id) const { return vNumFilhos[id]; }
+    TipoNodo tipo(uint32_t id) const { return static_cast<TipoNodo>(vTipo[id]); }
+    uint64_t tamanho(uint32_t id) const { return vTamanho[id]; }
+    uint64_t assinatura(uint32_t id) const { return vAssinatura ? vAssinatura[id] : 0; }
+    // Sem o vetor (snapshot antigo), o tamanho aparente faz as vezes do alocado
+    uint64_t alocado(uint32_t id) const { return vAlocado ? vAlocado[id] : vTamanho[id]; }
+    uint64_t vinculo(uint32_t id) const { return vVinculo ? vVinculo[id] : 0; }
+    // Outro link do mesmo inode já é contado (mesma regra da varredura: conta
+    // o de menor caminho). A marca não é guardada nos vetores: é refeita para
+    // a árvore inteira no primeiro uso, a partir de vinculo()
+    bool vinculoRepetido(uint32_t id) const;
+    std::string_view nome(uint32_t id) const;
+
+    // Caminho completo da raiz (os demais são relativos a ele)
+    const std::string& caminhoRaiz() const { return raizCaminho; }
+
+    // Reconstrói o caminho completo de um nó
+    std::string caminho(uint32_t id) const;
+
+    // Bytes ocupados pelos vetores e pelo bloco de nomes
+    uint64_t bytesUsados() const;
+
+    // Número de nomes distintos no bloco de nomes
+    uint32_t numNomesDistintos() const { return quantidadeNomes; }
+
+private:
+    uint32_t quantidade = 0;          // Número de nós
+    uint32_t quantidadeNomes = 0;     // Número de nomes distintos
+    uint64_t bytesNomes = 0;          // Tamanho do bloco de nomes
+    std::string raizCaminho;
+
+    const uint32_t* vPai = nullptr;
+    const uint32_t* vPrimeiroFilho = nullptr;
+    const uint32_t* vProximoIrmao = nullptr;
+    const uint32_t* vNumFilhos = nullptr;
+    const uint32_t* vNomeId = nullptr;    // Índice em vNomeInicio
+    const uint64_t* vTamanho = nullptr;
+    const uint64_t* vAssinatura = nullptr; // Assinatura das pastas (Nodo::assinatura)
+    const uint64_t* vAlocado = nullptr;    // Bytes em disco (Nodo::alocado)
+    const uint64_t* vVinculo = nullptr;    // Chave de link físico (Nodo::vinculo)
+    const uint8_t*  vTipo = nullptr;
+    const uint32_t* vNomeInicio = nullptr; // quantidadeNomes + 1 deslocamentos
+    const char*     vNomes = nullptr;      // Bloco de nomes concatenados
+
+    std::shared_ptr<const void> dono;     // Mantém vivos os dados apontados
+
+    // Ids dos links repetidos, em ordem; compartilhados pelas cópias da árvore
+    struct MarcasVinculo {
+        std::once_flag calculadas;
+        std::vector<uint32_t> repetidos;
+    };
+    std::shared_ptr<MarcasVinculo> marcas;  // Nulo sem o vetor de vínculos
+};
+
+// ============================================================================
+// Função: expandirArvore
+// Objetivo: Reconstruir a árvore de Nodo a partir da compacta (ex.: para usar
+//           um snapshot como versão anterior da atualização incremental).
+// ============================================================================
+std::shared_ptr<Nodo> expandirArvore(const ArvoreCompacta& arvore);
+
+// ============================================================================
+// Função: estimarBytesNodo
+// Objetivo: Estimar a memória ocupada pela árvore de Nodo (objetos, contadores
+//           do shared_ptr, vetores de filhos e strings fora do buffer interno).
+// ============================================================================
+uint64_t estimarBytesNodo(const std::shared_ptr<Nodo>& raiz);
+
+// ============================================================================
+// Função: picoMemoriaKb
+// Objetivo: Pico de memória residente do processo até agora, em KiB (VmHWM
+//           de /proc/self/status; sem /proc, o ru_maxrss do getrusage).
+// ============================================================================
+uint64_t picoMemoriaKb();
+
+// ============================================================================
+// Função: imprimirRelatorioMemoria
+// Objetivo: Comparar bytes por nó da árvore de Nodo (estimados antes da
+//           conversão, com estimarBytesNodo) e da árvore compacta, e mostrar
+//           o pico de memória residente do processo.
+// ============================================================================
+void imprimirRelatorioMemoria(uint64_t bytesNodo, const ArvoreCompacta& compacta,
+                              std::ostream& out);
+
+#endif // ARVORE_COMPACTA_HPP
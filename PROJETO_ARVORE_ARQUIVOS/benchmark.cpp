@@ -0,0 +1,409 @@
+// ============================================================================
+// Arquivo: benchmark.cpp
+// Finalidade: Programa de benchmarks ("make bench"). Gera uma árvore sintética
+//             em um diretório temporário e mede varredura, exibição,
+//             exportações e pesquisas, gravando os resultados em JSON para
+//             acompanhar regressões entre versões.
+// ============================================================================
+#include <algorithm>                   // std::sort
+#include <charconv>                    // std::to_chars
+#include <chrono>                      // Cronômetro
+#include <cstdlib>                     // mkdtemp
+#include <filesystem>                  // remove_all, file_size
+#include <fstream>                     // /proc/self/status
+#include <functional>                  // std::function
+#include <iostream>
+#include <string>
+#include <thread>                      // std::this_thread::yield
+#include <vector>
+
+#include <sys/resource.h>              // getrusage
+
+#include "arvore.hpp"                  // construirArvore() recursiva
+#include "varredura.hpp"               // construirArvore() com opções
+#include "arvore_compacta.hpp"         // ArvoreCompacta
+#include "percurso.hpp"                // percorrerArvore()
+#include "indices.hpp"                 // IndicesPesquisa
+#include "serializadores.hpp"          // exportarArvore()
+#include "saida_bufferizada.hpp"       // Gravação do JSON
+#include "gerador_arvore.hpp"          // gerarArvore()
+#include "comparacao.hpp"              // compararArvores()
+#include "estatisticas_arvore.hpp"     // EstatisticasArvore
+#include "navegacao.hpp"               // ArvorePreguicosa
+#include "snapshot.hpp"                // carregarSnapshot()
+#include "lote.hpp"                    // lerValorOpcao()
+
+namespace fs = std::filesystem;
+
+// ----------------------------------------------------------------------------
+// Resultado de um benchmark: tempos de cada repetição resumidos em mediana e
+// melhor tempo; "itens" é o trabalho de uma repetição (nós, bytes, consultas)
+// ----------------------------------------------------------------------------
+struct Resultado {
+    std::string nome;
+    double mediana = 0;                // Segundos
+    double melhor = 0;                 // Segundos
+    double itens = 0;
+    std::string unidade;
+    long rssPicoKb = 0;                // Pico de memória residente da medição
+};
+
+// ----------------------------------------------------------------------------
+// Pico de RSS: zera o marcador do kernel antes de cada medição (clear_refs
+// = 5) e lê VmHWM depois. Sem /proc, usa o pico do processo (getrusage).
+// ----------------------------------------------------------------------------
+static void zerarPicoRss() {
+    std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+static long lerPicoRssKb() {
+    std::ifstream status("/proc/self/status");
+    std::string linha;
+    while (std::getline(status, linha)) {
+        if (linha.compare(0, 6, "VmHWM:") == 0) return std::stol(linha.substr(6));
+    }
+    rusage uso{};
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_maxrss;
+}
+
+// ----------------------------------------------------------------------------
+// Mede "repeticoes" execuções de "tarefa" e mostra o resumo no terminal
+// ----------------------------------------------------------------------------
+static Resultado medir(const std::string& nome, unsigned repeticoes, double itens,
+                       const std::string& unidade, const std::function<void()>& tarefa) {
+    std::vector<double> tempos;
+    zerarPicoRss();
+    for (unsigned r = 0; r < repeticoes; ++r) {
+        auto inicio = std::chrono::steady_clock::now();
+        tarefa();
+        std::chrono::duration<double> duracao = std::chrono::steady_clock::now() - inicio;
+        tempos.push_back(duracao.count());
+    }
+    std::sort(tempos.begin(), tempos.end());
+
+    Resultado res{nome, tempos[tempos.size() / 2], tempos.front(), itens, unidade,
+                  lerPicoRssKb()};
+    std::cout << "[BENCH] " << nome << ": " << res.mediana * 1e3 << " ms (mediana), "
+              << (res.mediana > 0 ? itens / res.mediana : 0) << " " << unidade
+              << "/s, pico RSS " << res.rssPicoKb << " KiB\n";
+    return res;
+}
+
+// ----------------------------------------------------------------------------
+// Gravação do JSON
+// ----------------------------------------------------------------------------
+static void escreverReal(SaidaBufferizada& out, double valor) {
+    char numero[32];
+    auto fim = std::to_chars(numero, numero + sizeof(numero), valor).ptr;
+    out.escrever(std::string_view(numero, static_cast<size_t>(fim - numero)));
+}
+
+static void escreverCampo(SaidaBufferizada& out, std::string_view nome, uintmax_t valor,
+                          bool ultimo = false) {
+    out.escrever('"');
+    out.escrever(nome);
+    out.escrever("\":");
+    out.escreverNumero(valor);
+    if (!ultimo) out.escrever(',');
+}
+
+static bool gravarResultados(const std::string& arquivo, const ParametrosGerador& p,
+                             const std::string& distribuicao, unsigned repeticoes,
+                             const ResumoGerador& arvore, const std::vector<Resultado>& resultados) {
+    SaidaBufferizada out(arquivo);
+    if (!out.aberta()) return false;
+
+    out.escrever("{\n  \"parametros\": {");
+    escreverCampo(out, "ramificacao", p.ramificacao);
+    escreverCampo(out, "profundidade", p.profundidade);
+    escreverCampo(out, "arquivos_por_pasta", p.arquivosPorPasta);
+    escreverCampo(out, "tamanho_medio", p.tamanhoMedio);
+    out.escrever("\"distribuicao\":\"");
+    out.escreverJson(distribuicao);
+    out.escrever("\",");
+    escreverCampo(out, "percentual_vazias", p.percentualVazias);
+    escreverCampo(out, "semente", p.semente);
+    escreverCampo(out, "repeticoes", repeticoes, true);
+    out.escrever("},\n  \"arvore\": {");
+    escreverCampo(out, "pastas", arvore.pastas);
+    escreverCampo(out, "arquivos", arvore.arquivos);
+    escreverCampo(out, "bytes", arvore.bytes, true);
+    out.escrever("},\n  \"resultados\": [\n");
+    for (size_t i = 0; i < resultados.size(); ++i) {
+        const Resultado& r = resultados[i];
+        out.escrever("    {\"nome\":\"");
+        out.escreverJson(r.nome);
+        out.escrever("\",\"mediana_s\":");
+        escreverReal(out, r.mediana);
+        out.escrever(",\"melhor_s\":");
+        escreverReal(out, r.melhor);
+        out.escrever(",\"itens\":");
+        escreverReal(out, r.itens);
+        out.escrever(",\"unidade\":\"");
+        out.escreverJson(r.unidade);
+        out.escrever("\",\"itens_por_s\":");
+        escreverReal(out, r.mediana > 0 ? r.itens / r.mediana : 0);
+        out.escrever(",\"us_por_item\":");
+        escreverReal(out, r.itens > 0 ? r.mediana * 1e6 / r.itens : 0);
+        out.escrever(",\"rss_pico_kb\":");
+        out.escreverNumero(static_cast<uintmax_t>(r.rssPicoKb));
+        out.escrever(i + 1 < resultados.size() ? "},\n" : "}\n");
+    }
+    out.escrever("  ]\n}\n");
+    return out.fechar();
+}
+
+// Visitante que só conta os nós (custo do percurso em si)
+class VisitanteContagem : public VisitanteArvore {
+public:
+    void entrar(const InfoNodo&) override { ++nos; }
+    uint64_t nos = 0;
+};
+
+int main(int argc, char* argv[]) {
+    // ------------------------------------------------------------------------
+    // 1) Opções: forma da árvore, repetições, threads e arquivo de saída
+    // ------------------------------------------------------------------------
+    ParametrosGerador p;
+    std::string nomeDistribuicao = "exponencial";
+    unsigned repeticoes = 3;
+    unsigned threads = 0;
+    std::string arquivoSaida = "bench_resultados.json";
+    bool manter = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool temValor = i + 1 < argc;
+        // Valores numéricos: o texto inteiro, no intervalo do tipo
+        bool valido = true;
+        if (arg == "--ramificacao" && temValor)        valido = lerValorOpcao(arg, argv[++i], p.ramificacao);
+        else if (arg == "--profundidade" && temValor)  valido = lerValorOpcao(arg, argv[++i], p.profundidade);
+        else if (arg == "--arquivos" && temValor)      valido = lerValorOpcao(arg, argv[++i], p.arquivosPorPasta);
+        else if (arg == "--tamanho-medio" && temValor) valido = lerValorOpcao(arg, argv[++i], p.tamanhoMedio);
+        else if (arg == "--vazias" && temValor)        valido = lerValorOpcao(arg, argv[++i], p.percentualVazias);
+        else if (arg == "--semente" && temValor)       valido = lerValorOpcao(arg, argv[++i], p.semente);
+        else if (arg == "--repeticoes" && temValor)    valido = lerValorOpcao(arg, argv[++i], repeticoes, 1u);
+        else if (arg == "--threads" && temValor)       valido = lerValorOpcao(arg, argv[++i], threads);
+        else if (arg == "--saida" && temValor)         arquivoSaida = argv[++i];
+        else if (arg == "--manter")                    manter = true;
+        else if (arg == "--distribuicao" && temValor) {
+            nomeDistribuicao = argv[++i];
+            if (!distribuicaoPorNome(nomeDistribuicao, p.distribuicao)) {
+                std::cerr << "[ERRO] Distribuição desconhecida: " << nomeDistribuicao << "\n";
+                return 1;
+            }
+        } else {
+            std::cerr << "[ERRO] Opção desconhecida: " << arg << "\n"
+                      << "Uso: benchmark [--ramificacao N] [--profundidade N] [--arquivos N]\n"
+                      << "                [--tamanho-medio BYTES] [--distribuicao fixa|uniforme|exponencial]\n"
+                      << "                [--vazias PCT] [--semente N] [--repeticoes N] [--threads N]\n"
+                      << "                [--saida ARQ.json] [--manter]\n";
+            return 1;
+        }
+        if (!valido) return 1;
+    }
+
+    // ------------------------------------------------------------------------
+    // 2) Gerar a árvore sintética em um diretório temporário
+    // ------------------------------------------------------------------------
+    char modelo[] = "/tmp/arvore_bench_XXXXXX";
+    if (!mkdtemp(modelo)) {
+        std::cerr << "[ERRO] Não foi possível criar o diretório temporário\n";
+        return 1;
+    }
+    const std::string base = modelo;
+    const std::string raiz = base + "/arvore";
+
+    ResumoGerador resumo;
+    try {
+        auto inicio = std::chrono::steady_clock::now();
+        resumo = gerarArvore(raiz, p);
+        std::chrono::duration<double> duracao = std::chrono::steady_clock::now() - inicio;
+        std::cout << "[INFO] Árvore gerada em " << raiz << ": " << resumo.pastas << " pastas, "
+                  << resumo.arquivos << " arquivos (" << duracao.count() << " s)\n";
+    } catch (const std::exception& e) {
+        std::cerr << "[ERRO] " << e.what() << "\n";
+        fs::remove_all(base);
+        return 1;
+    }
+    const double nos = static_cast<double>(resumo.pastas + resumo.arquivos);
+
+    // ------------------------------------------------------------------------
+    // 3) Varredura (cache do sistema de arquivos já aquecido pela geração)
+    // ------------------------------------------------------------------------
+    std::vector<Resultado> resultados;
+    std::shared_ptr<Nodo> arvore;
+
+    resultados.push_back(medir("varredura_recursiva", repeticoes, nos, "nos", [&] {
+        arvore = construirArvore(fs::path(raiz));
+    }));
+    auto varredura = [&](const char* nome, unsigned nThreads, BackendVarredura backend,
+                         bool instrumentar = false) {
+        OpcoesVarredura opcoes;
+        opcoes.threads = nThreads;
+        opcoes.backend = backend;
+        opcoes.instrumentar = instrumentar;
+        resultados.push_back(medir(nome, repeticoes, nos, "nos", [&] {
+            EstatisticasVarredura estatisticas;
+            arvore.reset();
+            arvore = construirArvore(fs::path(raiz), opcoes, instrumentar ? &estatisticas : nullptr);
+        }));
+    };
+    varredura("varredura_portavel_1t", 1, BackendVarredura::Portavel);
+    varredura("varredura_posix_1t", 1, BackendVarredura::Posix);
+    varredura("varredura_posix_paralela", threads, BackendVarredura::Posix);
+    varredura("varredura_posix_paralela_instrumentada", threads, BackendVarredura::Posix, true);
+    if (ioUringDisponivel()) {
+        varredura("varredura_io_uring_paralela", threads, BackendVarredura::IoUring);
+    }
+
+    // Navegação sob demanda: primeira tela (raiz listada, cálculos de fundo
+    // interrompidos) e tempo até o tamanho da raiz ficar pronto
+    OpcoesVarredura opcoesNavegacao;
+    opcoesNavegacao.threads = threads;
+    opcoesNavegacao.backend = BackendVarredura::Posix;
+    resultados.push_back(medir("navegacao_primeira_tela", repeticoes, 1, "telas", [&] {
+        ArvorePreguicosa preguicosa(fs::path(raiz), opcoesNavegacao);
+        preguicosa.filhos(preguicosa.raiz());
+    }));
+    resultados.push_back(medir("navegacao_tamanho_raiz", repeticoes, nos, "nos", [&] {
+        ArvorePreguicosa preguicosa(fs::path(raiz), opcoesNavegacao);
+        uintmax_t tamanho = 0, alocado = 0;
+        while (!preguicosa.tamanhoPasta(*preguicosa.raiz(), tamanho, alocado)) {
+            std::this_thread::yield();
+        }
+    }));
+
+    ArvoreCompacta compacta;
+    resultados.push_back(medir("conversao_compacta", repeticoes, nos, "nos", [&] {
+        compacta = ArvoreCompacta::deNodo(arvore);
+    }));
+
+    // Carga de um snapshot (mmap + validação dos índices), com o arquivo no
+    // cache de páginas: é o tempo até o menu abrir com --carregar
+    const std::string arquivoSnapshot = base + "/arvore.snap";
+    if (salvarSnapshot(compacta, arquivoSnapshot)) {
+        resultados.push_back(medir("carregar_snapshot", repeticoes, nos, "nos", [&] {
+            ArvoreCompacta carregada;
+            carregarSnapshot(arquivoSnapshot, carregada);
+        }));
+    }
+
+    // ------------------------------------------------------------------------
+    // 4) Percurso, exibição e exportações (vazão em bytes gravados)
+    // ------------------------------------------------------------------------
+    Percurso percursoNodo = [&](VisitanteArvore& v) { percorrerArvore(arvore, v); };
+    Percurso percursoCompacta = [&](VisitanteArvore& v) { percorrerArvore(compacta, v); };
+    PercursoParalelo paraleloNodo = [&](size_t partes) { return dividirArvore(arvore, partes); };
+
+    resultados.push_back(medir("percurso_nodo", repeticoes, nos, "nos", [&] {
+        VisitanteContagem contagem;
+        percursoNodo(contagem);
+    }));
+    resultados.push_back(medir("percurso_compacta", repeticoes, nos, "nos", [&] {
+        VisitanteContagem contagem;
+        percursoCompacta(contagem);
+    }));
+
+    // Comparação da árvore com ela mesma: percorre tudo sem achar diferenças
+    struct ReceptorContagem : ReceptorDiferencas {
+        uint64_t diferencas = 0, pastas = 0;
+        void diferenca(const Diferenca&) override { ++diferencas; }
+        void pasta(const DiferencaPasta&) override { ++pastas; }
+    };
+    resultados.push_back(medir("comparacao_compacta", repeticoes, nos, "nos", [&] {
+        ReceptorContagem contagem;
+        compararArvores(compacta, compacta, contagem);
+    }));
+
+    const std::pair<const char*, FormatoSaida> formatos[] = {
+        {"terminal", FormatoSaida::Terminal}, {"html", FormatoSaida::Html},
+        {"jsonl", FormatoSaida::JsonLinhas},  {"csv", FormatoSaida::Csv},
+        {"colunar", FormatoSaida::Colunar},
+    };
+    for (const auto& [nome, formato] : formatos) {
+        std::string arquivo = base + "/saida." + nome;
+        exportarArvore(percursoNodo, formato, arquivo);       // Define os bytes gravados
+        double bytes = static_cast<double>(fs::file_size(arquivo));
+        resultados.push_back(medir(std::string("exportacao_") + nome, repeticoes, bytes, "bytes",
+                                   [&] { exportarArvore(percursoNodo, formato, arquivo); }));
+        fs::remove(arquivo);
+    }
+
+    // ------------------------------------------------------------------------
+    // 5) Pesquisas: montagem de cada índice e latência das consultas seguintes
+    // ------------------------------------------------------------------------
+    const unsigned CONSULTAS = 1000;
+    uintmax_t soma = 0;                 // Consome os resultados
+    auto consumir = [&](const FaixaIndice& faixa) {
+        for (const auto& e : faixa) soma += e.tamanho;
+    };
+    struct Pesquisa {
+        const char* nome;
+        std::function<FaixaIndice(IndicesPesquisa&)> consulta;
+    };
+    const Pesquisa pesquisas[] = {
+        {"maiores_arquivos", [](IndicesPesquisa& i) { return i.maioresArquivos(); }},
+        {"maiores_que_n", [&](IndicesPesquisa& i) { return i.arquivosMaioresQue(p.tamanhoMedio * 4); }},
+        {"por_extensao", [](IndicesPesquisa& i) { return i.arquivosPorExtensao(".txt"); }},
+        {"pastas_vazias", [](IndicesPesquisa& i) { return i.pastasVazias(); }},
+    };
+    for (const auto& pesquisa : pesquisas) {
+        resultados.push_back(medir(std::string("indice_") + pesquisa.nome, repeticoes, 1,
+                                   "montagens", [&] {
+            IndicesPesquisa indices(percursoNodo);
+            consumir(pesquisa.consulta(indices));
+        }));
+        resultados.push_back(medir(std::string("indice_") + pesquisa.nome + "_paralelo",
+                                   repeticoes, 1, "montagens", [&] {
+            IndicesPesquisa indices(percursoNodo, {}, paraleloNodo, threads);
+            consumir(pesquisa.consulta(indices));
+        }));
+        IndicesPesquisa indices(percursoNodo);
+        pesquisa.consulta(indices);                           // Monta o índice
+        resultados.push_back(medir(std::string("consulta_") + pesquisa.nome, repeticoes,
+                                   CONSULTAS, "consultas", [&] {
+            for (unsigned c = 0; c < CONSULTAS; ++c) consumir(pesquisa.consulta(indices));
+        }));
+    }
+
+    // Filtro com vários critérios: uma passada, serial e dividida entre threads
+    Filtro filtro;
+    filtro.compilar("arquivo e tamanho > " + std::to_string(p.tamanhoMedio)
+                    + " e (ext = .txt ou ext = .bin) ou vazia");
+    resultados.push_back(medir("filtro_combinado", repeticoes, nos, "nos", [&] {
+        IndicesPesquisa indices(percursoNodo, {}, {}, 1);
+        consumir(indices.filtrar(filtro));
+    }));
+    resultados.push_back(medir("filtro_combinado_paralelo", repeticoes, nos, "nos", [&] {
+        IndicesPesquisa indices(percursoNodo, {}, paraleloNodo, threads);
+        consumir(indices.filtrar(filtro));
+    }));
+    resultados.push_back(medir("estatisticas_arvore", repeticoes, nos, "nos", [&] {
+        IndicesPesquisa indices(percursoNodo, {}, {}, 1);
+        soma += indices.estatisticas().porExtensao.size();
+    }));
+    resultados.push_back(medir("estatisticas_arvore_paralelo", repeticoes, nos, "nos", [&] {
+        IndicesPesquisa indices(percursoNodo, {}, paraleloNodo, threads);
+        soma += indices.estatisticas().porExtensao.size();
+    }));
+    [[maybe_unused]] static volatile uintmax_t sumidouro;
+    sumidouro = soma;                                         // Impede descartar as consultas
+
+    // ------------------------------------------------------------------------
+    // 6) Resultados e limpeza
+    // ------------------------------------------------------------------------
+    arvore.reset();
+    if (!manter) {
+        std::error_code ec;
+        fs::remove_all(base, ec);
+    } else {
+        std::cout << "[INFO] Árvore mantida em " << raiz << "\n";
+    }
+    if (!gravarResultados(arquivoSaida, p, nomeDistribuicao, repeticoes, resumo, resultados)) {
+        std::cerr << "[ERRO] Não foi possível gravar " << arquivoSaida << "\n";
+        return 1;
+    }
+    std::cout << "[OK] Resultados gravados em " << arquivoSaida << "\n";
+    return 0;
+}
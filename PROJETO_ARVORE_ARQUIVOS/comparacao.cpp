@@ -0,0 +1,310 @@
+// ============================================================================
+// Arquivo: comparacao.cpp
+// Finalidade: Implementa a comparação de duas árvores compactas e a saída
+//             da opção "--comparar".
+// ============================================================================
+#include "comparacao.hpp"
+#include "erros_varredura.hpp"     // imprimirResumoErros()
+#include "percurso.hpp"            // anexarNome()
+#include "saida_bufferizada.hpp"   // Diferenças na saída padrão
+#include "snapshot.hpp"            // carregarSnapshot()
+#include <algorithm>
+#include <filesystem>
+#include <functional>              // std::greater
+#include <iostream>
+#include <system_error>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Um par de pastas presentes nas duas árvores, com os filhos de cada lado
+// em ordem de nome e a posição da intercalação
+struct Quadro {
+    uint32_t a = 0, b = 0;
+    std::vector<uint32_t> filhosA, filhosB;
+    size_t i = 0, j = 0;
+    size_t baseA = 0, baseB = 0;     // Comprimento dos caminhos antes do nome da pasta
+    int64_t deltaSubpastas = 0;      // Variação somada das subpastas
+};
+
+class Comparador {
+public:
+    Comparador(const ArvoreCompacta& antes, const ArvoreCompacta& depois,
+               ReceptorDiferencas& receptor)
+        : antes(antes), depois(depois), receptor(receptor),
+          caminhoA(antes.caminhoRaiz()), caminhoB(depois.caminhoRaiz()) {}
+
+    void executar() {
+        if (antes.vazia() || depois.vazia()) {
+            if (!antes.vazia()) removido(antes.raiz(), nullptr);
+            if (!depois.vazia()) adicionado(depois.raiz(), nullptr);
+            return;
+        }
+        casar(antes.raiz(), depois.raiz(), nullptr);
+
+        while (profundidade > 0) {
+            Quadro& q = pilha[profundidade - 1];
+            if (q.i == q.filhosA.size() && q.j == q.filhosB.size()) {
+                fecharPasta();
+                continue;
+            }
+            int ordem = q.i == q.filhosA.size() ? 1
+                      : q.j == q.filhosB.size() ? -1
+                      : antes.nome(q.filhosA[q.i]).compare(depois.nome(q.filhosB[q.j]));
+            if (ordem < 0) {
+                removido(q.filhosA[q.i++], &q);
+            } else if (ordem > 0) {
+                adicionado(q.filhosB[q.j++], &q);
+            } else {
+                uint32_t a = q.filhosA[q.i++], b = q.filhosB[q.j++];
+                casar(a, b, &q);       // Pode empilhar: "q" não vale mais depois
+            }
+        }
+    }
+
+private:
+    const ArvoreCompacta& antes;
+    const ArvoreCompacta& depois;
+    ReceptorDiferencas& receptor;
+    std::string caminhoA, caminhoB;
+
+    // Os quadros desempilhados ficam no vetor para reaproveitar as listas
+    std::vector<Quadro> pilha;
+    size_t profundidade = 0;
+
+    // Dois nós de mesmo nome (ou as raízes, com "pai" nulo)
+    void casar(uint32_t a, uint32_t b, Quadro* pai) {
+        bool pastaA = antes.tipo(a) == TipoNodo::Pasta;
+        bool pastaB = depois.tipo(b) == TipoNodo::Pasta;
+        if (pastaA != pastaB) {
+            removido(a, pai);
+            adicionado(b, pai);
+        } else if (pastaA) {
+            abrirPasta(a, b, pai);
+        } else if (antes.tamanho(a) != depois.tamanho(b)) {
+            size_t baseA = caminhoA.size(), baseB = caminhoB.size();
+            if (pai) anexarNome(caminhoB, depois.nome(b));
+            receptor.diferenca({TipoDiferenca::Alterado, TipoNodo::Arquivo, caminhoB,
+                                antes.tamanho(a), depois.tamanho(b)});
+            caminhoA.resize(baseA);
+            caminhoB.resize(baseB);
+        }
+    }
+
+    void removido(uint32_t a, Quadro* pai) {
+        size_t base = caminhoA.size();
+        if (pai) anexarNome(caminhoA, antes.nome(a));
+        receptor.diferenca({TipoDiferenca::Removido, antes.tipo(a), caminhoA,
+                            antes.tamanho(a), 0});
+        caminhoA.resize(base);
+        if (pai && antes.tipo(a) == TipoNodo::Pasta) {
+            pai->deltaSubpastas -= static_cast<int64_t>(antes.tamanho(a));
+        }
+    }
+
+    void adicionado(uint32_t b, Quadro* pai) {
+        size_t base = caminhoB.size();
+        if (pai) anexarNome(caminhoB, depois.nome(b));
+        receptor.diferenca({TipoDiferenca::Adicionado, depois.tipo(b), caminhoB,
+                            0, depois.tamanho(b)});
+        caminhoB.resize(base);
+        if (pai && depois.tipo(b) == TipoNodo::Pasta) {
+            pai->deltaSubpastas += static_cast<int64_t>(depois.tamanho(b));
+        }
+    }
+
+    void abrirPasta(uint32_t a, uint32_t b, Quadro* pai) {
+        size_t baseA = caminhoA.size(), baseB = caminhoB.size();
+        if (pai) {
+            anexarNome(caminhoA, antes.nome(a));
+            anexarNome(caminhoB, depois.nome(b));
+        }
+        if (profundidade == pilha.size()) pilha.emplace_back();
+        Quadro& q = pilha[profundidade++];
+        q.a = a;
+        q.b = b;
+        listarFilhos(antes, a, q.filhosA);
+        listarFilhos(depois, b, q.filhosB);
+        q.i = q.j = 0;
+        q.baseA = baseA;
+        q.baseB = baseB;
+        q.deltaSubpastas = 0;
+    }
+
+    void fecharPasta() {
+        Quadro& q = pilha[--profundidade];
+        uint64_t tamA = antes.tamanho(q.a), tamB = depois.tamanho(q.b);
+        int64_t delta = static_cast<int64_t>(tamB) - static_cast<int64_t>(tamA);
+        receptor.pasta({caminhoB, tamA, tamB, delta, delta - q.deltaSubpastas});
+        caminhoA.resize(q.baseA);
+        caminhoB.resize(q.baseB);
+        if (profundidade > 0) pilha[profundidade - 1].deltaSubpastas += delta;
+    }
+
+    static void listarFilhos(const ArvoreCompacta& arvore, uint32_t pasta,
+                             std::vector<uint32_t>& filhos) {
+        filhos.clear();
+        for (uint32_t f = arvore.primeiroFilho(pasta); f != ArvoreCompacta::NENHUM;
+             f = arvore.proximoIrmao(f)) {
+            filhos.push_back(f);
+        }
+        std::sort(filhos.begin(), filhos.end(), [&arvore](uint32_t x, uint32_t y) {
+            return arvore.nome(x) < arvore.nome(y);
+        });
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Saída do "--comparar": cada diferença é escrita na hora; das pastas só
+// ficam as maiores variações, em dois heaps mínimos de tamanho limitado
+// ----------------------------------------------------------------------------
+struct VariacaoPasta {
+    uint64_t magnitude;
+    int64_t delta;
+    int64_t deltaProprio;
+    std::string caminho;
+
+    bool operator>(const VariacaoPasta& outra) const { return magnitude > outra.magnitude; }
+};
+
+class SaidaComparacao : public ReceptorDiferencas {
+public:
+    SaidaComparacao(SaidaBufferizada& out, size_t maisPastas) : out(out), limite(maisPastas) {}
+
+    void diferenca(const Diferenca& d) override {
+        switch (d.tipo) {
+            case TipoDiferenca::Adicionado:
+                ++adicionados;
+                out.escrever("adicionado\t");
+                break;
+            case TipoDiferenca::Removido:
+                ++removidos;
+                out.escrever("removido\t");
+                break;
+            case TipoDiferenca::Alterado:
+                ++alterados;
+                out.escrever("alterado\t");
+                break;
+        }
+        if (d.tipo == TipoDiferenca::Removido) {
+            out.escrever('-');            // Também em "-0" (arquivo ou pasta vazios)
+            out.escreverNumero(d.antes);
+        } else {
+            escreverDelta(static_cast<int64_t>(d.depois) - static_cast<int64_t>(d.antes));
+        }
+        out.escrever('\t');
+        out.escreverCampo(d.caminho);
+        if (d.nodo == TipoNodo::Pasta && !d.caminho.empty() && d.caminho.back() != '/') out.escrever('/');
+        out.escrever('\n');
+    }
+
+    void pasta(const DiferencaPasta& p) override {
+        // A última pasta a chegar é a raiz
+        totalAntes = p.antes;
+        totalDepois = p.depois;
+        if (p.delta > 0) guardar(crescimentos, p);
+        if (p.delta < 0) guardar(reducoes, p);
+    }
+
+    // Escreve as pastas com maior variação e o resumo
+    void finalizar() {
+        escreverPastas("crescimento\t", crescimentos);
+        escreverPastas("reducao\t", reducoes);
+        std::cerr << "[INFO] Comparação: " << adicionados << " adicionado(s), " << removidos
+                  << " removido(s), " << alterados << " alterado(s); total " << totalAntes
+                  << " -> " << totalDepois << " bytes\n";
+    }
+
+private:
+    SaidaBufferizada& out;
+    size_t limite;
+    uint64_t adicionados = 0, removidos = 0, alterados = 0;
+    uint64_t totalAntes = 0, totalDepois = 0;
+    std::vector<VariacaoPasta> crescimentos, reducoes;
+
+    void escreverDelta(int64_t delta) {
+        out.escrever(delta < 0 ? '-' : '+');
+        out.escreverNumero(delta < 0 ? -static_cast<uint64_t>(delta) : static_cast<uint64_t>(delta));
+    }
+
+    void guardar(std::vector<VariacaoPasta>& heap, const DiferencaPasta& p) {
+        uint64_t magnitude = p.delta < 0 ? -static_cast<uint64_t>(p.delta)
+                                         : static_cast<uint64_t>(p.delta);
+        auto maior = std::greater<>();
+        if (heap.size() < limite) {
+            heap.push_back({magnitude, p.delta, p.deltaProprio, std::string(p.caminho)});
+            std::push_heap(heap.begin(), heap.end(), maior);
+        } else if (limite > 0 && magnitude > heap.front().magnitude) {
+            std::pop_heap(heap.begin(), heap.end(), maior);
+            heap.back() = {magnitude, p.delta, p.deltaProprio, std::string(p.caminho)};
+            std::push_heap(heap.begin(), heap.end(), maior);
+        }
+    }
+
+    void escreverPastas(std::string_view rotulo, std::vector<VariacaoPasta>& heap) {
+        std::sort(heap.begin(), heap.end(), [](const VariacaoPasta& x, const VariacaoPasta& y) {
+            return x.magnitude != y.magnitude ? x.magnitude > y.magnitude : x.caminho < y.caminho;
+        });
+        for (const auto& v : heap) {
+            out.escrever(rotulo);
+            escreverDelta(v.delta);
+            out.escrever('\t');
+            out.escreverCampo(v.caminho);
+            out.escrever('\t');
+            escreverDelta(v.deltaProprio);
+            out.escrever('\n');
+        }
+    }
+};
+
+} // namespace
+
+// ============================================================================
+// Função: compararArvores
+// ============================================================================
+void compararArvores(const ArvoreCompacta& antes, const ArvoreCompacta& depois,
+                     ReceptorDiferencas& receptor) {
+    Comparador(antes, depois, receptor).executar();
+}
+
+// ----------------------------------------------------------------------------
+// Um diretório é varrido e convertido; qualquer outra coisa é um snapshot
+// ----------------------------------------------------------------------------
+static bool obterArvore(const std::string& origem, const OpcoesVarredura& opcoes,
+                        ArvoreCompacta& arvore) {
+    std::error_code ec;
+    if (!fs::is_directory(origem, ec)) {
+        return carregarSnapshot(origem, arvore);
+    }
+    EstatisticasVarredura estatisticas;
+    auto raiz = construirArvore(origem, opcoes, &estatisticas);
+    imprimirResumoErros(estatisticas.erros, std::cerr);
+    arvore = ArvoreCompacta::deNodo(std::move(raiz));
+    return true;
+}
+
+// ============================================================================
+// Função: executarComparacao
+// ============================================================================
+int executarComparacao(const std::string& origemAntes, const std::string& origemDepois,
+                       const OpcoesVarredura& opcoes, size_t maisPastas) {
+    ArvoreCompacta antes, depois;
+    if (!obterArvore(origemAntes, opcoes, antes) || !obterArvore(origemDepois, opcoes, depois)) {
+        return 1;
+    }
+
+    std::cout.flush();
+    SaidaBufferizada out(1);
+    SaidaComparacao saida(out, maisPastas);
+    compararArvores(antes, depois, saida);
+    saida.finalizar();
+
+    std::string erro;
+    if (!out.fechar(&erro)) {
+        std::cerr << "[ERRO] Falha ao escrever na saída padrão: " << erro << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+// ============================================================================
+// Arquivo: comparacao.hpp
+// Finalidade: Declarar a comparação de duas árvores (duas varreduras, dois
+//             snapshots ou um de cada): arquivos adicionados, removidos e com
+//             tamanho alterado, e as pastas que mais cresceram.
+// ============================================================================
+#ifndef COMPARACAO_HPP
+#define COMPARACAO_HPP
+
+#include <cstdint>                    // uint64_t, int64_t
+#include <string>                     // Origens da comparação
+#include <string_view>                // Caminhos entregues ao receptor
+#include "arvore_compacta.hpp"        // ArvoreCompacta
+#include "varredura.hpp"              // OpcoesVarredura
+
+// ============================================================================
+// Enumeração: TipoDiferenca
+//   - Adicionado: existe só na árvore nova
+//   - Removido:   existe só na árvore antiga
+//   - Alterado:   arquivo presente nas duas com tamanhos diferentes
+// Uma pasta adicionada ou removida é uma única diferença (com o tamanho da
+// subárvore inteira), sem uma linha para cada arquivo dentro dela. Quando o
+// tipo muda (arquivo virou pasta ou o contrário), saem uma remoção e uma
+// adição.
+// ============================================================================
+enum class TipoDiferenca { Adicionado, Removido, Alterado };
+
+struct Diferenca {
+    TipoDiferenca tipo;
+    TipoNodo nodo;                // Arquivo ou Pasta
+    std::string_view caminho;     // Na árvore antiga para remoções, na nova nas demais
+    uint64_t antes;               // 0 em Adicionado
+    uint64_t depois;              // 0 em Removido
+};
+
+// ============================================================================
+// Estrutura: DiferencaPasta
+// Objetivo: Variação de uma pasta presente nas duas árvores. "delta" é a
+//           variação total da subárvore; "deltaProprio" desconta a variação
+//           das subpastas (só o que mudou nos arquivos diretos da pasta).
+// ============================================================================
+struct DiferencaPasta {
+    std::string_view caminho;     // Na árvore nova
+    uint64_t antes;
+    uint64_t depois;
+    int64_t delta;
+    int64_t deltaProprio;
+};
+
+// ============================================================================
+// Classe: ReceptorDiferencas
+// Objetivo: Recebe as diferenças à medida que a comparação anda. Os
+//           caminhos só valem durante a chamada. As pastas chegam depois do
+//           conteúdo (pós-ordem).
+// ============================================================================
+class ReceptorDiferencas {
+public:
+    virtual ~ReceptorDiferencas() = default;
+    virtual void diferenca(const Diferenca& d) = 0;
+    virtual void pasta(const DiferencaPasta&) {}
+};
+
+// ============================================================================
+// Função: compararArvores
+// Objetivo: Percorrer as duas árvores juntas, casando os filhos de cada pasta
+//           pelo nome (os filhos de cada par de pastas são ordenados e
+//           intercalados). O custo é linear no número de nós, fora a
+//           ordenação dos filhos de cada pasta; a memória extra é só a das
+//           listas de filhos das pastas no caminho atual.
+// ============================================================================
+void compararArvores(const ArvoreCompacta& antes, const ArvoreCompacta& depois,
+                     ReceptorDiferencas& receptor);
+
+// ============================================================================
+// Função: executarComparacao
+// Objetivo: Comparar "origemAntes" com "origemDepois" ("--comparar"). Cada
+//           origem é um diretório (varrido com "opcoes") ou um snapshot.
+//           As diferenças saem na saída padrão, uma por linha, à medida que
+//           são encontradas:
+//             adicionado<TAB>+bytes<TAB>caminho        (pasta: "caminho/")
+//             removido<TAB>-bytes<TAB>caminho
+//             alterado<TAB>±delta<TAB>caminho
+//           e, ao final, as "maisPastas" pastas que mais cresceram e as que
+//           mais diminuíram, da maior variação para a menor:
+//             crescimento<TAB>+delta<TAB>caminho<TAB>±deltaProprio
+//             reducao<TAB>-delta<TAB>caminho<TAB>±deltaProprio
+//           O resumo (contagens e variação total) vai para stderr.
+// Retorno: Código de saída do programa (0 = sucesso)
+// ============================================================================
+int executarComparacao(const std::string& origemAntes, const std::string& origemDepois,
+                       const OpcoesVarredura& opcoes, size_t maisPastas = 20);
+
+#endif // COMPARACAO_HPP
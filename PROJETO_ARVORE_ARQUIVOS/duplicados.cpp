@@ -0,0 +1,410 @@
+// ============================================================================
+// Arquivo: duplicados.cpp
+// Finalidade: Implementa a detecção de duplicados (XXH64, cache de hashes e
+//             leitura em paralelo pelo PoolTarefas).
+// ============================================================================
+#include "duplicados.hpp"
+#include "pool_tarefas.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <string_view>
+#include <utility>
+
+#include <fcntl.h>                     // open
+#include <sys/mman.h>                  // mmap, madvise
+#include <sys/stat.h>                  // fstat
+#include <unistd.h>                    // pread, close
+
+// ============================================================================
+// Classe: Hash64 (XXH64 incremental, semente 0)
+// ============================================================================
+namespace {
+
+class Hash64 {
+public:
+    void atualizar(const void* dados, size_t n) {
+        const unsigned char* p = static_cast<const unsigned char*>(dados);
+        total += n;
+        if (usados + n < 32) {
+            std::memcpy(pendente + usados, p, n);
+            usados += n;
+            return;
+        }
+        if (usados > 0) {
+            size_t falta = 32 - usados;
+            std::memcpy(pendente + usados, p, falta);
+            bloco(pendente);
+            p += falta;
+            n -= falta;
+            usados = 0;
+        }
+        for (; n >= 32; p += 32, n -= 32) bloco(p);
+        std::memcpy(pendente, p, n);
+        usados = n;
+    }
+
+    uint64_t resultado() const {
+        uint64_t h;
+        if (total >= 32) {
+            h = rotl(v[0], 1) + rotl(v[1], 7) + rotl(v[2], 12) + rotl(v[3], 18);
+            for (uint64_t vi : v) h = (h ^ rodada(0, vi)) * P1 + P4;
+        } else {
+            h = v[2] + P5;                 // v[2] = semente
+        }
+        h += total;
+
+        const unsigned char* p = pendente;
+        size_t n = usados;
+        for (; n >= 8; p += 8, n -= 8) h = rotl(h ^ rodada(0, ler64(p)), 27) * P1 + P4;
+        if (n >= 4) {
+            h = rotl(h ^ (ler32(p) * P1), 23) * P2 + P3;
+            p += 4;
+            n -= 4;
+        }
+        for (; n > 0; ++p, --n) h = rotl(h ^ (*p * P5), 11) * P1;
+
+        h ^= h >> 33;
+        h *= P2;
+        h ^= h >> 29;
+        h *= P3;
+        h ^= h >> 32;
+        return h;
+    }
+
+private:
+    static constexpr uint64_t P1 = 11400714785074694791ull;
+    static constexpr uint64_t P2 = 14029467366897019727ull;
+    static constexpr uint64_t P3 = 1609587929392839161ull;
+    static constexpr uint64_t P4 = 9650029242287828579ull;
+    static constexpr uint64_t P5 = 2870177450012600261ull;
+
+    static uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+    static uint64_t rodada(uint64_t acc, uint64_t entrada) {
+        return rotl(acc + entrada * P2, 31) * P1;
+    }
+    static uint64_t ler64(const unsigned char* p) { uint64_t x; std::memcpy(&x, p, 8); return x; }
+    static uint64_t ler32(const unsigned char* p) { uint32_t x; std::memcpy(&x, p, 4); return x; }
+
+    void bloco(const unsigned char* p) {
+        for (int i = 0; i < 4; ++i) v[i] = rodada(v[i], ler64(p + 8 * i));
+    }
+
+    uint64_t v[4] = {P1 + P2, P2, 0, 0 - P1};
+    unsigned char pendente[32];
+    size_t usados = 0;
+    uint64_t total = 0;
+};
+
+constexpr size_t BLOCO_PARCIAL = 4096;           // Bytes lidos em cada ponta
+constexpr size_t BUFFER_LEITURA = size_t(1) << 20;
+constexpr size_t ARQUIVOS_POR_TAREFA = 16;
+
+// ----------------------------------------------------------------------------
+// Um arquivo candidato (tamanho repetido) e o que já se sabe dele
+// ----------------------------------------------------------------------------
+struct Candidato {
+    std::string_view caminho;
+    uintmax_t tamanho = 0;
+    CacheHashes::Chave chave{0, 0};
+    uint64_t parcial = 0;
+    uint64_t completo = 0;
+    bool valido = false;               // Hash parcial calculado
+    bool temCompleto = false;
+};
+
+// ----------------------------------------------------------------------------
+// Arquivo aberto para leitura, conferido com fstat: precisa ser um arquivo
+// comum e manter o tamanho da varredura
+// ----------------------------------------------------------------------------
+class ArquivoAberto {
+public:
+    explicit ArquivoAberto(const Candidato& c) {
+        std::string caminho(c.caminho);
+        fd = ::open(caminho.c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+        if (fd < 0) return;
+        if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+            static_cast<uintmax_t>(st.st_size) != c.tamanho) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    ~ArquivoAberto() { if (fd >= 0) ::close(fd); }
+
+    ArquivoAberto(const ArquivoAberto&) = delete;
+    ArquivoAberto& operator=(const ArquivoAberto&) = delete;
+
+    bool aberto() const { return fd >= 0; }
+    CacheHashes::Chave chave() const {
+        return {static_cast<uint64_t>(st.st_dev), static_cast<uint64_t>(st.st_ino)};
+    }
+    int64_t mtimeNs() const {
+        return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    }
+
+    // Lê exatamente "n" bytes a partir de "pos" (false em erro ou fim precoce)
+    bool lerEm(void* destino, size_t n, uintmax_t pos) const {
+        char* d = static_cast<char*>(destino);
+        while (n > 0) {
+            ssize_t lidos = ::pread(fd, d, n, static_cast<off_t>(pos));
+            if (lidos < 0 && errno == EINTR) continue;
+            if (lidos <= 0) return false;
+            d += lidos;
+            n -= static_cast<size_t>(lidos);
+            pos += static_cast<uintmax_t>(lidos);
+        }
+        return true;
+    }
+
+    // Hash do conteúdo inteiro: mmap com leitura sequencial; se o mmap não
+    // for possível, read() em blocos de 1 MiB
+    bool hashCompleto(uintmax_t tamanho, uint64_t& hash) const {
+        Hash64 h;
+        void* mapa = ::mmap(nullptr, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapa != MAP_FAILED) {
+            ::madvise(mapa, tamanho, MADV_SEQUENTIAL);
+            h.atualizar(mapa, tamanho);
+            ::munmap(mapa, tamanho);
+        } else {
+            thread_local std::vector<char> buffer(BUFFER_LEITURA);
+            for (uintmax_t pos = 0; pos < tamanho; ) {
+                size_t n = static_cast<size_t>(std::min<uintmax_t>(buffer.size(), tamanho - pos));
+                if (!lerEm(buffer.data(), n, pos)) return false;
+                h.atualizar(buffer.data(), n);
+                pos += n;
+            }
+        }
+        hash = h.resultado();
+        return true;
+    }
+
+private:
+    int fd = -1;
+    struct stat st {};
+};
+
+// ----------------------------------------------------------------------------
+// Fase 1: hash das pontas (o arquivo inteiro, se couber em duas pontas)
+// ----------------------------------------------------------------------------
+void calcularParcial(Candidato& c, CacheHashes& cache, EstatisticasDuplicados& est) {
+    ArquivoAberto arquivo(c);
+    if (!arquivo.aberto()) {
+        ++est.falhas;
+        return;
+    }
+    c.chave = arquivo.chave();
+
+    CacheHashes::Entrada entrada;
+    if (cache.buscar(c.chave, arquivo.mtimeNs(), c.tamanho, entrada) && entrada.temParcial) {
+        ++est.acertosCache;
+        c.parcial = entrada.parcial;
+        c.completo = entrada.completo;
+        c.temCompleto = entrada.temCompleto;
+        c.valido = true;
+        return;
+    }
+
+    unsigned char pontas[2 * BLOCO_PARCIAL];
+    Hash64 h;
+    if (c.tamanho <= sizeof(pontas)) {
+        // Arquivo pequeno: o hash parcial já é o do conteúdo inteiro
+        size_t n = static_cast<size_t>(c.tamanho);
+        if (!arquivo.lerEm(pontas, n, 0)) { ++est.falhas; return; }
+        h.atualizar(pontas, n);
+        est.bytesLidos += n;
+        c.completo = h.resultado();
+        c.temCompleto = true;
+    } else {
+        if (!arquivo.lerEm(pontas, BLOCO_PARCIAL, 0) ||
+            !arquivo.lerEm(pontas + BLOCO_PARCIAL, BLOCO_PARCIAL, c.tamanho - BLOCO_PARCIAL)) {
+            ++est.falhas;
+            return;
+        }
+        h.atualizar(pontas, sizeof(pontas));
+        est.bytesLidos += sizeof(pontas);
+    }
+    c.parcial = h.resultado();
+    c.valido = true;
+    ++est.hashesParciais;
+
+    entrada = {arquivo.mtimeNs(), c.tamanho, c.parcial, c.completo, true, c.temCompleto};
+    cache.guardar(c.chave, entrada);
+}
+
+// ----------------------------------------------------------------------------
+// Fase 2: hash do conteúdo inteiro
+// ----------------------------------------------------------------------------
+void calcularCompleto(Candidato& c, CacheHashes& cache, EstatisticasDuplicados& est) {
+    ArquivoAberto arquivo(c);
+    if (!arquivo.aberto()) {
+        ++est.falhas;
+        c.valido = false;
+        return;
+    }
+    CacheHashes::Entrada entrada;
+    if (cache.buscar(arquivo.chave(), arquivo.mtimeNs(), c.tamanho, entrada) &&
+        entrada.temCompleto) {
+        ++est.acertosCache;
+        c.completo = entrada.completo;
+        c.temCompleto = true;
+        return;
+    }
+    if (!arquivo.hashCompleto(c.tamanho, c.completo)) {
+        ++est.falhas;
+        c.valido = false;
+        return;
+    }
+    c.temCompleto = true;
+    ++est.hashesCompletos;
+    est.bytesLidos += c.tamanho;
+
+    entrada = {arquivo.mtimeNs(), c.tamanho, c.parcial, c.completo, true, true};
+    cache.guardar(arquivo.chave(), entrada);
+}
+
+// ----------------------------------------------------------------------------
+// Aplica "acao" aos candidatos indicados, em tarefas de alguns arquivos
+// ----------------------------------------------------------------------------
+template <typename Acao>
+void emParalelo(PoolTarefas& pool, std::vector<Candidato*>& lista, Acao acao) {
+    for (size_t i = 0; i < lista.size(); i += ARQUIVOS_POR_TAREFA) {
+        size_t fim = std::min(lista.size(), i + ARQUIVOS_POR_TAREFA);
+        pool.submeter([&lista, i, fim, &acao] {
+            for (size_t j = i; j < fim; ++j) acao(*lista[j]);
+        });
+    }
+    pool.esperar();
+}
+
+// ----------------------------------------------------------------------------
+// Percorre as sequências de candidatos com a mesma chave (já agrupados)
+// ----------------------------------------------------------------------------
+template <typename Chave, typename Acao>
+void porSequencia(std::vector<Candidato*>& v, Chave chave, Acao acao) {
+    for (size_t i = 0; i < v.size(); ) {
+        size_t j = i + 1;
+        while (j < v.size() && chave(*v[j]) == chave(*v[i])) ++j;
+        acao(v.begin() + i, v.begin() + j);
+        i = j;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// CacheHashes
+// ============================================================================
+bool CacheHashes::buscar(const Chave& chave, int64_t mtimeNs, uintmax_t tamanho,
+                         Entrada& entrada) const {
+    std::shared_lock<std::shared_mutex> lock(trava);
+    auto it = entradas.find(chave);
+    if (it == entradas.end() || it->second.mtimeNs != mtimeNs || it->second.tamanho != tamanho) {
+        return false;
+    }
+    entrada = it->second;
+    return true;
+}
+
+void CacheHashes::guardar(const Chave& chave, const Entrada& entrada) {
+    std::unique_lock<std::shared_mutex> lock(trava);
+    entradas[chave] = entrada;
+}
+
+size_t CacheHashes::tamanho() const {
+    std::shared_lock<std::shared_mutex> lock(trava);
+    return entradas.size();
+}
+
+// ============================================================================
+// Função: encontrarDuplicados
+// ============================================================================
+std::vector<GrupoDuplicados> encontrarDuplicados(FaixaIndice porTamanho, CacheHashes& cache,
+                                                 unsigned threads,
+                                                 EstatisticasDuplicados* estatisticas) {
+    EstatisticasDuplicados local;
+    EstatisticasDuplicados& est = estatisticas ? *estatisticas : local;
+
+    // Só entram arquivos com tamanho repetido (o índice já está ordenado)
+    std::vector<Candidato> candidatos;
+    const EntradaIndice* e = porTamanho.begin();
+    while (e != porTamanho.end()) {
+        const EntradaIndice* fim = e + 1;
+        while (fim != porTamanho.end() && fim->tamanho == e->tamanho) ++fim;
+        if (e->tamanho > 0 && fim - e >= 2) {
+            for (; e != fim; ++e) candidatos.push_back({e->caminho, e->tamanho});
+        }
+        e = fim;
+    }
+    est.candidatos += candidatos.size();
+
+    PoolTarefas pool(threads);
+    std::vector<Candidato*> lista;
+    lista.reserve(candidatos.size());
+    for (auto& c : candidatos) lista.push_back(&c);
+
+    // Fase 1: pontas de todos os candidatos
+    emParalelo(pool, lista, [&](Candidato& c) { calcularParcial(c, cache, est); });
+
+    // Agrupa por (tamanho, hash parcial), descartando links para o mesmo inode;
+    // grupos que restarem com duas ou mais cópias vão para a fase 2
+    auto mesmaPonta = [](const Candidato& c) { return std::make_pair(c.tamanho, c.parcial); };
+    lista.erase(std::remove_if(lista.begin(), lista.end(),
+                               [](const Candidato* c) { return !c->valido; }),
+                lista.end());
+    std::stable_sort(lista.begin(), lista.end(), [](const Candidato* a, const Candidato* b) {
+        return a->tamanho != b->tamanho ? a->tamanho > b->tamanho : a->parcial < b->parcial;
+    });
+    std::vector<Candidato*> fase2, lerInteiro;
+    porSequencia(lista, mesmaPonta, [&](auto ini, auto fim) {
+        std::vector<Candidato*> grupo;
+        for (auto it = ini; it != fim; ++it) {
+            bool repetido = std::any_of(grupo.begin(), grupo.end(),
+                                        [&](const Candidato* g) { return g->chave == (*it)->chave; });
+            if (!repetido) grupo.push_back(*it);
+        }
+        if (grupo.size() < 2) return;
+        for (Candidato* c : grupo) {
+            fase2.push_back(c);
+            if (!c->temCompleto) lerInteiro.push_back(c);
+        }
+    });
+
+    // Fase 2: conteúdo inteiro, só de quem ainda não tem o hash completo
+    emParalelo(pool, lerInteiro, [&](Candidato& c) { calcularCompleto(c, cache, est); });
+
+    fase2.erase(std::remove_if(fase2.begin(), fase2.end(),
+                               [](const Candidato* c) { return !c->valido; }),
+                fase2.end());
+    std::stable_sort(fase2.begin(), fase2.end(), [](const Candidato* a, const Candidato* b) {
+        return a->tamanho != b->tamanho ? a->tamanho > b->tamanho : a->completo < b->completo;
+    });
+
+    std::vector<GrupoDuplicados> grupos;
+    auto mesmoConteudo = [](const Candidato& c) { return std::make_pair(c.tamanho, c.completo); };
+    porSequencia(fase2, mesmoConteudo, [&](auto ini, auto fim) {
+        if (fim - ini < 2) return;
+        GrupoDuplicados g;
+        g.tamanho = (*ini)->tamanho;
+        for (auto it = ini; it != fim; ++it) g.caminhos.emplace_back((*it)->caminho);
+        grupos.push_back(std::move(g));
+    });
+
+    std::stable_sort(grupos.begin(), grupos.end(),
+                     [](const GrupoDuplicados& a, const GrupoDuplicados& b) {
+                         return a.desperdicio() > b.desperdicio();
+                     });
+    return grupos;
+}
+
+// ============================================================================
+// Função: imprimirEstatisticasDuplicados
+// ============================================================================
+void imprimirEstatisticasDuplicados(const EstatisticasDuplicados& e, std::ostream& os) {
+    os << "Candidatos (tamanho repetido): " << e.candidatos.load()
+       << " | hashes parciais: " << e.hashesParciais.load()
+       << " | completos: " << e.hashesCompletos.load()
+       << " | do cache: " << e.acertosCache.load()
+       << " | bytes lidos: " << e.bytesLidos.load()
+       << " | falhas: " << e.falhas.load() << "\n";
+}
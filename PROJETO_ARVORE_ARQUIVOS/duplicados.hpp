@@ -0,0 +1,111 @@
+// ============================================================================
+// Arquivo: duplicados.hpp
+// Finalidade: Declarar a detecção de arquivos duplicados: os arquivos são
+//             agrupados por tamanho, depois por um hash parcial (primeiro e
+//             último blocos) e só então pelo hash do conteúdo inteiro. A
+//             leitura é feita em paralelo e os hashes ficam em um cache
+//             (dispositivo + inode, conferido pela mtime e pelo tamanho).
+// ============================================================================
+#ifndef DUPLICADOS_HPP
+#define DUPLICADOS_HPP
+
+#include <atomic>                     // Contadores das threads de leitura
+#include <cstdint>                    // uint64_t, uintmax_t
+#include <functional>                 // std::hash
+#include <ostream>                    // Resumo
+#include <shared_mutex>               // Trava do cache
+#include <string>                     // Caminhos dos grupos
+#include <unordered_map>              // Cache de hashes
+#include <vector>                     // Grupos
+#include "indices.hpp"                // FaixaIndice
+
+// ============================================================================
+// Estrutura: GrupoDuplicados
+// Objetivo: Arquivos de conteúdo idêntico. Links físicos para o mesmo inode
+//           aparecem uma só vez (não ocupam espaço a mais).
+// ============================================================================
+struct GrupoDuplicados {
+    uintmax_t tamanho = 0;                 // Bytes de cada cópia
+    std::vector<std::string> caminhos;     // Duas ou mais cópias
+
+    // Bytes que seriam liberados mantendo uma só cópia
+    uintmax_t desperdicio() const { return tamanho * (caminhos.size() - 1); }
+};
+
+// ============================================================================
+// Estrutura: EstatisticasDuplicados
+// ============================================================================
+struct EstatisticasDuplicados {
+    std::atomic<uint64_t> candidatos{0};       // Arquivos com tamanho repetido
+    std::atomic<uint64_t> hashesParciais{0};   // Lidos só nas pontas
+    std::atomic<uint64_t> hashesCompletos{0};  // Lidos por inteiro
+    std::atomic<uint64_t> acertosCache{0};     // Hashes reaproveitados do cache
+    std::atomic<uint64_t> bytesLidos{0};
+    std::atomic<uint64_t> falhas{0};           // Arquivos que não puderam ser lidos
+};
+
+// Imprime o resumo da última busca
+void imprimirEstatisticasDuplicados(const EstatisticasDuplicados& e, std::ostream& os);
+
+// ============================================================================
+// Classe: CacheHashes
+// Objetivo: Guardar os hashes já calculados por arquivo. A chave é
+//           (dispositivo, inode); a entrada só vale se a mtime e o tamanho
+//           ainda forem os mesmos, então um arquivo alterado é relido e um
+//           arquivo renomeado ou movido não é. Pode ser usado por várias
+//           threads ao mesmo tempo.
+// ============================================================================
+class CacheHashes {
+public:
+    struct Chave {
+        uint64_t dispositivo;
+        uint64_t inode;
+        bool operator==(const Chave& o) const {
+            return dispositivo == o.dispositivo && inode == o.inode;
+        }
+    };
+
+    struct Entrada {
+        int64_t mtimeNs = 0;
+        uintmax_t tamanho = 0;
+        uint64_t parcial = 0;
+        uint64_t completo = 0;
+        bool temParcial = false;
+        bool temCompleto = false;
+    };
+
+    // Entrada válida para (mtime, tamanho); false se ausente ou desatualizada
+    bool buscar(const Chave& chave, int64_t mtimeNs, uintmax_t tamanho, Entrada& entrada) const;
+
+    // Grava (ou completa) a entrada de um arquivo
+    void guardar(const Chave& chave, const Entrada& entrada);
+
+    size_t tamanho() const;
+
+private:
+    struct HashChave {
+        size_t operator()(const Chave& c) const {
+            return std::hash<uint64_t>()(c.inode * 0x9E3779B97F4A7C15ull ^ c.dispositivo);
+        }
+    };
+
+    mutable std::shared_mutex trava;
+    std::unordered_map<Chave, Entrada, HashChave> entradas;
+};
+
+// ============================================================================
+// Função: encontrarDuplicados
+// Objetivo: Procurar duplicados entre os arquivos de "porTamanho" (em ordem
+//           decrescente de tamanho, como no índice das pesquisas). Arquivos
+//           vazios são ignorados. As leituras são distribuídas por um
+//           PoolTarefas de "threads" threads (0 = todos os núcleos).
+//           O hash é o XXH64: rápido, sem criptografia; um falso positivo
+//           exige colisão de 64 bits entre arquivos de mesmo tamanho e mesmas
+//           pontas.
+// Retorno: Grupos em ordem decrescente de bytes desperdiçados
+// ============================================================================
+std::vector<GrupoDuplicados> encontrarDuplicados(FaixaIndice porTamanho, CacheHashes& cache,
+                                                 unsigned threads = 0,
+                                                 EstatisticasDuplicados* estatisticas = nullptr);
+
+#endif // DUPLICADOS_HPP
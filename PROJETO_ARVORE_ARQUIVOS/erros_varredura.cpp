@@ -0,0 +1,110 @@
+// ============================================================================
+// Arquivo: erros_varredura.cpp
+// Finalidade: Implementa a tabela de erros da varredura e os relatórios.
+// ============================================================================
+#include "erros_varredura.hpp"
+#include <algorithm>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+
+const char* descreverOperacao(OperacaoErro operacao) {
+    switch (operacao) {
+        case OperacaoErro::AbrirPasta: return "abrir a pasta";
+        case OperacaoErro::LerPasta:   return "ler a pasta";
+        case OperacaoErro::Metadados:  return "consultar metadados";
+    }
+    return "?";
+}
+
+// ============================================================================
+// Método: anexar
+// ============================================================================
+void TabelaErros::anexar(std::vector<ErroLeitura>& erros) {
+    if (erros.empty()) return;
+    std::lock_guard<std::mutex> lock(trava);
+    for (const auto& e : erros) {
+        registros.push_back({caminhos.size(), static_cast<uint32_t>(e.caminho.size()),
+                             static_cast<int32_t>(e.codigo), e.operacao});
+        caminhos += e.caminho;
+    }
+    erros.clear();
+}
+
+size_t TabelaErros::tamanho() const {
+    std::lock_guard<std::mutex> lock(trava);
+    return registros.size();
+}
+
+// ============================================================================
+// Método: contagemPorCodigo
+// ============================================================================
+std::vector<std::pair<int, uint64_t>> TabelaErros::contagemPorCodigo() const {
+    std::unordered_map<int, uint64_t> contagem;
+    {
+        std::lock_guard<std::mutex> lock(trava);
+        for (const auto& r : registros) ++contagem[r.codigo];
+    }
+    std::vector<std::pair<int, uint64_t>> resultado(contagem.begin(), contagem.end());
+    std::sort(resultado.begin(), resultado.end(), [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    return resultado;
+}
+
+// ============================================================================
+// Método: listar
+// ============================================================================
+std::vector<ErroLeitura> TabelaErros::listar() const {
+    std::lock_guard<std::mutex> lock(trava);
+    auto caminhoDe = [this](const Registro& r) {
+        return std::string_view(caminhos).substr(r.inicio, r.comprimento);
+    };
+    std::vector<const Registro*> ordem;
+    ordem.reserve(registros.size());
+    for (const auto& r : registros) ordem.push_back(&r);
+    std::sort(ordem.begin(), ordem.end(), [&](const Registro* a, const Registro* b) {
+        return caminhoDe(*a) < caminhoDe(*b);
+    });
+
+    std::vector<ErroLeitura> resultado;
+    resultado.reserve(ordem.size());
+    for (const Registro* r : ordem) {
+        resultado.push_back({std::string(caminhoDe(*r)), r->codigo, r->operacao});
+    }
+    return resultado;
+}
+
+// ============================================================================
+// Função: imprimirResumoErros
+// ============================================================================
+void imprimirResumoErros(const TabelaErros& erros, std::ostream& os) {
+    auto contagem = erros.contagemPorCodigo();
+    if (contagem.empty()) return;
+    uint64_t total = 0;
+    for (const auto& [codigo, n] : contagem) total += n;
+    os << "[AVISO] " << total << " caminho(s) com erro de leitura:";
+    const char* separador = " ";
+    for (const auto& [codigo, n] : contagem) {
+        os << separador << n << " × " << std::generic_category().message(codigo);
+        separador = ", ";
+    }
+    os << "\n";
+}
+
+// ============================================================================
+// Função: listarCaminhosIlegiveis
+// ============================================================================
+void listarCaminhosIlegiveis(const TabelaErros& erros, std::ostream& os) {
+    auto lista = erros.listar();
+    if (lista.empty()) {
+        os << "Nenhum erro de leitura na varredura.\n";
+        return;
+    }
+    os << "Caminhos com erro de leitura:\n";
+    for (const auto& e : lista) {
+        os << e.caminho << " (" << std::generic_category().message(e.codigo)
+           << " ao " << descreverOperacao(e.operacao) << ")\n";
+    }
+    imprimirResumoErros(erros, os);
+}
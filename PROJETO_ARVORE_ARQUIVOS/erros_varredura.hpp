@@ -0,0 +1,87 @@
+// ============================================================================
+// Arquivo: erros_varredura.hpp
+// Finalidade: Declarar a tabela de erros da varredura. Uma pasta sem
+//             permissão ou uma entrada que não pôde ser consultada não
+//             interrompem a varredura: o caminho e o código do erro são
+//             guardados à parte e a árvore segue sem eles.
+// ============================================================================
+#ifndef ERROS_VARREDURA_HPP
+#define ERROS_VARREDURA_HPP
+
+#include <cstdint>                    // uint64_t, int32_t
+#include <mutex>                      // Trava da tabela
+#include <ostream>                    // Resumo e listagem
+#include <string>                     // Caminhos
+#include <utility>                    // std::pair
+#include <vector>                     // Registros
+
+// ============================================================================
+// Enumeração: OperacaoErro (o que falhou)
+//   - AbrirPasta: a pasta não pôde ser aberta; aparece vazia, com Nodo::podada
+//   - LerPasta:   a leitura parou no meio; ficam as entradas já lidas
+//   - Metadados:  o tipo ou o tamanho de uma entrada não pôde ser obtido;
+//                 a entrada fica fora da árvore
+// ============================================================================
+enum class OperacaoErro : uint8_t { AbrirPasta, LerPasta, Metadados };
+
+const char* descreverOperacao(OperacaoErro operacao);
+
+// ============================================================================
+// Estrutura: ErroLeitura
+// Objetivo: Um erro ainda não anexado à tabela (guardado pela tarefa que o
+//           encontrou, como os demais contadores locais).
+// ============================================================================
+struct ErroLeitura {
+    std::string caminho;
+    int codigo;                   // errno
+    OperacaoErro operacao;
+};
+
+// ============================================================================
+// Classe: TabelaErros
+// Objetivo: Guardar os erros de uma varredura de forma compacta: todos os
+//           caminhos em um único bloco de texto e, por erro, só o trecho, o
+//           código e a operação. Pode receber erros de várias threads.
+// ============================================================================
+class TabelaErros {
+public:
+    // Move os erros para a tabela e esvazia "erros"
+    void anexar(std::vector<ErroLeitura>& erros);
+
+    size_t tamanho() const;
+    bool vazia() const { return tamanho() == 0; }
+
+    // Quantidade por código de erro, da mais frequente para a menos
+    std::vector<std::pair<int, uint64_t>> contagemPorCodigo() const;
+
+    // Todos os erros, em ordem de caminho
+    std::vector<ErroLeitura> listar() const;
+
+private:
+    struct Registro {
+        uint64_t inicio;          // Posição do caminho em "caminhos"
+        uint32_t comprimento;
+        int32_t codigo;
+        OperacaoErro operacao;
+    };
+
+    mutable std::mutex trava;
+    std::string caminhos;
+    std::vector<Registro> registros;
+};
+
+// ============================================================================
+// Função: imprimirResumoErros
+// Objetivo: Uma linha com o total e a contagem por tipo de erro (nada, se a
+//           tabela estiver vazia).
+// ============================================================================
+void imprimirResumoErros(const TabelaErros& erros, std::ostream& os);
+
+// ============================================================================
+// Função: listarCaminhosIlegiveis
+// Objetivo: Listar cada caminho com o erro e a operação que falhou (consulta
+//           do menu).
+// ============================================================================
+void listarCaminhosIlegiveis(const TabelaErros& erros, std::ostream& os);
+
+#endif // ERROS_VARREDURA_HPP
@@ -0,0 +1,443 @@
+// ============================================================================
+// Arquivo: estatisticas_arvore.cpp
+// Finalidade: Implementa o acumulador do resumo estatístico da árvore, o
+//             relatório em texto e a exportação.
+// ============================================================================
+#include "estatisticas_arvore.hpp"
+#include "filtro.hpp"              // extensaoDe()
+#include "saida_bufferizada.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+size_t EstatisticasArvore::faixaDe(uint64_t valor) {
+    size_t i = 0;
+    while (valor > 0 && i + 1 < NUM_FAIXAS) {
+        valor >>= 1;
+        ++i;
+    }
+    return i;
+}
+
+// Caminho de pasta como chave: sem a '/' final (exceto na raiz "/"), igual
+// ao que pastaDe() devolve para os filhos
+static std::string_view chavePasta(std::string_view caminho) {
+    while (caminho.size() > 1 && caminho.back() == '/') caminho.remove_suffix(1);
+    return caminho;
+}
+
+// Ordem dos destaques: maior valor primeiro; nos empates, o menor caminho
+static bool antes(const PastaDestaque& a, const PastaDestaque& b) {
+    return a.valor != b.valor ? a.valor > b.valor : a.caminho < b.caminho;
+}
+
+// ============================================================================
+// Método: guardar
+// Objetivo: Heap com o pior destaque na frente; o caminho só é copiado
+//           quando a pasta entra
+// ============================================================================
+void AcumuladorEstatisticas::guardar(std::vector<PastaDestaque>& heap, size_t limite,
+                                     uint64_t valor, std::string_view caminho, uint64_t bytes,
+                                     uint64_t alocado) {
+    if (heap.size() == limite) {
+        const PastaDestaque& pior = heap.front();
+        if (valor < pior.valor || (valor == pior.valor && caminho >= pior.caminho)) return;
+        std::pop_heap(heap.begin(), heap.end(), antes);
+        heap.pop_back();
+    }
+    heap.push_back({valor, std::string(caminho), bytes, alocado});
+    std::push_heap(heap.begin(), heap.end(), antes);
+}
+
+// ============================================================================
+// Método: adicionar
+// ============================================================================
+void AcumuladorEstatisticas::adicionar(const InfoNodo& info) {
+    fecharAte(info.nivel);
+
+    if (info.tipo == TipoNodo::Pasta) {
+        ++resumo.pastas;
+        size_t nivel = static_cast<size_t>(std::max(info.nivel, 0));
+        if (resumo.maioresPorNivel.size() <= nivel) resumo.maioresPorNivel.resize(nivel + 1);
+        guardar(resumo.maioresPorNivel[nivel], EstatisticasArvore::MAIORES_POR_NIVEL,
+                info.tamanho, chavePasta(info.caminho), info.tamanho, info.alocado);
+
+        if (profundidade == abertas.size()) abertas.emplace_back();
+        Aberta& a = abertas[profundidade++];
+        a.nivel = info.nivel;
+        a.arquivos = 0;
+        a.caminho.assign(chavePasta(info.caminho));
+        a.bytes = info.tamanho;
+        a.alocado = info.alocado;
+        return;
+    }
+
+    // Um link repetido conta como arquivo, mas os bytes do inode já estão no
+    // link que conta (como nos totais das pastas)
+    uint64_t bytes = info.vinculoRepetido ? 0 : info.tamanho;
+    uint64_t alocado = info.vinculoRepetido ? 0 : info.alocado;
+    ++resumo.arquivos;
+    resumo.bytes += bytes;
+    resumo.alocado += alocado;
+
+    chave.assign(extensaoDe(info.nome));
+    TotaisGrupo& ext = extensoes[chave];
+    ++ext.arquivos;
+    ext.bytes += bytes;
+    ext.alocado += alocado;
+
+    TotaisGrupo& faixa = resumo.faixasTamanho[EstatisticasArvore::faixaDe(info.tamanho)];
+    ++faixa.arquivos;
+    faixa.bytes += bytes;
+    faixa.alocado += alocado;
+
+    // A pasta do arquivo está aberta nesta parte ou ficou em outra
+    if (profundidade > 0 && abertas[profundidade - 1].nivel == info.nivel - 1) {
+        ++abertas[profundidade - 1].arquivos;
+    } else {
+        chave.assign(pastaDe(info));
+        Aberta& p = parciais[chave];
+        p.caminho = chave;
+        ++p.arquivos;
+    }
+}
+
+void AcumuladorEstatisticas::fecharAte(int nivel) {
+    while (profundidade > 0 && abertas[profundidade - 1].nivel >= nivel) {
+        const Aberta& a = abertas[--profundidade];
+        registrarPasta(a.caminho, a.arquivos, a.bytes, a.alocado);
+    }
+}
+
+void AcumuladorEstatisticas::encerrarParte() {
+    for (size_t i = 0; i < profundidade; ++i) {
+        const Aberta& a = abertas[i];
+        Aberta& p = parciais[a.caminho];
+        p.caminho = a.caminho;
+        p.arquivos += a.arquivos;
+        p.bytes = a.bytes;
+        p.alocado = a.alocado;
+    }
+    profundidade = 0;
+}
+
+void AcumuladorEstatisticas::registrarPasta(const std::string& caminho, uint64_t arquivos,
+                                            uint64_t bytes, uint64_t alocado) {
+    ++resumo.pastasPorArquivos[EstatisticasArvore::faixaDe(arquivos)];
+    guardar(resumo.maisArquivos, EstatisticasArvore::MAIS_ARQUIVOS, arquivos, caminho, bytes,
+            alocado);
+}
+
+// ============================================================================
+// Método: juntar
+// ============================================================================
+void AcumuladorEstatisticas::juntar(AcumuladorEstatisticas& outra) {
+    encerrarParte();
+    outra.encerrarParte();
+    EstatisticasArvore& r = outra.resumo;
+
+    resumo.arquivos += r.arquivos;
+    resumo.pastas += r.pastas;
+    resumo.bytes += r.bytes;
+    resumo.alocado += r.alocado;
+    for (size_t i = 0; i < EstatisticasArvore::NUM_FAIXAS; ++i) {
+        resumo.faixasTamanho[i].arquivos += r.faixasTamanho[i].arquivos;
+        resumo.faixasTamanho[i].bytes += r.faixasTamanho[i].bytes;
+        resumo.faixasTamanho[i].alocado += r.faixasTamanho[i].alocado;
+        resumo.pastasPorArquivos[i] += r.pastasPorArquivos[i];
+    }
+    for (const auto& [ext, t] : outra.extensoes) {
+        TotaisGrupo& total = extensoes[ext];
+        total.arquivos += t.arquivos;
+        total.bytes += t.bytes;
+        total.alocado += t.alocado;
+    }
+
+    if (resumo.maioresPorNivel.size() < r.maioresPorNivel.size()) {
+        resumo.maioresPorNivel.resize(r.maioresPorNivel.size());
+    }
+    for (size_t nivel = 0; nivel < r.maioresPorNivel.size(); ++nivel) {
+        for (const auto& p : r.maioresPorNivel[nivel]) {
+            guardar(resumo.maioresPorNivel[nivel], EstatisticasArvore::MAIORES_POR_NIVEL,
+                    p.valor, p.caminho, p.bytes, p.alocado);
+        }
+    }
+    for (const auto& p : r.maisArquivos) {
+        guardar(resumo.maisArquivos, EstatisticasArvore::MAIS_ARQUIVOS, p.valor, p.caminho,
+                p.bytes, p.alocado);
+    }
+
+    // A mesma pasta pode ter arquivos em várias partes; o tamanho vem da
+    // parte em que ela foi aberta
+    for (auto& [caminho, p] : outra.parciais) {
+        Aberta& total = parciais[caminho];
+        total.caminho = caminho;
+        total.arquivos += p.arquivos;
+        total.bytes = std::max(total.bytes, p.bytes);
+        total.alocado = std::max(total.alocado, p.alocado);
+    }
+    outra = AcumuladorEstatisticas();
+}
+
+// ============================================================================
+// Método: finalizar
+// ============================================================================
+EstatisticasArvore AcumuladorEstatisticas::finalizar() {
+    encerrarParte();
+    for (const auto& [caminho, p] : parciais) {
+        registrarPasta(caminho, p.arquivos, p.bytes, p.alocado);
+    }
+    parciais.clear();
+
+    resumo.porExtensao.assign(extensoes.begin(), extensoes.end());
+    std::sort(resumo.porExtensao.begin(), resumo.porExtensao.end(),
+              [](const auto& a, const auto& b) {
+                  return a.second.bytes != b.second.bytes ? a.second.bytes > b.second.bytes
+                                                          : a.first < b.first;
+              });
+    extensoes.clear();
+    for (auto& nivel : resumo.maioresPorNivel) std::sort(nivel.begin(), nivel.end(), antes);
+    std::sort(resumo.maisArquivos.begin(), resumo.maisArquivos.end(), antes);
+    return std::move(resumo);
+}
+
+// ----------------------------------------------------------------------------
+// Relatório em texto
+// ----------------------------------------------------------------------------
+static std::string legivel(uint64_t bytes) {
+    static const char* const UNIDADES[] = {"B", "KiB", "MiB", "GiB", "TiB", "PiB", "EiB"};
+    double valor = static_cast<double>(bytes);
+    size_t u = 0;
+    while (valor >= 1024 && u + 1 < std::size(UNIDADES)) {
+        valor /= 1024;
+        ++u;
+    }
+    std::ostringstream os;
+    if (u == 0) os << bytes << " B";
+    else os << std::fixed << std::setprecision(1) << valor << " " << UNIDADES[u];
+    return os.str();
+}
+
+static double percentual(uint64_t parte, uint64_t total) {
+    return total > 0 ? 100.0 * static_cast<double>(parte) / static_cast<double>(total) : 0;
+}
+
+// Histograma das faixas entre a primeira e a última não vazias
+template <typename Contagem, typename Rotulo>
+static void imprimirHistograma(std::ostream& os, Contagem contagem, Rotulo rotulo) {
+    size_t primeira = EstatisticasArvore::NUM_FAIXAS, ultima = 0;
+    uint64_t maior = 0;
+    for (size_t i = 0; i < EstatisticasArvore::NUM_FAIXAS; ++i) {
+        if (contagem(i) == 0) continue;
+        primeira = std::min(primeira, i);
+        ultima = i;
+        maior = std::max(maior, contagem(i));
+    }
+    for (size_t i = primeira; i <= ultima && primeira < EstatisticasArvore::NUM_FAIXAS; ++i) {
+        uint64_t n = contagem(i);
+        size_t barra = static_cast<size_t>(maior ? n * 40 / maior : 0);
+        os << "    " << std::setw(12) << rotulo(i) << " " << std::setw(10) << n;
+        if (barra > 0) os << "  " << std::string(barra, '#');
+        os << "\n";
+    }
+}
+
+// ============================================================================
+// Função: imprimirEstatisticasArvore
+// ============================================================================
+void imprimirEstatisticasArvore(const EstatisticasArvore& e, std::ostream& os,
+                                size_t maxExtensoes) {
+    auto formato = os.flags();
+    auto precisao = os.precision();
+    os << std::fixed << std::setprecision(1);
+
+    os << "Arquivos: " << e.arquivos << " (" << legivel(e.bytes) << ", " << legivel(e.alocado)
+       << " em disco); pastas: " << e.pastas << "\n";
+
+    if (!e.porExtensao.empty()) {
+        os << "\nPor extensão (maior volume primeiro):\n";
+        size_t mostradas = std::min(maxExtensoes, e.porExtensao.size());
+        for (size_t i = 0; i < mostradas; ++i) {
+            const auto& [ext, t] = e.porExtensao[i];
+            os << "    " << std::left << std::setw(16) << (ext.empty() ? "(sem extensão)" : ext)
+               << std::right << std::setw(10) << t.arquivos << " arquivo(s) " << std::setw(12)
+               << legivel(t.bytes) << "  " << std::setw(5) << percentual(t.bytes, e.bytes)
+               << "%\n";
+        }
+        if (mostradas < e.porExtensao.size()) {
+            os << "    ... " << e.porExtensao.size() - mostradas << " extensões a mais\n";
+        }
+    }
+
+    if (e.arquivos > 0) {
+        os << "\nTamanho dos arquivos (faixas de potência de 2):\n";
+        imprimirHistograma(os, [&](size_t i) { return e.faixasTamanho[i].arquivos; },
+                           [](size_t i) { return legivel(EstatisticasArvore::inicioFaixa(i)) + "+"; });
+    }
+
+    if (!e.maioresPorNivel.empty()) {
+        os << "\nMaiores pastas por nível:\n";
+        for (size_t nivel = 0; nivel < e.maioresPorNivel.size(); ++nivel) {
+            if (e.maioresPorNivel[nivel].empty()) continue;
+            os << "  nível " << nivel << ":\n";
+            for (const auto& p : e.maioresPorNivel[nivel]) {
+                os << "    " << std::setw(12) << legivel(p.valor) << "  " << p.caminho << "\n";
+            }
+        }
+    }
+
+    if (e.pastas > 0) {
+        os << "\nArquivos diretos por pasta:\n";
+        imprimirHistograma(os, [&](size_t i) { return e.pastasPorArquivos[i]; },
+                           [](size_t i) {
+                               return std::to_string(EstatisticasArvore::inicioFaixa(i)) + "+";
+                           });
+        os << "  Pastas com mais arquivos diretos:\n";
+        for (const auto& p : e.maisArquivos) {
+            os << "    " << std::setw(10) << p.valor << "  " << p.caminho << "\n";
+        }
+    }
+    os.flags(formato);
+    os.precision(precisao);
+}
+
+// ----------------------------------------------------------------------------
+// Linhas do resumo, na ordem das seções (usadas pelos formatos tabulares)
+// ----------------------------------------------------------------------------
+struct LinhaResumo {
+    std::string_view secao;
+    int nivel;                    // -1 = não se aplica
+    std::string_view chave;
+    uint64_t quantidade;
+    uint64_t bytes;
+    uint64_t alocado;
+};
+
+template <typename Acao>
+static void paraCadaLinha(const EstatisticasArvore& e, Acao acao) {
+    acao(LinhaResumo{"total", -1, "arquivos", e.arquivos, e.bytes, e.alocado});
+    acao(LinhaResumo{"total", -1, "pastas", e.pastas, 0, 0});
+    for (const auto& [ext, t] : e.porExtensao) {
+        acao(LinhaResumo{"extensao", -1, ext, t.arquivos, t.bytes, t.alocado});
+    }
+    for (size_t i = 0; i < EstatisticasArvore::NUM_FAIXAS; ++i) {
+        const TotaisGrupo& t = e.faixasTamanho[i];
+        if (t.arquivos == 0) continue;
+        std::string inicio = std::to_string(EstatisticasArvore::inicioFaixa(i));
+        acao(LinhaResumo{"faixa_tamanho", -1, inicio, t.arquivos, t.bytes, t.alocado});
+    }
+    for (size_t nivel = 0; nivel < e.maioresPorNivel.size(); ++nivel) {
+        uint64_t posicao = 0;
+        for (const auto& p : e.maioresPorNivel[nivel]) {
+            acao(LinhaResumo{"maior_pasta", static_cast<int>(nivel), p.caminho, ++posicao,
+                             p.bytes, p.alocado});
+        }
+    }
+    for (size_t i = 0; i < EstatisticasArvore::NUM_FAIXAS; ++i) {
+        if (e.pastasPorArquivos[i] == 0) continue;
+        std::string inicio = std::to_string(EstatisticasArvore::inicioFaixa(i));
+        acao(LinhaResumo{"arquivos_por_pasta", -1, inicio, e.pastasPorArquivos[i], 0, 0});
+    }
+    for (const auto& p : e.maisArquivos) {
+        acao(LinhaResumo{"mais_arquivos", -1, p.caminho, p.valor, p.bytes, p.alocado});
+    }
+}
+
+// ============================================================================
+// Função: exportarEstatisticasArvore
+// ============================================================================
+bool exportarEstatisticasArvore(const EstatisticasArvore& e, FormatoSaida formato,
+                                const std::string& nomeArquivo) {
+    if (formato == FormatoSaida::Colunar) {
+        std::cerr << "[ERRO] O formato colunar não se aplica às estatísticas" << std::endl;
+        return false;
+    }
+    auto saida = abrirSaida(nomeArquivo);
+    if (!saida) return false;
+    SaidaBufferizada& out = *saida;
+
+    switch (formato) {
+        case FormatoSaida::Terminal: {
+            std::ostringstream texto;
+            imprimirEstatisticasArvore(e, texto, e.porExtensao.size());
+            out.escrever(texto.str());
+            break;
+        }
+        case FormatoSaida::JsonLinhas:
+            paraCadaLinha(e, [&](const LinhaResumo& l) {
+                out.escrever("{\"secao\":\"");
+                out.escrever(l.secao);
+                out.escrever('"');
+                if (l.nivel >= 0) {
+                    out.escrever(",\"nivel\":");
+                    out.escreverNumero(static_cast<uintmax_t>(l.nivel));
+                }
+                out.escrever(",\"chave\":\"");
+                out.escreverJson(l.chave);
+                out.escrever("\",\"quantidade\":");
+                out.escreverNumero(l.quantidade);
+                out.escrever(",\"bytes\":");
+                out.escreverNumero(l.bytes);
+                out.escrever(",\"alocado\":");
+                out.escreverNumero(l.alocado);
+                out.escrever("}\n");
+            });
+            break;
+        case FormatoSaida::Csv:
+            out.escrever("secao,nivel,chave,quantidade,bytes,alocado\n");
+            paraCadaLinha(e, [&](const LinhaResumo& l) {
+                out.escrever(l.secao);
+                out.escrever(',');
+                if (l.nivel >= 0) out.escreverNumero(static_cast<uintmax_t>(l.nivel));
+                out.escrever(',');
+                out.escreverCsv(l.chave);
+                out.escrever(',');
+                out.escreverNumero(l.quantidade);
+                out.escrever(',');
+                out.escreverNumero(l.bytes);
+                out.escrever(',');
+                out.escreverNumero(l.alocado);
+                out.escrever('\n');
+            });
+            break;
+        case FormatoSaida::Html:
+            out.escrever("<!DOCTYPE html>\n<html lang=\"pt-BR\">\n<head>\n"
+                         "  <meta charset=\"UTF-8\">\n"
+                         "  <title>Estatísticas da Árvore</title>\n"
+                         "  <style>\n"
+                         "    body { font-family: monospace; }\n"
+                         "    td { padding: 0 1em; }\n"
+                         "  </style>\n"
+                         "</head>\n<body>\n<table>\n"
+                         "<tr><th>seção</th><th>nível</th><th>chave</th><th>quantidade</th>"
+                         "<th>bytes</th><th>alocado</th></tr>\n");
+            paraCadaLinha(e, [&](const LinhaResumo& l) {
+                out.escrever("<tr><td>");
+                out.escrever(l.secao);
+                out.escrever("</td><td>");
+                if (l.nivel >= 0) out.escreverNumero(static_cast<uintmax_t>(l.nivel));
+                out.escrever("</td><td>");
+                out.escreverHtml(l.chave);
+                out.escrever("</td><td>");
+                out.escreverNumero(l.quantidade);
+                out.escrever("</td><td>");
+                out.escreverNumero(l.bytes);
+                out.escrever("</td><td>");
+                out.escreverNumero(l.alocado);
+                out.escrever("</td></tr>\n");
+            });
+            out.escrever("</table>\n</body>\n</html>\n");
+            break;
+        case FormatoSaida::Colunar:
+            break;
+    }
+
+    std::string erro;
+    if (!out.fechar(&erro)) {
+        std::cerr << "[ERRO] Falha ao gravar " << nomeArquivo << ": " << erro << "\n";
+        return false;
+    }
+    return true;
+}
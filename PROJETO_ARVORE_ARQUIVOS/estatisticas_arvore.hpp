@@ -0,0 +1,136 @@
+// ============================================================================
+// Arquivo: estatisticas_arvore.hpp
+// Finalidade: Declarar o resumo estatístico de uma árvore: totais por
+//             extensão, distribuição do tamanho dos arquivos, maiores pastas
+//             de cada nível e arquivos diretos por pasta. Tudo é acumulado em
+//             uma única passada; cada parte da árvore tem o seu acumulador, e
+//             os acumuladores são juntados ao final.
+// ============================================================================
+#ifndef ESTATISTICAS_ARVORE_HPP
+#define ESTATISTICAS_ARVORE_HPP
+
+#include <array>                      // Faixas dos histogramas
+#include <cstdint>                    // uint64_t
+#include <ostream>                    // Relatório em texto
+#include <string>                     // Extensões e caminhos
+#include <string_view>
+#include <unordered_map>              // Acumulação por extensão
+#include <utility>                    // std::pair
+#include <vector>
+#include "percurso.hpp"               // InfoNodo
+#include "serializadores.hpp"         // FormatoSaida
+
+// Quantidade, bytes aparentes e bytes em disco de um grupo de arquivos
+struct TotaisGrupo {
+    uint64_t arquivos = 0;
+    uint64_t bytes = 0;
+    uint64_t alocado = 0;
+};
+
+// Uma pasta de destaque: "valor" é o tamanho (maiores por nível) ou o número
+// de arquivos diretos (pastas com mais arquivos)
+struct PastaDestaque {
+    uint64_t valor;
+    std::string caminho;
+    uint64_t bytes;
+    uint64_t alocado;
+};
+
+// ============================================================================
+// Estrutura: EstatisticasArvore
+// Objetivo: O resumo pronto. Os histogramas usam faixas de potência de 2:
+//           a faixa 0 é o valor 0 e a faixa i é [2^(i-1), 2^i).
+// ============================================================================
+struct EstatisticasArvore {
+    static constexpr size_t NUM_FAIXAS = 64;
+    static constexpr size_t MAIORES_POR_NIVEL = 5;
+    static constexpr size_t MAIS_ARQUIVOS = 10;
+
+    uint64_t arquivos = 0;
+    uint64_t pastas = 0;
+    uint64_t bytes = 0;                                  // Soma dos arquivos
+    uint64_t alocado = 0;
+
+    // Extensão ("" = sem extensão) e totais, do maior volume para o menor
+    std::vector<std::pair<std::string, TotaisGrupo>> porExtensao;
+
+    // Arquivos por faixa de tamanho
+    std::array<TotaisGrupo, NUM_FAIXAS> faixasTamanho{};
+
+    // [nível] -> pastas daquele nível, da maior para a menor (raiz = nível 0)
+    std::vector<std::vector<PastaDestaque>> maioresPorNivel;
+
+    // Pastas por faixa de número de arquivos diretos
+    std::array<uint64_t, NUM_FAIXAS> pastasPorArquivos{};
+
+    // Pastas com mais arquivos diretos, da maior contagem para a menor
+    std::vector<PastaDestaque> maisArquivos;
+
+    static size_t faixaDe(uint64_t valor);
+    static uint64_t inicioFaixa(size_t i) { return i == 0 ? 0 : uint64_t(1) << (i - 1); }
+};
+
+// ============================================================================
+// Classe: AcumuladorEstatisticas
+// Objetivo: Recebe os nós de uma parte do percurso (em pré-ordem) e acumula
+//           o resumo. Os arquivos diretos de cada pasta são contados com uma
+//           pilha das pastas abertas; uma pasta cujos filhos continuam em
+//           outra parte (corte da divisão) fica com uma contagem parcial, que
+//           é somada às das outras partes ao juntar.
+// ============================================================================
+class AcumuladorEstatisticas {
+public:
+    void adicionar(const InfoNodo& info);
+
+    // Soma a parte seguinte do percurso ("outra" fica inutilizada)
+    void juntar(AcumuladorEstatisticas& outra);
+
+    // Resumo final (depois de juntadas todas as partes)
+    EstatisticasArvore finalizar();
+
+private:
+    struct Aberta {
+        int nivel;
+        uint64_t arquivos;
+        std::string caminho;
+        uint64_t bytes, alocado;
+    };
+
+    void fecharAte(int nivel);               // Fecha as pastas de nível >= "nivel"
+    void encerrarParte();                    // Pastas ainda abertas viram parciais
+    void registrarPasta(const std::string& caminho, uint64_t arquivos, uint64_t bytes,
+                        uint64_t alocado);
+    static void guardar(std::vector<PastaDestaque>& heap, size_t limite, uint64_t valor,
+                        std::string_view caminho, uint64_t bytes, uint64_t alocado);
+
+    EstatisticasArvore resumo;                     // Campos de soma direta
+    std::unordered_map<std::string, TotaisGrupo> extensoes;
+    std::vector<Aberta> abertas;
+    size_t profundidade = 0;                       // Entradas usadas de "abertas"
+    std::unordered_map<std::string, Aberta> parciais;
+    std::string chave;                             // Buffer reaproveitado
+};
+
+// ============================================================================
+// Função: imprimirEstatisticasArvore
+// Objetivo: Relatório em texto (opção do menu e formato "terminal"). Mostra
+//           as "maxExtensoes" extensões de maior volume.
+// ============================================================================
+void imprimirEstatisticasArvore(const EstatisticasArvore& estatisticas, std::ostream& os,
+                                size_t maxExtensoes = 20);
+
+// ============================================================================
+// Função: exportarEstatisticasArvore
+// Objetivo: Gravar o resumo em "nomeArquivo" ("-" = saída padrão). Em jsonl,
+//           csv e html, cada linha do resumo é um registro com as colunas
+//           secao, nivel, chave, quantidade, bytes e alocado, nas seções
+//           total, extensao, faixa_tamanho (chave = início da faixa em
+//           bytes), maior_pasta (por nível), arquivos_por_pasta (chave =
+//           início da faixa) e mais_arquivos. O formato colunar não se
+//           aplica.
+// Retorno: true se o arquivo foi gravado (erros são exibidos no terminal)
+// ============================================================================
+bool exportarEstatisticasArvore(const EstatisticasArvore& estatisticas, FormatoSaida formato,
+                                const std::string& nomeArquivo);
+
+#endif // ESTATISTICAS_ARVORE_HPP
@@ -0,0 +1,168 @@
+// ============================================================================
+// Arquivo: exclusao.cpp
+// Finalidade: Implementa a compilação e o casamento dos padrões de exclusão.
+// ============================================================================
+#include "exclusao.hpp"
+#include <algorithm>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+// Lê uma classe "[...]" a partir de padrao[i] == '['. Devolve false (e não
+// avança) se não houver o ']' de fechamento.
+// ----------------------------------------------------------------------------
+static bool lerClasse(std::string_view padrao, size_t& i, std::bitset<256>& classe) {
+    size_t j = i + 1;
+    bool negada = j < padrao.size() && (padrao[j] == '!' || padrao[j] == '^');
+    if (negada) ++j;
+    size_t inicio = j;
+    std::bitset<256> bits;
+    // Um ']' logo no início faz parte da classe
+    while (j < padrao.size() && (padrao[j] != ']' || j == inicio)) {
+        unsigned char c = static_cast<unsigned char>(padrao[j]);
+        if (j + 2 < padrao.size() && padrao[j + 1] == '-' && padrao[j + 2] != ']') {
+            unsigned char fim = static_cast<unsigned char>(padrao[j + 2]);
+            for (unsigned v = c; v <= fim; ++v) bits.set(v);
+            j += 3;
+        } else {
+            bits.set(c);
+            ++j;
+        }
+    }
+    if (j >= padrao.size()) return false;
+    classe = negada ? ~bits : bits;
+    i = j + 1;
+    return true;
+}
+
+PadroesExclusao& PadroesExclusao::operator=(const PadroesExclusao& outro) {
+    if (this == &outro) return *this;
+    quantidade = outro.quantidade;
+    textosExatos = outro.textosExatos;
+    nomesExatos.clear();
+    for (const auto& texto : textosExatos) nomesExatos.insert(texto);
+    sufixos = outro.sufixos;
+    prefixos = outro.prefixos;
+    padroesNome = outro.padroesNome;
+    padroesCaminho = outro.padroesCaminho;
+    classes = outro.classes;
+    return *this;
+}
+
+// ============================================================================
+// Método: adicionar
+// ============================================================================
+void PadroesExclusao::adicionar(std::string_view texto) {
+    Padrao padrao;
+    bool temBarra = false;
+    for (size_t i = 0; i < texto.size(); ) {
+        char c = texto[i];
+        std::bitset<256> classe;
+        if (c == '*') {
+            // "**" equivale a "*"
+            if (padrao.empty() || padrao.back().tipo != Elemento::Estrela)
+                padrao.push_back({Elemento::Estrela, 0, 0});
+            ++i;
+        } else if (c == '?') {
+            padrao.push_back({Elemento::Qualquer, 0, 0});
+            ++i;
+        } else if (c == '[' && lerClasse(texto, i, classe)) {
+            padrao.push_back({Elemento::Classe, 0, static_cast<uint16_t>(classes.size())});
+            classes.push_back(classe);
+        } else {
+            if (c == '\\' && i + 1 < texto.size()) c = texto[++i];
+            temBarra |= (c == '/');
+            padrao.push_back({Elemento::Literal, static_cast<unsigned char>(c), 0});
+            ++i;
+        }
+    }
+    ++quantidade;
+
+    if (temBarra) {
+        padroesCaminho.push_back(std::move(padrao));
+        return;
+    }
+
+    // Formas simples: sem curingas, "*sufixo" e "prefixo*"
+    auto literal = [](const Elemento& e) { return e.tipo == Elemento::Literal; };
+    auto textoDe = [](Padrao::const_iterator de, Padrao::const_iterator ate) {
+        std::string s;
+        for (; de != ate; ++de) s += static_cast<char>(de->caractere);
+        return s;
+    };
+    if (std::all_of(padrao.begin(), padrao.end(), literal)) {
+        textosExatos.push_back(textoDe(padrao.begin(), padrao.end()));
+        nomesExatos.insert(textosExatos.back());
+    } else if (padrao.front().tipo == Elemento::Estrela &&
+               std::all_of(padrao.begin() + 1, padrao.end(), literal)) {
+        sufixos.push_back(textoDe(padrao.begin() + 1, padrao.end()));
+    } else if (padrao.back().tipo == Elemento::Estrela &&
+               std::all_of(padrao.begin(), padrao.end() - 1, literal)) {
+        prefixos.push_back(textoDe(padrao.begin(), padrao.end() - 1));
+    } else {
+        padroesNome.push_back(std::move(padrao));
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Casamento com um único ponto de retorno: ao falhar, a última '*' passa a
+// consumir um caractere a mais. Sem recursão, O(padrão × texto) no pior caso
+// e linear nos padrões usuais.
+// ----------------------------------------------------------------------------
+bool PadroesExclusao::casa(const Padrao& padrao, std::string_view texto) const {
+    size_t p = 0, t = 0;
+    size_t estrela = padrao.size(), marca = 0;
+    while (t < texto.size()) {
+        if (p < padrao.size()) {
+            const Elemento& e = padrao[p];
+            unsigned char c = static_cast<unsigned char>(texto[t]);
+            if (e.tipo == Elemento::Estrela) {
+                estrela = p++;
+                marca = t;
+                continue;
+            }
+            bool ok = e.tipo == Elemento::Qualquer ||
+                      (e.tipo == Elemento::Literal && e.caractere == c) ||
+                      (e.tipo == Elemento::Classe && classes[e.classe].test(c));
+            if (ok) {
+                ++p;
+                ++t;
+                continue;
+            }
+        }
+        if (estrela == padrao.size()) return false;
+        p = estrela + 1;
+        t = ++marca;
+    }
+    while (p < padrao.size() && padrao[p].tipo == Elemento::Estrela) ++p;
+    return p == padrao.size();
+}
+
+// ============================================================================
+// Método: exclui
+// ============================================================================
+bool PadroesExclusao::exclui(std::string_view pasta, std::string_view nome) const {
+    if (quantidade == 0) return false;
+    if (nomesExatos.count(nome)) return true;
+    for (const auto& s : sufixos) {
+        if (nome.size() >= s.size() && nome.compare(nome.size() - s.size(), s.size(), s) == 0)
+            return true;
+    }
+    for (const auto& s : prefixos) {
+        if (nome.compare(0, s.size(), s) == 0) return true;
+    }
+    for (const auto& p : padroesNome) {
+        if (casa(p, nome)) return true;
+    }
+    if (padroesCaminho.empty()) return false;
+
+    // O caminho só é montado quando há padrões de caminho
+    std::string caminho;
+    caminho.reserve(pasta.size() + 1 + nome.size());
+    caminho.append(pasta);
+    if (!caminho.empty() && caminho.back() != '/') caminho += '/';
+    caminho.append(nome);
+    for (const auto& p : padroesCaminho) {
+        if (casa(p, caminho)) return true;
+    }
+    return false;
+}
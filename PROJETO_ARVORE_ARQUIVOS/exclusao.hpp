@@ -0,0 +1,74 @@
+// ============================================================================
+// Arquivo: exclusao.hpp
+// Finalidade: Declarar os padrões de exclusão da varredura (globs como
+//             ".git", "node_modules", "*.o" ou "*/build/cache"), compilados
+//             uma única vez para que a conferência de cada entrada seja
+//             barata.
+// ============================================================================
+#ifndef EXCLUSAO_HPP
+#define EXCLUSAO_HPP
+
+#include <bitset>                     // Classes de caracteres
+#include <cstdint>                    // uint16_t
+#include <deque>                      // Nomes exatos (endereços estáveis)
+#include <string>
+#include <string_view>
+#include <unordered_set>              // Busca dos nomes exatos
+#include <vector>
+
+// ============================================================================
+// Classe: PadroesExclusao
+// Objetivo: Guardar os padrões já compilados. Sintaxe dos globs:
+//             *       qualquer sequência (inclusive vazia)
+//             ?       um caractere qualquer
+//             [abc]   um dos caracteres; aceita faixas ("[a-z]") e negação
+//                     ("[!abc]" ou "[^abc]")
+//             \c      o caractere c, literalmente
+//           Um padrão sem '/' é comparado ao nome da entrada; com '/', ao
+//           caminho completo (pasta + "/" + nome), e aí '*' também atravessa
+//           '/'. Os padrões mais comuns não passam pelo casamento geral:
+//           nomes exatos ficam em uma tabela hash, e "*sufixo" e "prefixo*"
+//           são comparados diretamente.
+//           Depois de montado, o objeto só é lido: pode ser compartilhado
+//           pelas threads da varredura.
+// ============================================================================
+class PadroesExclusao {
+public:
+    PadroesExclusao() = default;
+    // A cópia refaz a tabela de nomes exatos, que aponta para os próprios textos
+    PadroesExclusao(const PadroesExclusao& outro) { *this = outro; }
+    PadroesExclusao& operator=(const PadroesExclusao& outro);
+    PadroesExclusao(PadroesExclusao&&) = default;
+    PadroesExclusao& operator=(PadroesExclusao&&) = default;
+
+    // Compila e acrescenta um padrão (um '[' sem ']' vale como literal)
+    void adicionar(std::string_view padrao);
+
+    bool vazio() const { return quantidade == 0; }
+    size_t tamanho() const { return quantidade; }
+
+    // A entrada "nome", dentro da pasta "pasta", deve ser ignorada?
+    bool exclui(std::string_view pasta, std::string_view nome) const;
+
+private:
+    // Um elemento do padrão compilado: caractere literal, '?', '*' ou classe
+    struct Elemento {
+        enum Tipo : uint8_t { Literal, Qualquer, Estrela, Classe } tipo;
+        unsigned char caractere;      // Literal
+        uint16_t classe;              // Índice em "classes"
+    };
+    using Padrao = std::vector<Elemento>;
+
+    bool casa(const Padrao& padrao, std::string_view texto) const;
+
+    size_t quantidade = 0;
+    std::deque<std::string> textosExatos;                 // Donos dos string_view
+    std::unordered_set<std::string_view> nomesExatos;     // Sem curingas
+    std::vector<std::string> sufixos;                     // "*sufixo"
+    std::vector<std::string> prefixos;                    // "prefixo*"
+    std::vector<Padrao> padroesNome;                      // Demais, sem '/'
+    std::vector<Padrao> padroesCaminho;                   // Com '/'
+    std::vector<std::bitset<256>> classes;
+};
+
+#endif // EXCLUSAO_HPP
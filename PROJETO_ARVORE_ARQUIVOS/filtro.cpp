@@ -0,0 +1,298 @@
+// ============================================================================
+// Arquivo: filtro.cpp
+// Finalidade: Implementa a leitura das expressões de filtro (descida
+//             recursiva que gera o programa pós-fixo) e a avaliação por nó.
+// ============================================================================
+#include "filtro.hpp"
+#include <cctype>
+#include <charconv>                   // std::from_chars
+#include <cstdint>                    // UINTMAX_MAX
+
+std::string_view extensaoDe(std::string_view nome) {
+    if (nome == "." || nome == "..") return {};
+    size_t pos = nome.rfind('.');
+    if (pos == std::string_view::npos || pos == 0) return {};
+    return nome.substr(pos);
+}
+
+// Letras de palavras-chave e nomes de critérios (bytes >= 0x80: "não")
+static bool letra(char c) {
+    unsigned char u = static_cast<unsigned char>(c);
+    return std::isalnum(u) || c == '_' || u >= 0x80;
+}
+
+// ============================================================================
+// Classe: Filtro::Analisador
+// Objetivo: Descida recursiva sobre a gramática
+//             expressao := termo { ("ou" | "||") termo }
+//             termo     := fator { ("e" | "&&") fator }
+//             fator     := ("nao" | "não" | "!") fator | "(" expressao ")" | criterio
+//           emitindo cada operação depois dos operandos (pós-ordem).
+// ============================================================================
+class Filtro::Analisador {
+public:
+    Analisador(std::string_view texto, Filtro& filtro) : texto(texto), filtro(filtro) {}
+
+    bool analisar(std::string* erro) {
+        bool ok = expressao();
+        if (ok) {
+            pular();
+            if (pos < texto.size()) ok = falhar("texto inesperado");
+        }
+        if (!ok && erro) {
+            *erro = mensagem + " (posição " + std::to_string(pos + 1) + ")";
+        }
+        return ok;
+    }
+
+private:
+    std::string_view texto;
+    Filtro& filtro;
+    size_t pos = 0;
+    size_t profundidade = 0;          // Altura da pilha de avaliação neste ponto
+    size_t aninhamento = 0;           // "nao" e "(" abertos (chamadas recursivas)
+
+    // Limita a recursão da descida: MAX_PILHA só limita a pilha de avaliação,
+    // e "!!!!…" ou "((((…" não empilham nada
+    static constexpr size_t MAX_ANINHAMENTO = 256;
+    std::string mensagem;
+
+    bool falhar(std::string m) {
+        if (mensagem.empty()) mensagem = std::move(m);
+        return false;
+    }
+
+    void pular() {
+        while (pos < texto.size() && std::isspace(static_cast<unsigned char>(texto[pos]))) ++pos;
+    }
+
+    bool simbolo(std::string_view s) {
+        pular();
+        if (texto.compare(pos, s.size(), s) != 0) return false;
+        pos += s.size();
+        return true;
+    }
+
+    // A palavra só casa inteira ("e" não casa com o começo de "ext")
+    bool palavra(std::string_view p) {
+        pular();
+        if (texto.compare(pos, p.size(), p) != 0) return false;
+        if (pos + p.size() < texto.size() && letra(texto[pos + p.size()])) return false;
+        pos += p.size();
+        return true;
+    }
+
+    bool emitir(Instrucao instrucao) {
+        switch (instrucao.operacao) {
+            case Operacao::E:
+            case Operacao::Ou:  --profundidade; break;
+            case Operacao::Nao: break;
+            default:
+                if (++profundidade > MAX_PILHA) return falhar("expressão aninhada demais");
+        }
+        filtro.programa.push_back(std::move(instrucao));
+        return true;
+    }
+
+    bool expressao() {
+        if (!termo()) return false;
+        while (palavra("ou") || simbolo("||")) {
+            if (!termo() || !emitir({Operacao::Ou})) return false;
+        }
+        return true;
+    }
+
+    bool termo() {
+        if (!fator()) return false;
+        while (palavra("e") || simbolo("&&")) {
+            if (!fator() || !emitir({Operacao::E})) return false;
+        }
+        return true;
+    }
+
+    bool fator() {
+        if (palavra("nao") || palavra("não") || simbolo("!")) {
+            if (++aninhamento > MAX_ANINHAMENTO) return falhar("expressão aninhada demais");
+            bool ok = fator() && emitir({Operacao::Nao});
+            --aninhamento;
+            return ok;
+        }
+        if (simbolo("(")) {
+            if (++aninhamento > MAX_ANINHAMENTO) return falhar("expressão aninhada demais");
+            if (!expressao()) return false;
+            --aninhamento;
+            return simbolo(")") || falhar("falta ')'");
+        }
+        return criterio();
+    }
+
+    bool comparacao(Comparacao& c) {
+        pular();
+        if (simbolo("<=")) c = Comparacao::MenorIgual;
+        else if (simbolo(">=")) c = Comparacao::MaiorIgual;
+        else if (simbolo("!=")) c = Comparacao::Diferente;
+        else if (simbolo("<")) c = Comparacao::Menor;
+        else if (simbolo(">")) c = Comparacao::Maior;
+        else if (simbolo("=")) c = Comparacao::Igual;
+        else return falhar("operador de comparação esperado");
+        return true;
+    }
+
+    // Número com sufixo opcional K, M, G ou T (potências de 1024)
+    bool numero(uintmax_t& valor) {
+        pular();
+        valor = 0;
+        const char* fim = texto.data() + texto.size();
+        auto [ptr, ec] = std::from_chars(texto.data() + pos, fim, valor);
+        if (ec == std::errc::invalid_argument) return falhar("número esperado");
+        if (ec == std::errc::result_out_of_range) return falhar("número fora do intervalo");
+        pos = static_cast<size_t>(ptr - texto.data());
+        if (pos < texto.size()) {
+            int deslocamento = 0;
+            switch (std::toupper(static_cast<unsigned char>(texto[pos]))) {
+                case 'K': deslocamento = 10; break;
+                case 'M': deslocamento = 20; break;
+                case 'G': deslocamento = 30; break;
+                case 'T': deslocamento = 40; break;
+            }
+            if (deslocamento > 0) {
+                if (valor > (UINTMAX_MAX >> deslocamento)) {
+                    return falhar("número fora do intervalo");
+                }
+                valor <<= deslocamento;
+                ++pos;
+            }
+        }
+        return true;
+    }
+
+    // Texto até o próximo espaço ou ')', ou entre aspas simples ou duplas
+    bool valorTexto(std::string& valor) {
+        pular();
+        if (pos < texto.size() && (texto[pos] == '"' || texto[pos] == '\'')) {
+            size_t fim = texto.find(texto[pos], pos + 1);
+            if (fim == std::string_view::npos) return falhar("aspas sem fechamento");
+            valor.assign(texto.substr(pos + 1, fim - pos - 1));
+            pos = fim + 1;
+            return true;
+        }
+        size_t inicio = pos;
+        while (pos < texto.size() && texto[pos] != ')'
+               && !std::isspace(static_cast<unsigned char>(texto[pos]))) {
+            ++pos;
+        }
+        if (pos == inicio) return falhar("valor esperado");
+        valor.assign(texto.substr(inicio, pos - inicio));
+        return true;
+    }
+
+    bool criterio() {
+        pular();
+        size_t inicio = pos;
+        while (pos < texto.size() && letra(texto[pos])) ++pos;
+        std::string_view nome = texto.substr(inicio, pos - inicio);
+        if (nome.empty()) return falhar("critério esperado");
+
+        if (nome == "arquivo") return emitir({Operacao::Arquivo});
+        if (nome == "pasta") return emitir({Operacao::Pasta});
+        if (nome == "vazia") return emitir({Operacao::Vazia});
+
+        Instrucao instrucao{Operacao::Tamanho};
+        if (nome == "tamanho") instrucao.operacao = Operacao::Tamanho;
+        else if (nome == "alocado") instrucao.operacao = Operacao::Alocado;
+        else if (nome == "filhos") instrucao.operacao = Operacao::Filhos;
+        else if (nome == "nivel" || nome == "nível") instrucao.operacao = Operacao::Nivel;
+        else if (nome == "ext") instrucao.operacao = Operacao::Extensao;
+        else if (nome == "nome") instrucao.operacao = Operacao::Nome;
+        else {
+            pos = inicio;
+            return falhar("critério desconhecido: " + std::string(nome));
+        }
+        if (!comparacao(instrucao.comparacao)) return false;
+
+        if (instrucao.operacao != Operacao::Extensao && instrucao.operacao != Operacao::Nome) {
+            return numero(instrucao.numero) && emitir(std::move(instrucao));
+        }
+        if (instrucao.comparacao != Comparacao::Igual
+            && instrucao.comparacao != Comparacao::Diferente) {
+            return falhar("\"" + std::string(nome) + "\" só aceita = e !=");
+        }
+        if (!valorTexto(instrucao.texto)) return false;
+        if (instrucao.operacao == Operacao::Nome) {
+            instrucao.padrao = filtro.padroes.size();
+            filtro.padroes.emplace_back();
+            filtro.padroes.back().adicionar(instrucao.texto);
+        }
+        return emitir(std::move(instrucao));
+    }
+};
+
+// ============================================================================
+// Método: compilar
+// ============================================================================
+bool Filtro::compilar(std::string_view texto, std::string* erro) {
+    expressao.assign(texto);
+    programa.clear();
+    padroes.clear();
+    Analisador analisador(texto, *this);
+    if (!analisador.analisar(erro)) {
+        programa.clear();
+        padroes.clear();
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Método: aceita
+// ============================================================================
+bool Filtro::aceita(const InfoNodo& info) const {
+    if (programa.empty()) return true;
+    bool pilha[MAX_PILHA];
+    size_t topo = 0;
+    for (const Instrucao& i : programa) {
+        auto compara = [&i](uintmax_t valor) {
+            switch (i.comparacao) {
+                case Comparacao::Menor:      return valor < i.numero;
+                case Comparacao::MenorIgual: return valor <= i.numero;
+                case Comparacao::Igual:      return valor == i.numero;
+                case Comparacao::Diferente:  return valor != i.numero;
+                case Comparacao::MaiorIgual: return valor >= i.numero;
+                case Comparacao::Maior:      return valor > i.numero;
+            }
+            return false;
+        };
+        bool igual = i.comparacao == Comparacao::Igual;
+        switch (i.operacao) {
+            case Operacao::Arquivo:  pilha[topo++] = info.tipo == TipoNodo::Arquivo; break;
+            case Operacao::Pasta:    pilha[topo++] = info.tipo == TipoNodo::Pasta; break;
+            case Operacao::Vazia:
+                pilha[topo++] = info.tipo == TipoNodo::Pasta && info.numFilhos == 0;
+                break;
+            case Operacao::Tamanho:  pilha[topo++] = compara(info.tamanho); break;
+            case Operacao::Alocado:  pilha[topo++] = compara(info.alocado); break;
+            case Operacao::Filhos:   pilha[topo++] = compara(info.numFilhos); break;
+            case Operacao::Nivel:
+                pilha[topo++] = info.nivel >= 0 && compara(static_cast<uintmax_t>(info.nivel));
+                break;
+            case Operacao::Extensao:
+                pilha[topo++] = (extensaoDe(info.nome) == i.texto) == igual;
+                break;
+            case Operacao::Nome:
+                pilha[topo++] = padroes[i.padrao].exclui(pastaDe(info), info.nome) == igual;
+                break;
+            case Operacao::E:
+                --topo;
+                pilha[topo - 1] = pilha[topo - 1] && pilha[topo];
+                break;
+            case Operacao::Ou:
+                --topo;
+                pilha[topo - 1] = pilha[topo - 1] || pilha[topo];
+                break;
+            case Operacao::Nao:
+                pilha[topo - 1] = !pilha[topo - 1];
+                break;
+        }
+    }
+    return pilha[0];
+}
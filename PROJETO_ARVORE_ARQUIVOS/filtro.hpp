@@ -0,0 +1,71 @@
+// ============================================================================
+// Arquivo: filtro.hpp
+// Finalidade: Declarar os filtros das pesquisas: uma expressão que combina
+//             critérios sobre os nós (tipo, tamanho, extensão, nome, número de
+//             filhos, nível) e é avaliada em uma única passada pela árvore.
+// ============================================================================
+#ifndef FILTRO_HPP
+#define FILTRO_HPP
+
+#include <cstdint>                    // uintmax_t
+#include <string>                     // Textos dos critérios, mensagem de erro
+#include <string_view>                // Expressão
+#include <vector>                     // Programa compilado
+#include "exclusao.hpp"               // Globs de "nome"
+#include "percurso.hpp"               // InfoNodo
+
+// Extensão de um nome, com as mesmas regras de fs::path::extension()
+// ("arq.tar.gz" -> ".gz"; ".bashrc" -> ""; "." e ".." -> "")
+std::string_view extensaoDe(std::string_view nome);
+
+// ============================================================================
+// Classe: Filtro
+// Objetivo: Expressão já compilada. Sintaxe:
+//             arquivo | pasta | vazia          tipo do nó (vazia: pasta sem filhos)
+//             tamanho OP N   alocado OP N      bytes; N aceita K, M, G e T (base 1024)
+//             filhos OP N    nivel OP N        filhos diretos, profundidade (raiz = 0)
+//             ext = .log     ext != .o         extensão (como fs::path::extension)
+//             nome = GLOB    nome != GLOB      glob como em "--excluir"
+//           com OP entre <, <=, =, !=, >= e >, combinados por "e" (&&),
+//           "ou" (||), "nao" (!) e parênteses; "e" tem precedência sobre "ou".
+//           Ex.: "arquivo e tamanho > 100M e (ext = .log ou ext = .gz)".
+//           A expressão é guardada em notação pós-fixa: avaliar um nó é um
+//           laço sobre um vetor, sem recursão nem alocação. Depois de
+//           compilado, o filtro só é lido (pode ser usado por várias threads).
+// ============================================================================
+class Filtro {
+public:
+    // Compila "expressao"; se houver erro, devolve false e o descreve em "erro"
+    bool compilar(std::string_view expressao, std::string* erro = nullptr);
+
+    // O nó satisfaz a expressão? (um filtro vazio aceita todos)
+    bool aceita(const InfoNodo& info) const;
+
+    bool vazio() const { return programa.empty(); }
+    const std::string& texto() const { return expressao; }
+
+private:
+    enum class Operacao : uint8_t {
+        Arquivo, Pasta, Vazia, Tamanho, Alocado, Filhos, Nivel, Extensao, Nome,
+        E, Ou, Nao
+    };
+    enum class Comparacao : uint8_t { Menor, MenorIgual, Igual, Diferente, MaiorIgual, Maior };
+
+    struct Instrucao {
+        Operacao operacao;
+        Comparacao comparacao = Comparacao::Igual;
+        uintmax_t numero = 0;
+        std::string texto;            // Extensão
+        size_t padrao = 0;            // Índice em "padroes" (nome)
+    };
+
+    class Analisador;                 // Leitura da expressão (filtro.cpp)
+
+    static constexpr size_t MAX_PILHA = 64;
+
+    std::string expressao;
+    std::vector<Instrucao> programa;
+    std::vector<PadroesExclusao> padroes;
+};
+
+#endif // FILTRO_HPP
@@ -0,0 +1,101 @@
+// ============================================================================
+// Arquivo: gerador_arvore.cpp
+// Finalidade: Implementa o gerador de árvores sintéticas dos benchmarks.
+// ============================================================================
+#include "gerador_arvore.hpp"
+#include <cerrno>
+#include <filesystem>
+#include <random>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>                     // open
+#include <sys/stat.h>                  // mkdir
+#include <unistd.h>                    // ftruncate, close
+
+namespace fs = std::filesystem;
+
+// ============================================================================
+// Função: distribuicaoPorNome
+// ============================================================================
+bool distribuicaoPorNome(std::string_view nome, DistribuicaoTamanho& distribuicao) {
+    if (nome == "fixa")             distribuicao = DistribuicaoTamanho::Fixa;
+    else if (nome == "uniforme")    distribuicao = DistribuicaoTamanho::Uniforme;
+    else if (nome == "exponencial") distribuicao = DistribuicaoTamanho::Exponencial;
+    else return false;
+    return true;
+}
+
+// Lança o erro da última chamada de sistema como filesystem_error
+[[noreturn]] static void falhar(const char* operacao, const std::string& caminho) {
+    throw fs::filesystem_error(operacao, fs::path(caminho),
+                               std::error_code(errno, std::generic_category()));
+}
+
+// ----------------------------------------------------------------------------
+// Sorteia um tamanho segundo a distribuição pedida
+// ----------------------------------------------------------------------------
+static uintmax_t sortearTamanho(const ParametrosGerador& p, std::mt19937_64& rng) {
+    double media = static_cast<double>(p.tamanhoMedio);
+    switch (p.distribuicao) {
+        case DistribuicaoTamanho::Fixa:
+            return p.tamanhoMedio;
+        case DistribuicaoTamanho::Uniforme:
+            return static_cast<uintmax_t>(std::uniform_real_distribution<double>(0, 2 * media)(rng));
+        case DistribuicaoTamanho::Exponencial:
+            if (media <= 0) return 0;
+            return static_cast<uintmax_t>(std::exponential_distribution<double>(1 / media)(rng));
+    }
+    return p.tamanhoMedio;
+}
+
+// ============================================================================
+// Função: gerarArvore
+// Objetivo: Pilha explícita de (pasta, nível); cada pasta recebe seus
+//           arquivos e empilha suas subpastas.
+// ============================================================================
+ResumoGerador gerarArvore(const std::string& raiz, const ParametrosGerador& p) {
+    static const char* const EXTENSOES[] = {".txt", ".log", ".bin", ".jpg", ".cpp"};
+
+    std::mt19937_64 rng(p.semente);
+    std::uniform_int_distribution<unsigned> percentual(0, 99);
+    ResumoGerador resumo;
+
+    std::vector<std::pair<std::string, unsigned>> pilha;
+    if (::mkdir(raiz.c_str(), 0755) != 0 && errno != EEXIST) falhar("mkdir", raiz);
+    pilha.emplace_back(raiz, 0);
+
+    std::string caminho;
+    while (!pilha.empty()) {
+        auto [pasta, nivel] = std::move(pilha.back());
+        pilha.pop_back();
+        ++resumo.pastas;
+
+        bool folha = nivel == p.profundidade;
+        bool vazia = folha && percentual(rng) < p.percentualVazias;
+        for (unsigned i = 0; !vazia && i < p.arquivosPorPasta; ++i) {
+            caminho = pasta + "/arquivo_" + std::to_string(i) + EXTENSOES[i % 5];
+            uintmax_t tamanho = sortearTamanho(p, rng);
+            int fd = ::open(caminho.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0) falhar("open", caminho);
+            if (::ftruncate(fd, static_cast<off_t>(tamanho)) != 0) {
+                int erro = errno;
+                ::close(fd);
+                errno = erro;
+                falhar("ftruncate", caminho);
+            }
+            ::close(fd);
+            ++resumo.arquivos;
+            resumo.bytes += tamanho;
+        }
+
+        if (folha) continue;
+        for (unsigned i = 0; i < p.ramificacao; ++i) {
+            caminho = pasta + "/pasta_" + std::to_string(i);
+            if (::mkdir(caminho.c_str(), 0755) != 0 && errno != EEXIST) falhar("mkdir", caminho);
+            pilha.emplace_back(caminho, nivel + 1);
+        }
+    }
+    return resumo;
+}
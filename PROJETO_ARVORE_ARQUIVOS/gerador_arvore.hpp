@@ -0,0 +1,58 @@
+// ============================================================================
+// Arquivo: gerador_arvore.hpp
+// Finalidade: Declarar o gerador de árvores sintéticas usado pelos benchmarks:
+//             cria em disco uma hierarquia de pastas e arquivos com
+//             ramificação, profundidade, quantidade de arquivos e distribuição
+//             de tamanhos configuráveis.
+// ============================================================================
+#ifndef GERADOR_ARVORE_HPP
+#define GERADOR_ARVORE_HPP
+
+#include <cstdint>                    // uint64_t, uintmax_t
+#include <string>                     // Caminho da raiz
+#include <string_view>                // Nome da distribuição
+
+// ============================================================================
+// Enumeração: DistribuicaoTamanho
+//   - Fixa:        todos os arquivos com o tamanho médio.
+//   - Uniforme:    entre 0 e 2 x o tamanho médio.
+//   - Exponencial: muitos arquivos pequenos e poucos grandes (média igual).
+// ============================================================================
+enum class DistribuicaoTamanho { Fixa, Uniforme, Exponencial };
+
+// Converte "fixa", "uniforme" ou "exponencial"; false se desconhecido
+bool distribuicaoPorNome(std::string_view nome, DistribuicaoTamanho& distribuicao);
+
+// ============================================================================
+// Estrutura: ParametrosGerador
+// ============================================================================
+struct ParametrosGerador {
+    unsigned ramificacao = 8;          // Subpastas por pasta
+    unsigned profundidade = 4;         // Níveis de subpastas abaixo da raiz
+    unsigned arquivosPorPasta = 20;    // Arquivos em cada pasta não vazia
+    uintmax_t tamanhoMedio = 4096;     // Bytes
+    DistribuicaoTamanho distribuicao = DistribuicaoTamanho::Exponencial;
+    unsigned percentualVazias = 5;     // Pastas do último nível sem arquivos (%)
+    uint64_t semente = 42;             // Mesma semente = mesma árvore
+};
+
+// ============================================================================
+// Estrutura: ResumoGerador
+// ============================================================================
+struct ResumoGerador {
+    uint64_t pastas = 0;               // Inclui a raiz
+    uint64_t arquivos = 0;
+    uintmax_t bytes = 0;               // Soma dos tamanhos aparentes
+};
+
+// ============================================================================
+// Função: gerarArvore
+// Objetivo: Criar a árvore sob "raiz" (que é criada se não existir). Os
+//           arquivos são esparsos (ftruncate): têm o tamanho pedido sem
+//           ocupar o disco nem custar escrita de dados. Os nomes usam algumas
+//           extensões fixas (.txt, .log, .bin, .jpg, .cpp) para as pesquisas.
+// Erros:   Lança std::filesystem::filesystem_error se algo não puder ser criado.
+// ============================================================================
+ResumoGerador gerarArvore(const std::string& raiz, const ParametrosGerador& parametros);
+
+#endif // GERADOR_ARVORE_HPP
@@ -9,11 +9,14 @@
 #include <memory>
 #include <string>
 #include "nodo.hpp"  // Estrutura Nodo usada para navegar na árvore
+#include "arvore_compacta.hpp"  // ArvoreCompacta
 
 // ----------------------------------------------------------------------------
 // Função: exportarParaHTML
 // Objetivo: Receber a raiz da árvore de arquivos e gerar um arquivo HTML que
-//           apresente a estrutura hierárquica em formato pré-formatado.
+//           apresente a estrutura hierárquica com pastas recolhíveis
+//           (<details>). A escrita é feita em fluxo, por um buffer de tamanho
+//           fixo: a memória usada não depende do tamanho da árvore.
 // Parâmetros:
 //   - raiz: ponteiro para o nó raiz da árvore (std::shared_ptr<Nodo>)
 //   - nomeArquivo: nome (ou caminho) do arquivo HTML de saída (std::string)
@@ -22,4 +25,8 @@
 void exportarParaHTML(const std::shared_ptr<Nodo>& raiz,
                       const std::string& nomeArquivo);
 
+// Mesma exportação, sobre a representação compacta da árvore
+void exportarParaHTML(const ArvoreCompacta& arvore,
+                      const std::string& nomeArquivo);
+
 #endif // HTML_EXPORT_HPP
@@ -0,0 +1,340 @@
+// ============================================================================
+// Arquivo: indices.cpp
+// Finalidade: Implementa os índices secundários das pesquisas, montados sob
+//             demanda por um percurso (sequencial ou dividido entre threads)
+//             da árvore.
+// ============================================================================
+#include "indices.hpp"
+#include "duplicados.hpp"
+#include "estatisticas_arvore.hpp"
+#include "pool_tarefas.hpp"
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+// ============================================================================
+// Estrutura: IndicesPesquisa::Indice
+// Objetivo: Caminhos concatenados em um bloco e as entradas que apontam para
+//           ele. Durante a montagem o bloco cresce, por isso as posições são
+//           guardadas à parte e convertidas em string_view ao finalizar.
+// ============================================================================
+struct IndicesPesquisa::Indice {
+    std::string bloco;
+    std::vector<EntradaIndice> entradas;
+    std::vector<std::pair<size_t, size_t>> posicoes;   // (início, tamanho) no bloco
+
+    void anexar(const InfoNodo& info) {
+        posicoes.emplace_back(bloco.size(), info.caminho.size());
+        bloco.append(info.caminho.data(), info.caminho.size());
+        entradas.push_back({std::string_view(), info.tamanho, info.alocado});
+    }
+
+    // Acrescenta as entradas de "outra" (ainda não finalizada) e a esvazia
+    void juntar(Indice& outra) {
+        size_t deslocamento = bloco.size();
+        bloco += outra.bloco;
+        for (const auto& [inicio, tamanho] : outra.posicoes) {
+            posicoes.emplace_back(inicio + deslocamento, tamanho);
+        }
+        entradas.insert(entradas.end(), outra.entradas.begin(), outra.entradas.end());
+        outra = Indice();
+    }
+
+    // Junta os resultados locais das partes, na ordem delas
+    static Indice juntarTodas(std::vector<Indice>& partes) {
+        Indice resultado;
+        size_t bytes = 0, quantidade = 0;
+        for (const auto& parte : partes) {
+            bytes += parte.bloco.size();
+            quantidade += parte.entradas.size();
+        }
+        resultado.bloco.reserve(bytes);
+        resultado.posicoes.reserve(quantidade);
+        resultado.entradas.reserve(quantidade);
+        for (auto& parte : partes) resultado.juntar(parte);
+        return resultado;
+    }
+
+    void finalizar() {
+        bloco.shrink_to_fit();
+        for (size_t i = 0; i < entradas.size(); ++i) {
+            entradas[i].caminho = std::string_view(bloco.data() + posicoes[i].first,
+                                                   posicoes[i].second);
+        }
+        posicoes.clear();
+        posicoes.shrink_to_fit();
+        entradas.shrink_to_fit();
+    }
+
+    FaixaIndice faixa(size_t de, size_t ate) const {
+        return {entradas.data() + de, entradas.data() + ate};
+    }
+    FaixaIndice tudo() const { return faixa(0, entradas.size()); }
+};
+
+// ----------------------------------------------------------------------------
+// Visitante que chama uma função para cada nó
+// ----------------------------------------------------------------------------
+template <typename Acao>
+class VisitanteIndice : public VisitanteArvore {
+public:
+    explicit VisitanteIndice(Acao& acao) : acao(acao) {}
+
+    void entrar(const InfoNodo& info) override { acao(info); }
+
+private:
+    Acao& acao;
+};
+
+// ============================================================================
+// Construtor / destrutor
+// ============================================================================
+IndicesPesquisa::IndicesPesquisa(Percurso percorrer, std::function<uint64_t()> versao,
+                                 PercursoParalelo paralelo, unsigned threads)
+    : percorrer(std::move(percorrer)), versao(std::move(versao)),
+      paralelo(std::move(paralelo)),
+      threads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())) {
+    if (this->versao) versaoIndexada = this->versao();
+}
+
+IndicesPesquisa::~IndicesPesquisa() = default;
+
+// ============================================================================
+// Execução por partes: cada parte é uma tarefa do pool, com seu próprio
+// resultado local; nenhuma trava é disputada durante o percurso
+// ============================================================================
+PartesArvore IndicesPesquisa::dividir() {
+    if (!paralelo || threads <= 1) {
+        return {1, [this](size_t, VisitanteArvore& v) { percorrer(v); }};
+    }
+    return paralelo(threads * PARTES_POR_THREAD);
+}
+
+void IndicesPesquisa::executarPartes(size_t quantidade,
+                                     const std::function<void(size_t)>& tarefa) {
+    if (quantidade <= 1 || threads <= 1) {
+        for (size_t i = 0; i < quantidade; ++i) tarefa(i);
+        return;
+    }
+    if (!pool) pool = std::make_unique<PoolTarefas>(threads);
+    for (size_t i = 0; i < quantidade; ++i) {
+        pool->submeter([&tarefa, i] { tarefa(i); });
+    }
+    pool->esperar();
+}
+
+template <typename Local, typename Acao>
+std::vector<Local> IndicesPesquisa::porParte(Acao acao) {
+    PartesArvore partes = dividir();
+    std::vector<Local> locais(partes.quantidade);
+    executarPartes(partes.quantidade, [&](size_t i) {
+        Local& local = locais[i];
+        Acao acaoParte = acao;                     // Buffers da ação não são compartilhados
+        auto entregar = [&](const InfoNodo& info) { acaoParte(local, info); };
+        VisitanteIndice<decltype(entregar)> visitante(entregar);
+        partes.percorrer(i, visitante);
+    });
+    return locais;
+}
+
+// ----------------------------------------------------------------------------
+// Se a árvore mudou desde a montagem, os índices são descartados. A versão é
+// lida antes de montar: uma alteração durante a montagem força nova montagem
+// na consulta seguinte.
+// ----------------------------------------------------------------------------
+void IndicesPesquisa::conferirVersao() {
+    if (!versao) return;
+    uint64_t atual = versao();
+    if (atual == versaoIndexada) return;
+    versaoIndexada = atual;
+    porTamanho.reset();
+    porExtensao.reset();
+    vazias.reset();
+    maisFilhos.reset();
+    grupos.reset();
+    resumo.reset();
+}
+
+// ============================================================================
+// Índice por tamanho: arquivos em ordem decrescente (ordenação estável, para
+// que empates mantenham a ordem da árvore)
+// ============================================================================
+const IndicesPesquisa::Indice& IndicesPesquisa::indicePorTamanho() {
+    conferirVersao();
+    if (!porTamanho) {
+        auto locais = porParte<Indice>([](Indice& local, const InfoNodo& a) {
+            if (a.tipo == TipoNodo::Arquivo) local.anexar(a);
+        });
+        // Limites das sequências de cada parte no índice juntado
+        std::vector<size_t> limites{0};
+        for (const auto& local : locais) limites.push_back(limites.back() + local.entradas.size());
+        auto indice = std::make_unique<Indice>(Indice::juntarTodas(locais));
+        indice->finalizar();
+
+        // Cada sequência é ordenada em paralelo e as vizinhas são intercaladas
+        // duas a duas; intercalar mantém a da esquerda primeiro nos empates
+        auto maior = [](const EntradaIndice& a, const EntradaIndice& b) {
+            return a.tamanho > b.tamanho;
+        };
+        auto inicio = indice->entradas.begin();
+        size_t sequencias = limites.size() - 1;
+        executarPartes(sequencias, [&](size_t i) {
+            std::stable_sort(inicio + limites[i], inicio + limites[i + 1], maior);
+        });
+        for (size_t passo = 1; passo < sequencias; passo *= 2) {
+            size_t pares = (sequencias + 2 * passo - 1) / (2 * passo);
+            executarPartes(pares, [&](size_t p) {
+                size_t esquerda = p * 2 * passo;
+                size_t meio = std::min(esquerda + passo, sequencias);
+                size_t direita = std::min(esquerda + 2 * passo, sequencias);
+                if (meio < direita) {
+                    std::inplace_merge(inicio + limites[esquerda], inicio + limites[meio],
+                                       inicio + limites[direita], maior);
+                }
+            });
+        }
+        porTamanho = std::move(indice);
+    }
+    return *porTamanho;
+}
+
+FaixaIndice IndicesPesquisa::maioresArquivos() {
+    const Indice& indice = indicePorTamanho();
+    const auto& e = indice.entradas;
+    if (e.empty()) return {};
+    auto fim = std::partition_point(e.begin(), e.end(), [&](const EntradaIndice& a) {
+        return a.tamanho == e.front().tamanho;
+    });
+    return indice.faixa(0, static_cast<size_t>(fim - e.begin()));
+}
+
+FaixaIndice IndicesPesquisa::maioresArquivos(size_t k) {
+    const Indice& indice = indicePorTamanho();
+    return indice.faixa(0, std::min(k, indice.entradas.size()));
+}
+
+FaixaIndice IndicesPesquisa::arquivosMaioresQue(uintmax_t n) {
+    const Indice& indice = indicePorTamanho();
+    const auto& e = indice.entradas;
+    auto fim = std::partition_point(e.begin(), e.end(),
+                                    [&](const EntradaIndice& a) { return a.tamanho > n; });
+    return indice.faixa(0, static_cast<size_t>(fim - e.begin()));
+}
+
+// ============================================================================
+// Índice por extensão: um bloco por extensão, na ordem da árvore
+// ============================================================================
+FaixaIndice IndicesPesquisa::arquivosPorExtensao(std::string_view extensao) {
+    conferirVersao();
+    if (!porExtensao) {
+        using PorExtensao = std::unordered_map<std::string, Indice>;
+        auto locais = porParte<PorExtensao>([chave = std::string()](PorExtensao& local,
+                                                                    const InfoNodo& a) mutable {
+            if (a.tipo != TipoNodo::Arquivo) return;
+            chave.assign(extensaoDe(a.nome));
+            local[chave].anexar(a);
+        });
+        auto indice = std::make_unique<PorExtensao>();
+        for (auto& local : locais) {
+            for (auto& [ext, porExt] : local) (*indice)[ext].juntar(porExt);
+        }
+        for (auto& [ext, porExt] : *indice) porExt.finalizar();
+        porExtensao = std::move(indice);
+    }
+    auto it = porExtensao->find(std::string(extensao));
+    if (it == porExtensao->end()) return {};
+    return it->second.tudo();
+}
+
+// ============================================================================
+// Lista de pastas vazias, na ordem da árvore
+// ============================================================================
+FaixaIndice IndicesPesquisa::pastasVazias() {
+    conferirVersao();
+    if (!vazias) {
+        auto locais = porParte<Indice>([](Indice& local, const InfoNodo& p) {
+            if (p.tipo == TipoNodo::Pasta && p.numFilhos == 0) local.anexar(p);
+        });
+        auto indice = std::make_unique<Indice>(Indice::juntarTodas(locais));
+        indice->finalizar();
+        vazias = std::move(indice);
+    }
+    return vazias->tudo();
+}
+
+// ============================================================================
+// Pastas com mais filhos diretos: cada parte guarda o seu máximo (a lista é
+// refeita quando ele aumenta); ao juntar, ficam as partes com o máximo geral
+// ============================================================================
+FaixaIndice IndicesPesquisa::pastasComMaisFilhos(size_t& filhos) {
+    conferirVersao();
+    if (!maisFilhos) {
+        struct Maximo {
+            size_t filhos = 0;
+            Indice pastas;
+        };
+        auto locais = porParte<Maximo>([](Maximo& local, const InfoNodo& p) {
+            if (p.tipo != TipoNodo::Pasta) return;
+            if (p.numFilhos > local.filhos || local.pastas.entradas.empty()) {
+                local.filhos = p.numFilhos;
+                local.pastas = Indice();
+            }
+            if (p.numFilhos == local.filhos) local.pastas.anexar(p);
+        });
+        size_t maximo = 0;
+        for (const auto& local : locais) {
+            if (!local.pastas.entradas.empty()) maximo = std::max(maximo, local.filhos);
+        }
+        auto indice = std::make_unique<Indice>();
+        for (auto& local : locais) {
+            if (!local.pastas.entradas.empty() && local.filhos == maximo) {
+                indice->juntar(local.pastas);
+            }
+        }
+        indice->finalizar();
+        maisFilhos = std::move(indice);
+        maxFilhos = maximo;
+    }
+    filhos = maxFilhos;
+    return maisFilhos->tudo();
+}
+
+// ============================================================================
+// Filtro: uma passada, com os nós aceitos guardados por parte
+// ============================================================================
+FaixaIndice IndicesPesquisa::filtrar(const Filtro& filtro) {
+    auto locais = porParte<Indice>([&filtro](Indice& local, const InfoNodo& info) {
+        if (filtro.aceita(info)) local.anexar(info);
+    });
+    filtrados = std::make_unique<Indice>(Indice::juntarTodas(locais));
+    filtrados->finalizar();
+    return filtrados->tudo();
+}
+
+// ============================================================================
+// Duplicados: sobre o índice por tamanho, com o cache de hashes da sessão
+// ============================================================================
+const std::vector<GrupoDuplicados>& IndicesPesquisa::duplicados(EstatisticasDuplicados* estatisticas) {
+    const Indice& indice = indicePorTamanho();     // Confere a versão
+    if (!grupos) {
+        if (!cacheHashes) cacheHashes = std::make_unique<CacheHashes>();
+        grupos = std::make_unique<std::vector<GrupoDuplicados>>(
+            encontrarDuplicados(indice.tudo(), *cacheHashes, 0, estatisticas));
+    }
+    return *grupos;
+}
+
+// ============================================================================
+// Estatísticas: um acumulador por parte, juntados na ordem das partes
+// ============================================================================
+const EstatisticasArvore& IndicesPesquisa::estatisticas() {
+    conferirVersao();
+    if (!resumo) {
+        auto locais = porParte<AcumuladorEstatisticas>(
+            [](AcumuladorEstatisticas& local, const InfoNodo& info) { local.adicionar(info); });
+        AcumuladorEstatisticas total;
+        for (auto& local : locais) total.juntar(local);
+        resumo = std::make_unique<EstatisticasArvore>(total.finalizar());
+    }
+    return *resumo;
+}
@@ -0,0 +1,148 @@
+// ============================================================================
+// Arquivo: indices.hpp
+// Finalidade: Declarar os índices secundários usados pelas pesquisas: arquivos
+//             ordenados por tamanho, arquivos por extensão, pastas vazias,
+//             pastas com mais filhos, grupos de arquivos duplicados e o resumo
+//             estatístico da árvore.
+//             Cada índice é montado por um único percurso na primeira consulta
+//             que precisa dele; as consultas seguintes só leem o resultado.
+//             Com um percurso paralelo, a árvore é dividida em subárvores
+//             percorridas por várias threads, cada uma com resultados locais
+//             que são juntados na ordem da árvore ao final.
+// ============================================================================
+#ifndef INDICES_HPP
+#define INDICES_HPP
+
+#include <cstdint>                    // uintmax_t, uint64_t
+#include <functional>                 // std::function (versão da árvore)
+#include <memory>                     // std::unique_ptr
+#include <string>                     // Bloco de caminhos
+#include <string_view>                // Caminhos sem cópia
+#include <unordered_map>              // Índice por extensão
+#include <vector>                     // Entradas dos índices
+#include "percurso.hpp"               // Percurso, PercursoParalelo
+#include "filtro.hpp"                 // Filtro
+
+class PoolTarefas;
+struct GrupoDuplicados;
+struct EstatisticasDuplicados;
+struct EstatisticasArvore;
+class CacheHashes;
+
+// ============================================================================
+// Estrutura: EntradaIndice
+// Objetivo: Um nó indexado. O caminho aponta para o bloco do próprio índice e
+//           vale enquanto o índice não for descartado.
+// ============================================================================
+struct EntradaIndice {
+    std::string_view caminho;
+    uintmax_t tamanho;
+    uintmax_t alocado;         // Bytes em disco
+};
+
+// Intervalo contíguo de entradas de um índice (resultado de uma consulta)
+struct FaixaIndice {
+    const EntradaIndice* inicio = nullptr;
+    const EntradaIndice* fim = nullptr;
+
+    const EntradaIndice* begin() const { return inicio; }
+    const EntradaIndice* end() const { return fim; }
+    size_t size() const { return static_cast<size_t>(fim - inicio); }
+    bool empty() const { return inicio == fim; }
+};
+
+// ============================================================================
+// Classe: IndicesPesquisa
+// Objetivo: Guardar os índices de uma árvore. Os caminhos de cada índice ficam
+//           em um único bloco de caracteres (sem um shared_ptr ou string por
+//           nó), e as consultas devolvem intervalos desse índice: o custo é
+//           proporcional ao tamanho do resultado, não ao da árvore.
+//           Se "versao" for informada e mudar (ex.: o observador alterou a
+//           árvore), os índices são descartados e remontados na próxima
+//           consulta.
+// ============================================================================
+class IndicesPesquisa {
+public:
+    // "paralelo" (opcional) divide a árvore para a montagem em "threads"
+    // threads (0 = todos os núcleos); sem ele, os índices usam "percorrer"
+    explicit IndicesPesquisa(Percurso percorrer, std::function<uint64_t()> versao = {},
+                             PercursoParalelo paralelo = {}, unsigned threads = 0);
+    ~IndicesPesquisa();
+
+    IndicesPesquisa(const IndicesPesquisa&) = delete;
+    IndicesPesquisa& operator=(const IndicesPesquisa&) = delete;
+
+    // Percurso da árvore indexada (para consultas sem índice)
+    const Percurso& percurso() const { return percorrer; }
+
+    // Arquivos de tamanho máximo (empates na ordem da árvore)
+    FaixaIndice maioresArquivos();
+
+    // Os "k" maiores arquivos, do maior para o menor
+    FaixaIndice maioresArquivos(size_t k);
+
+    // Arquivos com mais de "n" bytes, do maior para o menor
+    FaixaIndice arquivosMaioresQue(uintmax_t n);
+
+    // Arquivos cuja extensão (como fs::path::extension) é "extensao",
+    // na ordem da árvore
+    FaixaIndice arquivosPorExtensao(std::string_view extensao);
+
+    // Pastas sem filhos, na ordem da árvore
+    FaixaIndice pastasVazias();
+
+    // Pastas com o maior número de filhos diretos, na ordem da árvore
+    // ("filhos" recebe esse número; o tamanho das entradas é o da pasta)
+    FaixaIndice pastasComMaisFilhos(size_t& filhos);
+
+    // Nós (arquivos e pastas) que satisfazem o filtro, na ordem da árvore.
+    // Todos os critérios são avaliados na mesma passada; o resultado não é
+    // guardado entre consultas e vale até a próxima chamada.
+    FaixaIndice filtrar(const Filtro& filtro);
+
+    // Grupos de arquivos com o mesmo conteúdo, do maior desperdício para o
+    // menor. Os hashes ficam em cache enquanto este objeto existir: só
+    // arquivos novos ou alterados são relidos quando a árvore muda.
+    const std::vector<GrupoDuplicados>& duplicados(EstatisticasDuplicados* estatisticas = nullptr);
+
+    // Totais por extensão, histogramas de tamanho e de arquivos por pasta e
+    // maiores pastas por nível, montados em uma passada paralela
+    const EstatisticasArvore& estatisticas();
+
+private:
+    struct Indice;                             // Bloco de caminhos + entradas
+
+    static constexpr size_t PARTES_POR_THREAD = 8;
+
+    void conferirVersao();                     // Descarta índices desatualizados
+    const Indice& indicePorTamanho();          // Monta na primeira consulta
+
+    // Divide a árvore (uma única parte sem percurso paralelo) e roda
+    // "tarefa(i)" para cada parte, no pool quando há mais de uma
+    PartesArvore dividir();
+    void executarPartes(size_t quantidade, const std::function<void(size_t)>& tarefa);
+
+    // Percorre as partes em paralelo, entregando cada nó a
+    // "acao(local da parte, info)"; devolve os locais na ordem das partes
+    template <typename Local, typename Acao>
+    std::vector<Local> porParte(Acao acao);
+
+    Percurso percorrer;
+    std::function<uint64_t()> versao;
+    uint64_t versaoIndexada = 0;
+    PercursoParalelo paralelo;
+    unsigned threads;
+    std::unique_ptr<PoolTarefas> pool;         // Criado na primeira montagem paralela
+
+    std::unique_ptr<Indice> porTamanho;        // Arquivos, tamanho decrescente
+    std::unique_ptr<std::unordered_map<std::string, Indice>> porExtensao;
+    std::unique_ptr<Indice> vazias;            // Pastas vazias
+    std::unique_ptr<Indice> maisFilhos;        // Pastas com o máximo de filhos
+    size_t maxFilhos = 0;
+    std::unique_ptr<std::vector<GrupoDuplicados>> grupos;
+    std::unique_ptr<CacheHashes> cacheHashes;  // Não é descartado com os índices
+    std::unique_ptr<Indice> filtrados;         // Último resultado de filtrar()
+    std::unique_ptr<EstatisticasArvore> resumo;
+};
+
+#endif // INDICES_HPP
@@ -0,0 +1,161 @@
+// ============================================================================
+// Arquivo: instrumentacao.cpp
+// Finalidade: Implementa os acumuladores da instrumentação e os relatórios.
+// ============================================================================
+#include "instrumentacao.hpp"
+#include "saida_bufferizada.hpp"   // Relatório em JSON
+#include <algorithm>
+#include <functional>              // std::greater
+#include <iomanip>
+
+// Faixa do histograma de uma duração: 0 para menos de 1 µs, i para [2^(i-1), 2^i) µs
+static size_t faixaDe(uint64_t ns) {
+    uint64_t us = ns / 1000;
+    size_t i = 0;
+    while (us > 0 && i + 1 < InstrumentacaoVarredura::NUM_FAIXAS) {
+        us >>= 1;
+        ++i;
+    }
+    return i;
+}
+
+// ============================================================================
+// Método: registrarPasta
+// ============================================================================
+void InstrumentacaoVarredura::registrarPasta(const std::string& caminho, uint64_t nsLeitura,
+                                             uint64_t nsMeta, uint64_t nsMont) {
+    pastasMedidas.fetch_add(1, std::memory_order_relaxed);
+    nsListagem.fetch_add(nsLeitura > nsMeta ? nsLeitura - nsMeta : 0, std::memory_order_relaxed);
+    nsMetadados.fetch_add(nsMeta, std::memory_order_relaxed);
+    nsMontagem.fetch_add(nsMont, std::memory_order_relaxed);
+    histograma[faixaDe(nsLeitura)].fetch_add(1, std::memory_order_relaxed);
+
+    if (nsLeitura <= limiar.load(std::memory_order_relaxed)) return;
+    std::lock_guard<std::mutex> lock(travaLentas);
+    auto maior = std::greater<>();
+    if (lentas.size() < MAIS_LENTAS) {
+        lentas.emplace_back(nsLeitura, caminho);
+        std::push_heap(lentas.begin(), lentas.end(), maior);
+    } else if (nsLeitura > lentas.front().first) {
+        std::pop_heap(lentas.begin(), lentas.end(), maior);
+        lentas.back() = {nsLeitura, caminho};
+        std::push_heap(lentas.begin(), lentas.end(), maior);
+    }
+    if (lentas.size() == MAIS_LENTAS) limiar.store(lentas.front().first, std::memory_order_relaxed);
+}
+
+std::vector<std::pair<uint64_t, std::string>> InstrumentacaoVarredura::maisLentas() const {
+    std::vector<std::pair<uint64_t, std::string>> resultado;
+    {
+        std::lock_guard<std::mutex> lock(travaLentas);
+        resultado = lentas;
+    }
+    std::sort(resultado.begin(), resultado.end(), std::greater<>());
+    return resultado;
+}
+
+// ----------------------------------------------------------------------------
+// Relatório em texto
+// ----------------------------------------------------------------------------
+static double segundos(uint64_t ns) { return static_cast<double>(ns) / 1e9; }
+
+static double percentual(uint64_t parte, uint64_t total) {
+    return total > 0 ? 100.0 * static_cast<double>(parte) / static_cast<double>(total) : 0;
+}
+
+void imprimirInstrumentacao(const InstrumentacaoVarredura& instr, std::ostream& os) {
+    uint64_t listagem = instr.listagemNs(), metadados = instr.metadadosNs();
+    uint64_t montagem = instr.montagemNs();
+    uint64_t tarefas = listagem + metadados + montagem;
+
+    auto formato = os.flags();
+    auto precisao = os.precision();
+    os << std::fixed << std::setprecision(3);
+    os << "[INFO] Tempo de parede: varredura " << segundos(instr.varreduraNs())
+       << " s, soma dos tamanhos " << segundos(instr.agregacaoNs()) << " s\n";
+    os << std::setprecision(1);
+    os << "[INFO] Tempo das tarefas (" << instr.pastas() << " pastas): listagem "
+       << segundos(listagem) << " s (" << percentual(listagem, tarefas) << "%), metadados "
+       << segundos(metadados) << " s (" << percentual(metadados, tarefas) << "%), montagem "
+       << segundos(montagem) << " s (" << percentual(montagem, tarefas) << "%)\n";
+
+    // Histograma: só as faixas entre a primeira e a última não vazias
+    size_t primeira = InstrumentacaoVarredura::NUM_FAIXAS, ultima = 0;
+    uint64_t maior = 0;
+    for (size_t i = 0; i < InstrumentacaoVarredura::NUM_FAIXAS; ++i) {
+        if (instr.faixa(i) == 0) continue;
+        primeira = std::min(primeira, i);
+        ultima = i;
+        maior = std::max(maior, instr.faixa(i));
+    }
+    if (primeira < InstrumentacaoVarredura::NUM_FAIXAS) {
+        os << "[INFO] Latência de leitura por pasta:\n";
+        for (size_t i = primeira; i <= ultima; ++i) {
+            uint64_t n = instr.faixa(i);
+            size_t barra = static_cast<size_t>(maior ? n * 40 / maior : 0);
+            os << "    " << std::setw(9) << InstrumentacaoVarredura::inicioFaixaUs(i) << " µs+ "
+               << std::setw(10) << n;
+            if (barra > 0) os << "  " << std::string(barra, '#');
+            os << "\n";
+        }
+    }
+
+    auto lentas = instr.maisLentas();
+    if (!lentas.empty()) {
+        os << "[INFO] Pastas mais lentas:\n";
+        os << std::setprecision(3);
+        for (const auto& [ns, caminho] : lentas) {
+            os << "    " << std::setw(10) << static_cast<double>(ns) / 1e6 << " ms  " << caminho
+               << "\n";
+        }
+    }
+    os.flags(formato);
+    os.precision(precisao);
+}
+
+// ============================================================================
+// Função: escreverInstrumentacaoJson
+// ============================================================================
+void escreverInstrumentacaoJson(const InstrumentacaoVarredura& instr, SaidaBufferizada& out) {
+    auto campo = [&](std::string_view nome, uint64_t valor, bool ultimo = false) {
+        out.escrever('"');
+        out.escrever(nome);
+        out.escrever("\":");
+        out.escreverNumero(valor);
+        if (!ultimo) out.escrever(',');
+    };
+
+    out.escrever("{\"fases_ns\":{");
+    campo("listagem", instr.listagemNs());
+    campo("metadados", instr.metadadosNs());
+    campo("montagem", instr.montagemNs());
+    campo("varredura", instr.varreduraNs());
+    campo("agregacao", instr.agregacaoNs(), true);
+    out.escrever("},\"pastas_medidas\":");
+    out.escreverNumero(instr.pastas());
+
+    out.escrever(",\"histograma_us\":[");
+    bool primeiro = true;
+    for (size_t i = 0; i < InstrumentacaoVarredura::NUM_FAIXAS; ++i) {
+        if (instr.faixa(i) == 0) continue;
+        if (!primeiro) out.escrever(',');
+        primeiro = false;
+        out.escrever('{');
+        campo("de", InstrumentacaoVarredura::inicioFaixaUs(i));
+        campo("pastas", instr.faixa(i), true);
+        out.escrever('}');
+    }
+
+    out.escrever("],\"mais_lentas\":[");
+    primeiro = true;
+    for (const auto& [ns, caminho] : instr.maisLentas()) {
+        if (!primeiro) out.escrever(',');
+        primeiro = false;
+        out.escrever('{');
+        campo("ns", ns);
+        out.escrever("\"caminho\":\"");
+        out.escreverJson(caminho);
+        out.escrever("\"}");
+    }
+    out.escrever("]}");
+}
@@ -0,0 +1,118 @@
+// ============================================================================
+// Arquivo: instrumentacao.hpp
+// Finalidade: Declarar a instrumentação da varredura: tempo gasto em cada
+//             fase (listagem dos diretórios, consulta de metadados, montagem
+//             dos nós e soma dos tamanhos), histograma da latência de leitura
+//             das pastas e as pastas mais lentas. Desligada, custa um teste
+//             de ponteiro por pasta.
+// ============================================================================
+#ifndef INSTRUMENTACAO_HPP
+#define INSTRUMENTACAO_HPP
+
+#include <array>                      // Faixas do histograma
+#include <atomic>                     // Acumuladores compartilhados
+#include <chrono>                     // steady_clock
+#include <cstdint>                    // uint64_t
+#include <mutex>                      // Trava das pastas mais lentas
+#include <ostream>                    // Relatório
+#include <string>                     // Caminhos
+#include <utility>                    // std::pair
+#include <vector>                     // Pastas mais lentas
+
+class SaidaBufferizada;
+
+// Instante atual em nanossegundos (relógio monotônico)
+inline uint64_t instanteNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// ============================================================================
+// Classe: Cronometro
+// Objetivo: Somar a "destino" a duração do escopo, só quando "ativo" (a
+//           instrumentação desligada não lê o relógio).
+// ============================================================================
+class Cronometro {
+public:
+    Cronometro(bool ativo, uint64_t& destino)
+        : destino(ativo ? &destino : nullptr), inicio(ativo ? instanteNs() : 0) {}
+    ~Cronometro() {
+        if (destino) *destino += instanteNs() - inicio;
+    }
+
+    Cronometro(const Cronometro&) = delete;
+    Cronometro& operator=(const Cronometro&) = delete;
+
+private:
+    uint64_t* destino;
+    uint64_t inicio;
+};
+
+// ============================================================================
+// Classe: InstrumentacaoVarredura
+// Objetivo: Acumular os tempos de uma varredura. As fases por pasta são
+//           somadas entre as threads (tempo de CPU das tarefas, não de
+//           parede); a varredura e a soma dos tamanhos são medidas na parede.
+//           A latência de cada pasta é o tempo da leitura completa (listagem
+//           e metadados), em faixas de potência de 2 microssegundos.
+// ============================================================================
+class InstrumentacaoVarredura {
+public:
+    static constexpr size_t NUM_FAIXAS = 32;     // Faixa i: [2^(i-1), 2^i) µs
+    static constexpr size_t MAIS_LENTAS = 10;
+
+    // Uma pasta lida: duração da leitura (da qual nsMetadados foi gasto em
+    // stat/statx) e da montagem dos nós
+    void registrarPasta(const std::string& caminho, uint64_t nsLeitura,
+                        uint64_t nsMetadados, uint64_t nsMontagem);
+
+    // Tempos de parede da execução
+    void registrarVarredura(uint64_t ns) { nsVarredura = ns; }
+    void registrarAgregacao(uint64_t ns) { nsAgregacao = ns; }
+
+    uint64_t pastas() const { return pastasMedidas.load(); }
+    uint64_t listagemNs() const { return nsListagem.load(); }
+    uint64_t metadadosNs() const { return nsMetadados.load(); }
+    uint64_t montagemNs() const { return nsMontagem.load(); }
+    uint64_t varreduraNs() const { return nsVarredura.load(); }
+    uint64_t agregacaoNs() const { return nsAgregacao.load(); }
+    uint64_t faixa(size_t i) const { return histograma[i].load(); }
+
+    // (duração em ns, caminho), da mais lenta para a menos lenta
+    std::vector<std::pair<uint64_t, std::string>> maisLentas() const;
+
+    // Limite inferior da faixa i, em microssegundos (0 para a primeira)
+    static uint64_t inicioFaixaUs(size_t i) { return i == 0 ? 0 : uint64_t(1) << (i - 1); }
+
+private:
+    std::atomic<uint64_t> pastasMedidas{0};
+    std::atomic<uint64_t> nsListagem{0};
+    std::atomic<uint64_t> nsMetadados{0};
+    std::atomic<uint64_t> nsMontagem{0};
+    std::atomic<uint64_t> nsVarredura{0};
+    std::atomic<uint64_t> nsAgregacao{0};
+    std::array<std::atomic<uint64_t>, NUM_FAIXAS> histograma{};
+
+    // Min-heap das pastas mais lentas; "limiar" evita a trava para as demais
+    mutable std::mutex travaLentas;
+    std::vector<std::pair<uint64_t, std::string>> lentas;
+    std::atomic<uint64_t> limiar{0};
+};
+
+// ============================================================================
+// Função: imprimirInstrumentacao
+// Objetivo: Relatório final: divisão do tempo por fase, histograma da
+//           latência das pastas e as pastas mais lentas.
+// ============================================================================
+void imprimirInstrumentacao(const InstrumentacaoVarredura& instrumentacao, std::ostream& os);
+
+// ============================================================================
+// Função: escreverInstrumentacaoJson
+// Objetivo: Os mesmos dados como um objeto JSON (sem quebra de linha final):
+//           {"fases_ns":{...},"histograma_us":[{"de":..,"pastas":..}],
+//            "mais_lentas":[{"ns":..,"caminho":".."}]}
+// ============================================================================
+void escreverInstrumentacaoJson(const InstrumentacaoVarredura& instrumentacao,
+                                SaidaBufferizada& out);
+
+#endif // INSTRUMENTACAO_HPP
@@ -0,0 +1,544 @@
+// ============================================================================
+// Arquivo: leitor_diretorio.cpp
+// Finalidade: Implementa os backends de leitura de diretório (portável, POSIX e io_uring).
+// ============================================================================
+#include "leitor_diretorio.hpp"
+#include "anel_io_uring.hpp"
+#include "instrumentacao.hpp"   // Cronometro
+#include <atomic>
+#include <cerrno>
+#include <filesystem>
+#include <memory>
+#include <system_error>
+
+#ifdef __linux__
+#include <cstring>
+#include <fcntl.h>              // open, O_DIRECTORY, AT_SYMLINK_NOFOLLOW
+#include <sys/syscall.h>        // SYS_getdents64
+#include <sys/sysmacros.h>      // makedev (dispositivo do statx)
+#include <dirent.h>             // DT_DIR, DT_REG, ...
+#endif
+#include <sys/stat.h>           // stat, fstat, statx, fstatat
+#include <unistd.h>             // close, syscall
+
+namespace fs = std::filesystem;
+
+// ----------------------------------------------------------------------------
+// Combina inode, mtime e ctime (em nanossegundos) em 64 bits. A mistura segue
+// o "splitmix64"; o valor 0 fica reservado para "desconhecida".
+// ----------------------------------------------------------------------------
+static uint64_t misturar(uint64_t h, uint64_t valor) {
+    h ^= valor + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+    return h ^ (h >> 31);
+}
+
+static uint64_t assinaturaDe(const struct stat& st) {
+    uint64_t h = misturar(0, static_cast<uint64_t>(st.st_ino));
+    h = misturar(h, static_cast<uint64_t>(st.st_mtim.tv_sec) * 1000000000ull
+                    + static_cast<uint64_t>(st.st_mtim.tv_nsec));
+    h = misturar(h, static_cast<uint64_t>(st.st_ctim.tv_sec) * 1000000000ull
+                    + static_cast<uint64_t>(st.st_ctim.tv_nsec));
+    return h ? h : 1;
+}
+
+// ============================================================================
+// Caminhos
+// ============================================================================
+std::string juntarCaminho(const std::string& pasta, const std::string& nome) {
+    std::string caminho;
+    caminho.reserve(pasta.size() + 1 + nome.size());
+    caminho = pasta;
+    if (!caminho.empty() && caminho.back() != '/') caminho += '/';
+    caminho += nome;
+    return caminho;
+}
+
+// ============================================================================
+// Links físicos e bytes alocados
+// ============================================================================
+uint64_t chaveVinculo(uint64_t dispositivo, uint64_t inode) {
+    uint64_t h = misturar(misturar(0, dispositivo), inode);
+    return h ? h : 1;
+}
+
+MetadadosArquivo metadadosArquivo(const struct stat& st) {
+    MetadadosArquivo m;
+    m.tamanho = static_cast<uintmax_t>(st.st_size);
+    m.alocado = static_cast<uintmax_t>(st.st_blocks) * 512;   // st_blocks: unidades de 512
+    if (st.st_nlink > 1) {
+        m.vinculo = chaveVinculo(static_cast<uint64_t>(st.st_dev),
+                                 static_cast<uint64_t>(st.st_ino));
+    }
+    return m;
+}
+
+uint64_t lerAssinaturaPasta(const std::string& caminho, ContadoresLeitura& cont) {
+    struct stat st;
+    ++cont.chamadasMetadados;
+    if (::stat(caminho.c_str(), &st) != 0) return 0;
+    return assinaturaDe(st);
+}
+
+// ----------------------------------------------------------------------------
+// Guarda um erro da pasta (nome nulo) ou de uma de suas entradas. Entradas
+// que sumiram entre a listagem e a consulta não são erro: ficam fora da
+// árvore, como se tivessem sumido antes.
+// ----------------------------------------------------------------------------
+static void registrarErro(ContadoresLeitura& cont, const std::string& pasta,
+                          const char* nome, int codigo, OperacaoErro operacao) {
+    if (nome && codigo == ENOENT) return;
+    std::string caminho = pasta;
+    if (nome) {
+        if (!caminho.empty() && caminho.back() != '/') caminho += '/';
+        caminho += nome;
+    }
+    cont.erros.push_back({std::move(caminho), codigo, operacao});
+}
+
+// ----------------------------------------------------------------------------
+// Chamadas de leitura de diretório do std::filesystem (opendir/readdir/
+// closedir da glibc), que não são visíveis daqui. Estimativa: openat e fstat
+// no opendir, um getdents64 a cada 32 KiB de registros (o buffer do readdir)
+// mais o que devolve 0, e o close. O registro de cada entrada tem 19 bytes de
+// cabeçalho, o nome e o '\0', alinhados a 8; "." e ".." ocupam 24 cada.
+// ----------------------------------------------------------------------------
+static constexpr uint64_t BYTES_BUFFER_READDIR = 32 * 1024;
+
+static uint64_t bytesRegistro(size_t tamanhoNome) {
+    return (19 + tamanhoNome + 1 + 7) & ~uint64_t(7);
+}
+
+static uint64_t estimarChamadasDiretorio(uint64_t bytesRegistros) {
+    return 2 + (bytesRegistros + BYTES_BUFFER_READDIR - 1) / BYTES_BUFFER_READDIR + 1 + 1;
+}
+
+// ----------------------------------------------------------------------------
+// Backend portável: mesmas consultas por caminho da versão serial. Cada
+// consulta do std::filesystem abaixo resulta em uma chamada stat/lstat; o
+// tamanho vem de um stat (no lugar do fs::file_size), que também informa os
+// blocos alocados e o inode. Só as sobrecargas com std::error_code são
+// usadas: nenhuma falha vira exceção. As chamadas de leitura do diretório
+// são estimadas (veja estimarChamadasDiretorio).
+// ----------------------------------------------------------------------------
+static ResultadoLeitura listarPortavel(const std::string& caminho,
+                                       std::vector<EntradaLida>& saida,
+                                       ContadoresLeitura& cont,
+                                       uint64_t* assinatura,
+                                       const RestricoesLeitura& restricoes) {
+    if (restricoes.dispositivo != 0) {
+        struct stat st;
+        ++cont.chamadasMetadados;
+        if (::stat(caminho.c_str(), &st) == 0 &&
+            static_cast<uint64_t>(st.st_dev) != restricoes.dispositivo) {
+            return ResultadoLeitura::OutroDispositivo;
+        }
+    }
+    if (assinatura) *assinatura = lerAssinaturaPasta(caminho, cont);
+
+    std::error_code ec;
+    fs::directory_iterator it(caminho, ec);
+    if (ec) {
+        ++cont.chamadasDiretorio;                  // O openat que falhou
+        registrarErro(cont, caminho, nullptr, ec.value(), OperacaoErro::AbrirPasta);
+        if (assinatura) *assinatura = 0;
+        return ResultadoLeitura::Ilegivel;
+    }
+    uint64_t bytesRegistros = 2 * bytesRegistro(1);  // "." e ".."
+    for (fs::directory_iterator fim; it != fim; it.increment(ec)) {
+        const fs::path& p = it->path();
+        std::string nome = p.filename().string();
+        ++cont.entradas;
+        bytesRegistros += bytesRegistro(nome.size());
+        if (restricoes.exclusoes && restricoes.exclusoes->exclui(caminho, nome)) {
+            ++cont.excluidas;
+            continue;
+        }
+
+        // A primeira consulta que falhar descarta a entrada
+        Cronometro cronometro(restricoes.cronometrar, cont.nsMetadados);
+        std::error_code erro;
+        auto registrar = [&] {
+            registrarErro(cont, caminho, nome.c_str(), erro.value(), OperacaoErro::Metadados);
+        };
+        ++cont.chamadasMetadados;
+        if (!fs::exists(p, erro)) {
+            if (erro) registrar();
+            continue;
+        }
+        ++cont.chamadasMetadados;
+        bool simbolico = fs::is_symlink(p, erro);
+        if (erro) registrar();
+        if (erro || simbolico) continue;
+
+        ++cont.chamadasMetadados;
+        bool regular = fs::is_regular_file(p, erro);
+        if (erro) {
+            registrar();
+            continue;
+        }
+        if (regular) {
+            struct stat st;
+            ++cont.chamadasMetadados;
+            if (::stat(p.c_str(), &st) != 0) {
+                registrarErro(cont, caminho, nome.c_str(), errno, OperacaoErro::Metadados);
+                continue;
+            }
+            MetadadosArquivo m = metadadosArquivo(st);
+            saida.push_back({std::move(nome), false, m.tamanho, m.alocado, m.vinculo});
+            continue;
+        }
+        ++cont.chamadasMetadados;
+        bool pasta = fs::is_directory(p, erro);
+        if (erro) {
+            registrar();
+        } else if (pasta) {
+            saida.push_back({std::move(nome), true, 0});
+        }
+        // Outros tipos (dispositivos, sockets, etc.) são ignorados
+    }
+    cont.chamadasDiretorio += estimarChamadasDiretorio(bytesRegistros);
+    if (ec) {
+        registrarErro(cont, caminho, nullptr, ec.value(), OperacaoErro::LerPasta);
+        if (assinatura) *assinatura = 0;
+    }
+    return ResultadoLeitura::Lida;
+}
+
+// io_uring desligado para todo o processo: o kernel não o oferece (ENOSYS,
+// EPERM) ou um anel ficou com pedidos sem resposta (veja consultarEmLote)
+static std::atomic<bool> anelIndisponivel{false};
+
+#ifdef __linux__
+
+// Registro devolvido pelo getdents64 (não exposto pela glibc)
+struct linux_dirent64 {
+    uint64_t       d_ino;
+    int64_t        d_off;
+    unsigned short d_reclen;
+    unsigned char  d_type;
+    char           d_name[];
+};
+
+// Metadados de um arquivo a partir do statx (mesmo conteúdo de metadadosArquivo)
+static MetadadosArquivo metadadosStatx(const struct statx& stx) {
+    MetadadosArquivo m;
+    m.tamanho = stx.stx_size;
+    m.alocado = static_cast<uintmax_t>(stx.stx_blocks) * 512;
+    if (stx.stx_nlink > 1) {
+        m.vinculo = chaveVinculo(makedev(stx.stx_dev_major, stx.stx_dev_minor), stx.stx_ino);
+    }
+    return m;
+}
+
+static constexpr unsigned MASCARA_STATX =
+    STATX_TYPE | STATX_SIZE | STATX_BLOCKS | STATX_NLINK | STATX_INO;
+
+// ----------------------------------------------------------------------------
+// Obtém tipo, tamanhos e inode de "nome" com uma única chamada relativa a
+// dirfd, sem seguir links simbólicos. Usa statx e, se o kernel não o
+// suportar, fstatat. Retorna false se a entrada sumiu ou não pôde ser
+// consultada.
+// ----------------------------------------------------------------------------
+static bool consultarMetadados(int dirfd, const char* nome,
+                               mode_t& modo, MetadadosArquivo& meta,
+                               ContadoresLeitura& cont) {
+    static std::atomic<bool> semStatx{false};  // Kernel antigo: usa direto o fstatat
+
+    if (!semStatx.load(std::memory_order_relaxed)) {
+        struct statx stx;
+        ++cont.chamadasMetadados;
+        if (statx(dirfd, nome, AT_SYMLINK_NOFOLLOW, MASCARA_STATX, &stx) == 0) {
+            modo = stx.stx_mode;
+            meta = metadadosStatx(stx);
+            return true;
+        }
+        if (errno != ENOSYS) return false;
+        semStatx.store(true, std::memory_order_relaxed);
+    }
+
+    struct stat st;
+    ++cont.chamadasMetadados;
+    if (fstatat(dirfd, nome, &st, AT_SYMLINK_NOFOLLOW) != 0) return false;
+    modo = st.st_mode;
+    meta = metadadosArquivo(st);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// io_uring: cada thread da varredura tem o seu anel, criado no primeiro uso.
+// Uma falha do io_uring_enter inutiliza o anel da thread, que passa a usar o
+// backend portável. Se nem a espera pelas respostas funcionar, o io_uring
+// deixa de ser usado por todas as threads (anelIndisponivel).
+// ----------------------------------------------------------------------------
+static thread_local bool anelInutilizado = false;
+
+static AnelIoUring* anelDaThread(unsigned profundidade) {
+    thread_local AnelIoUring anel;
+    thread_local bool tentou = false;
+    if (anelInutilizado || anelIndisponivel.load(std::memory_order_relaxed)) return nullptr;
+    if (!tentou) {
+        tentou = true;
+        int erro = 0;
+        if (!anel.abrir(profundidade ? profundidade : 256, &erro)) {
+            if (erro == ENOSYS || erro == EPERM) anelIndisponivel = true;
+            return nullptr;
+        }
+    }
+    return anel.aberto() ? &anel : nullptr;
+}
+
+// Entrada cujo statx foi adiado para o lote
+struct StatxPendente {
+    size_t indice;              // Posição em "saida"
+    bool tipoDesconhecido;      // DT_UNKNOWN: o tipo também vem do statx
+};
+
+// ----------------------------------------------------------------------------
+// Envia os statx pendentes mantendo até capacidade() em voo e aplica as
+// respostas em "saida" (preenche tamanhos, resolve DT_UNKNOWN e descarta o
+// que sumiu ou não é arquivo/pasta), preservando a ordem de leitura.
+// Respostas com erro diferente de ENOENT (ex.: kernel sem IORING_OP_STATX)
+// são refeitas com a chamada síncrona, assim como os pedidos sem resposta
+// quando o io_uring_enter falha. Os pedidos apontam para uma cópia dos nomes
+// (não para as strings de "saida", que o chamador move depois), e a cópia
+// tem o mesmo destino dos resultados.
+// ----------------------------------------------------------------------------
+static void consultarEmLote(AnelIoUring& anel, int fd, const std::string& caminho,
+                            std::vector<EntradaLida>& saida,
+                            const std::vector<StatxPendente>& pendentes,
+                            ContadoresLeitura& cont) {
+    size_t n = pendentes.size();
+    std::unique_ptr<struct statx[]> resultados(new struct statx[n]);
+    std::vector<int> codigos(n, 0);
+    std::vector<char> respondido(n, 0);
+    struct statx* dados = resultados.get();
+
+    // Nomes terminados em '\0', lado a lado em um único bloco
+    std::vector<size_t> inicioNome(n);
+    size_t bytesNomes = 0;
+    for (size_t k = 0; k < n; ++k) {
+        inicioNome[k] = bytesNomes;
+        bytesNomes += saida[pendentes[k].indice].nome.size() + 1;
+    }
+    std::unique_ptr<char[]> nomes(new char[bytesNomes]);
+    for (size_t k = 0; k < n; ++k) {
+        const std::string& nome = saida[pendentes[k].indice].nome;
+        std::memcpy(&nomes[inicioNome[k]], nome.c_str(), nome.size() + 1);
+    }
+
+    size_t proximo = 0, concluidos = 0, emVoo = 0;
+    auto registrar = [&](uint64_t k, int res) {
+        codigos[k] = res;
+        respondido[k] = 1;
+        ++concluidos;
+        --emVoo;
+    };
+    while (concluidos < proximo || proximo < n) {
+        while (proximo < n && emVoo < anel.capacidade() &&
+               anel.prepararStatx(fd, &nomes[inicioNome[proximo]],
+                                  AT_SYMLINK_NOFOLLOW, MASCARA_STATX, &dados[proximo], proximo)) {
+            ++proximo;
+            ++emVoo;
+        }
+        ++cont.chamadasAnel;
+        if (anel.enviar(1) < 0) {
+            // Os pedidos já entregues ainda escrevem nos resultados e leem os
+            // nomes: as respostas deles são recolhidas antes de sair, e o anel
+            // é desfeito com os que não foram entregues. Só se nem a espera
+            // funcionar os dois blocos são abandonados (o kernel ainda pode
+            // usá-los), e o io_uring deixa de ser usado no processo.
+            size_t entregues = emVoo - anel.naoEnviados();
+            while (entregues > 0) {
+                ++cont.chamadasAnel;
+                if (anel.esperarConclusoes(1) < 0) {
+                    resultados.release();
+                    nomes.release();
+                    anelIndisponivel = true;
+                    break;
+                }
+                entregues -= anel.colher(registrar);
+            }
+            anelInutilizado = true;
+            anel.fechar();
+            break;
+        }
+        anel.colher(registrar);
+    }
+    cont.metadadosEmLote += proximo;
+
+    std::vector<char> descartar(saida.size(), 0);
+    for (size_t k = 0; k < n; ++k) {
+        EntradaLida& e = saida[pendentes[k].indice];
+        mode_t modo = 0;
+        MetadadosArquivo m;
+        bool ok = false;
+        if (respondido[k] && codigos[k] == 0) {
+            modo = dados[k].stx_mode;
+            m = metadadosStatx(dados[k]);
+            ok = true;
+        } else if (!respondido[k] || codigos[k] != -ENOENT) {
+            if (codigos[k] == -EINVAL) anelInutilizado = true;
+            ok = consultarMetadados(fd, e.nome.c_str(), modo, m, cont);
+            if (!ok) registrarErro(cont, caminho, e.nome.c_str(), errno, OperacaoErro::Metadados);
+        }
+
+        if (ok && S_ISREG(modo)) {
+            e.tamanho = m.tamanho;
+            e.alocado = m.alocado;
+            e.vinculo = m.vinculo;
+        } else if (ok && S_ISDIR(modo) && pendentes[k].tipoDesconhecido) {
+            e.pasta = true;
+        } else {
+            descartar[pendentes[k].indice] = 1;
+        }
+    }
+
+    size_t destino = pendentes.front().indice;
+    for (size_t i = destino; i < saida.size(); ++i) {
+        if (descartar[i]) continue;
+        if (i != destino) saida[destino] = std::move(saida[i]);
+        ++destino;
+    }
+    saida.resize(destino);
+}
+
+// ----------------------------------------------------------------------------
+// Backend POSIX: lê o diretório em blocos com getdents64. O d_type já informa
+// se a entrada é pasta, arquivo ou link, então pastas e links não custam
+// nenhuma chamada extra; arquivos custam um statx (para o tamanho). Somente
+// quando o sistema de arquivos não preenche d_type (DT_UNKNOWN) o tipo vem
+// do statx. Entradas excluídas são descartadas só pelo nome, sem statx.
+// Com um anel io_uring, os statx não são feitos durante a leitura: ficam
+// pendentes e são enviados em lote antes de fechar a pasta.
+// ----------------------------------------------------------------------------
+static ResultadoLeitura listarPosix(const std::string& caminho,
+                                    std::vector<EntradaLida>& saida,
+                                    ContadoresLeitura& cont,
+                                    uint64_t* assinatura,
+                                    const RestricoesLeitura& restricoes,
+                                    AnelIoUring* anel = nullptr) {
+    ++cont.chamadasDiretorio;
+    int fd = ::open(caminho.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        registrarErro(cont, caminho, nullptr, errno, OperacaoErro::AbrirPasta);
+        if (assinatura) *assinatura = 0;
+        return ResultadoLeitura::Ilegivel;
+    }
+    // Um único fstat serve à assinatura e à conferência do dispositivo
+    if (assinatura || restricoes.dispositivo != 0) {
+        struct stat st;
+        ++cont.chamadasMetadados;
+        bool ok = ::fstat(fd, &st) == 0;
+        if (ok && restricoes.dispositivo != 0 &&
+            static_cast<uint64_t>(st.st_dev) != restricoes.dispositivo) {
+            ++cont.chamadasDiretorio;
+            ::close(fd);
+            return ResultadoLeitura::OutroDispositivo;
+        }
+        if (assinatura) *assinatura = ok ? assinaturaDe(st) : 0;
+    }
+
+    std::vector<StatxPendente> pendentes;
+    alignas(linux_dirent64) char buffer[64 * 1024];
+    while (true) {
+        ++cont.chamadasDiretorio;
+        long lidos = ::syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+        if (lidos < 0) {
+            // Fica o que já foi lido; a pasta será relida na próxima atualização
+            registrarErro(cont, caminho, nullptr, errno, OperacaoErro::LerPasta);
+            if (assinatura) *assinatura = 0;
+            break;
+        }
+        if (lidos == 0) break;
+
+        for (long pos = 0; pos < lidos; ) {
+            auto* d = reinterpret_cast<linux_dirent64*>(buffer + pos);
+            pos += d->d_reclen;
+
+            const char* nome = d->d_name;
+            if (nome[0] == '.' && (nome[1] == '\0' || (nome[1] == '.' && nome[2] == '\0')))
+                continue;
+            ++cont.entradas;
+            if (restricoes.exclusoes && restricoes.exclusoes->exclui(caminho, nome)) {
+                ++cont.excluidas;
+                continue;
+            }
+            if (anel && (d->d_type == DT_REG || d->d_type == DT_UNKNOWN)) {
+                pendentes.push_back({saida.size(), d->d_type == DT_UNKNOWN});
+                saida.push_back({nome, false, 0});
+                continue;
+            }
+
+            switch (d->d_type) {
+                case DT_DIR:
+                    saida.push_back({nome, true, 0});
+                    break;
+                case DT_REG: {
+                    Cronometro cronometro(restricoes.cronometrar, cont.nsMetadados);
+                    mode_t modo;
+                    MetadadosArquivo m;
+                    if (!consultarMetadados(fd, nome, modo, m, cont)) {
+                        registrarErro(cont, caminho, nome, errno, OperacaoErro::Metadados);
+                    } else if (S_ISREG(modo)) {
+                        saida.push_back({nome, false, m.tamanho, m.alocado, m.vinculo});
+                    }
+                    break;
+                }
+                case DT_UNKNOWN: {
+                    Cronometro cronometro(restricoes.cronometrar, cont.nsMetadados);
+                    mode_t modo;
+                    MetadadosArquivo m;
+                    if (!consultarMetadados(fd, nome, modo, m, cont)) {
+                        registrarErro(cont, caminho, nome, errno, OperacaoErro::Metadados);
+                        break;
+                    }
+                    if (S_ISREG(modo))      saida.push_back({nome, false, m.tamanho, m.alocado, m.vinculo});
+                    else if (S_ISDIR(modo)) saida.push_back({nome, true, 0});
+                    break;
+                }
+                default:
+                    break;   // Links simbólicos, dispositivos, sockets, etc.
+            }
+        }
+    }
+    if (!pendentes.empty()) {
+        Cronometro cronometro(restricoes.cronometrar, cont.nsMetadados);
+        consultarEmLote(*anel, fd, caminho, saida, pendentes, cont);
+    }
+    ++cont.chamadasDiretorio;
+    ::close(fd);
+    return ResultadoLeitura::Lida;
+}
+
+#endif // __linux__
+
+bool ioUringDisponivel() {
+    static const bool disponivel = [] {
+        AnelIoUring teste;
+        return teste.abrir(4);
+    }();
+    return disponivel && !anelIndisponivel.load(std::memory_order_relaxed);
+}
+
+// ============================================================================
+// Função: listarDiretorio
+// ============================================================================
+ResultadoLeitura listarDiretorio(BackendVarredura backend, const std::string& caminho,
+                                 std::vector<EntradaLida>& saida, ContadoresLeitura& cont,
+                                 uint64_t* assinatura, const RestricoesLeitura* restricoes) {
+    static const RestricoesLeitura semRestricoes;
+    const RestricoesLeitura& r = restricoes ? *restricoes : semRestricoes;
+#ifdef __linux__
+    if (backend == BackendVarredura::Posix) {
+        return listarPosix(caminho, saida, cont, assinatura, r);
+    }
+    if (backend == BackendVarredura::IoUring) {
+        if (AnelIoUring* anel = anelDaThread(r.profundidadeFila)) {
+            return listarPosix(caminho, saida, cont, assinatura, r, anel);
+        }
+    }
+#endif
+    return listarPortavel(caminho, saida, cont, assinatura, r);
+}
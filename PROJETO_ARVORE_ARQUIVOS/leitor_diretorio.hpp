@@ -0,0 +1,130 @@
+// ============================================================================
+// Arquivo: leitor_diretorio.hpp
+// Finalidade: Declarar os "backends" de leitura de diretório usados pela
+//             varredura. Cada backend lista as entradas de uma pasta e devolve
+//             tipo e tamanho de cada uma, contando as chamadas de sistema feitas.
+// ============================================================================
+#ifndef LEITOR_DIRETORIO_HPP
+#define LEITOR_DIRETORIO_HPP
+
+#include <cstdint>                    // uint64_t
+#include <string>                     // Nomes e caminhos
+#include <vector>                     // Lista de entradas lidas
+#include <sys/stat.h>                 // struct stat
+#include "exclusao.hpp"               // PadroesExclusao
+#include "erros_varredura.hpp"        // ErroLeitura
+
+// ============================================================================
+// Enumeração: BackendVarredura
+// Objetivo: Escolher como os metadados são obtidos.
+//   - Portavel: std::filesystem, com as mesmas consultas por caminho da versão
+//               serial (exists, is_symlink, is_regular_file, ...).
+//   - Posix:    getdents64 + d_type para o tipo e um único statx (ou fstatat)
+//               relativo ao descritor da pasta, só quando o tamanho é preciso.
+//   - IoUring:  como o Posix, mas os statx de uma pasta são enviados em lote
+//               por um anel io_uring da thread, com vários pedidos em voo.
+//               Sem io_uring, usa o Portavel (a árvore é a mesma).
+// ============================================================================
+enum class BackendVarredura { Portavel, Posix, IoUring };
+
+// O io_uring pode ser usado neste processo? (testado uma vez)
+bool ioUringDisponivel();
+
+// ============================================================================
+// Estrutura: EntradaLida
+// Objetivo: Resultado da leitura de uma entrada (já filtrada: somente arquivos
+//           comuns e pastas, sem links simbólicos).
+// ============================================================================
+struct EntradaLida {
+    std::string nome;     // Nome simples da entrada
+    bool pasta;           // true = diretório, false = arquivo comum
+    uintmax_t tamanho;    // Tamanho aparente em bytes (0 para pastas)
+    uintmax_t alocado = 0;  // Bytes ocupados no disco (0 para pastas)
+    uint64_t vinculo = 0;   // Chave do inode, se houver mais de um link físico
+};
+
+// ============================================================================
+// Estrutura: MetadadosArquivo
+// Objetivo: O que a varredura guarda de um arquivo comum: tamanho aparente,
+//           bytes alocados (st_blocks * 512) e, para arquivos com mais de um
+//           link físico, a chave (dispositivo, inode) combinada em 64 bits.
+// ============================================================================
+struct MetadadosArquivo {
+    uintmax_t tamanho = 0;
+    uintmax_t alocado = 0;
+    uint64_t vinculo = 0;
+};
+
+// Extrai os metadados de um stat (usado também pelo observador)
+MetadadosArquivo metadadosArquivo(const struct stat& st);
+
+// Chave de (dispositivo, inode) para a deduplicação de links físicos (nunca 0)
+uint64_t chaveVinculo(uint64_t dispositivo, uint64_t inode);
+
+// Junta pasta e nome como o operador "/" de std::filesystem::path faria (sem
+// separador duplicado quando a pasta já termina em '/'); usada pela
+// varredura, pelo observador e pela navegação para montar Nodo::caminho
+std::string juntarCaminho(const std::string& pasta, const std::string& nome);
+
+// ============================================================================
+// Estrutura: ContadoresLeitura
+// Objetivo: Contadores locais de uma leitura (somados depois à estatística
+//           global, evitando operações atômicas por entrada), junto com os
+//           erros encontrados (anexados depois à tabela de erros).
+// ============================================================================
+struct ContadoresLeitura {
+    uint64_t entradas = 0;           // Entradas encontradas no diretório
+    uint64_t chamadasMetadados = 0;  // stat/lstat/statx/fstatat
+    uint64_t chamadasDiretorio = 0;  // open/getdents64/close (estimadas no Portavel)
+    uint64_t excluidas = 0;          // Entradas descartadas pelos padrões de exclusão
+    uint64_t metadadosEmLote = 0;    // statx enviados pelo io_uring (não são chamadas)
+    uint64_t chamadasAnel = 0;       // io_uring_enter (entrega dos statx em lote)
+    uint64_t nsMetadados = 0;        // Tempo em stat/statx (só com RestricoesLeitura::cronometrar)
+    std::vector<ErroLeitura> erros;  // Falhas desta leitura (entradas que sumiram não contam)
+};
+
+// ============================================================================
+// Estrutura: RestricoesLeitura
+// Objetivo: Limites aplicados durante a própria leitura, antes de qualquer
+//           consulta de metadados da entrada, e o ajuste do io_uring.
+// ============================================================================
+struct RestricoesLeitura {
+    const PadroesExclusao* exclusoes = nullptr;  // Entradas a ignorar (pode ser nulo)
+    uint64_t dispositivo = 0;   // Diferente de 0: só lê pastas desse st_dev
+    unsigned profundidadeFila = 256;  // IoUring: statx em voo por thread (limitado à pasta)
+    bool cronometrar = false;   // Mede o tempo das consultas de metadados (instrumentação)
+};
+
+// Resultado de listarDiretorio
+enum class ResultadoLeitura {
+    Lida,               // Entradas lidas (talvez só parte delas; veja cont.erros)
+    OutroDispositivo,   // Pasta em outro sistema de arquivos: nada é lido
+    Ilegivel            // A pasta não pôde ser aberta
+};
+
+// ============================================================================
+// Função: listarDiretorio
+// Objetivo: Ler as entradas de "caminho" com o backend escolhido.
+// Entrada: backend, caminho da pasta, vetor de saída (anexado), contadores e,
+//          opcionalmente, onde guardar a assinatura da própria pasta (lida
+//          antes das entradas, para que uma alteração concorrente nunca passe
+//          despercebida na próxima atualização incremental) e as restrições
+// Erros:   Nenhuma exceção: cada falha vai para cont.erros e a leitura segue
+//          com o que for possível. Se a listagem ficou incompleta, a
+//          assinatura é 0 (a pasta será relida na próxima atualização).
+// ============================================================================
+ResultadoLeitura listarDiretorio(BackendVarredura backend, const std::string& caminho,
+                                 std::vector<EntradaLida>& saida, ContadoresLeitura& cont,
+                                 uint64_t* assinatura = nullptr,
+                                 const RestricoesLeitura* restricoes = nullptr);
+
+// ============================================================================
+// Função: lerAssinaturaPasta
+// Objetivo: Obter a assinatura de uma pasta (inode, mtime e ctime combinados)
+//           com uma única chamada stat. Qualquer criação, remoção ou
+//           renomeação de entradas na pasta altera a assinatura.
+// Retorno: Assinatura (nunca 0) ou 0 se a pasta não pôde ser consultada
+// ============================================================================
+uint64_t lerAssinaturaPasta(const std::string& caminho, ContadoresLeitura& cont);
+
+#endif // LEITOR_DIRETORIO_HPP
@@ -0,0 +1,172 @@
+// ============================================================================
+// Arquivo: lote.cpp
+// Finalidade: Implementa o modo em lote sobre os índices das pesquisas e a
+//             camada de serialização.
+// ============================================================================
+#include "lote.hpp"
+#include "indices.hpp"
+#include "duplicados.hpp"
+#include "estatisticas_arvore.hpp"
+#include "saida_bufferizada.hpp"
+#include <charconv>
+#include <iostream>
+#include <string_view>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+// Número sem sinal ocupando todo o texto (sem sinal, espaços ou sufixos)
+// ----------------------------------------------------------------------------
+static bool lerNumero(std::string_view texto, uintmax_t& valor) {
+    const char* fim = texto.data() + texto.size();
+    auto [p, ec] = std::from_chars(texto.data(), fim, valor);
+    return ec == std::errc() && p == fim && !texto.empty();
+}
+
+// ============================================================================
+// Função: lerOpcaoLote
+// ============================================================================
+LeituraOpcao lerOpcaoLote(int argc, char* argv[], int& i, std::vector<AcaoLote>& acoes) {
+    std::string_view arg = argv[i];
+    bool temValor = i + 1 < argc;
+
+    if (arg == "--maior") {
+        acoes.push_back({ConsultaLote::Maior});
+    } else if (arg == "--pastas-vazias") {
+        acoes.push_back({ConsultaLote::PastasVazias});
+    } else if (arg == "--mais-filhos") {
+        acoes.push_back({ConsultaLote::MaisFilhos});
+    } else if (arg == "--duplicados") {
+        acoes.push_back({ConsultaLote::Duplicados});
+    } else if ((arg == "--maiores" || arg == "--maior-que") && temValor) {
+        AcaoLote acao{arg == "--maiores" ? ConsultaLote::Maiores : ConsultaLote::MaiorQue};
+        if (!lerNumero(argv[i + 1], acao.numero)) {
+            std::cerr << "[ERRO] Número inválido para " << arg << ": " << argv[i + 1] << std::endl;
+            return LeituraOpcao::Invalida;
+        }
+        acoes.push_back(std::move(acao));
+        i += 1;
+    } else if (arg == "--extensao" && temValor) {
+        // "txt" e ".txt" são a mesma extensão
+        AcaoLote acao{ConsultaLote::Extensao};
+        acao.texto = argv[++i];
+        if (!acao.texto.empty() && acao.texto[0] != '.') acao.texto.insert(0, 1, '.');
+        acoes.push_back(std::move(acao));
+    } else if (arg == "--filtro" && temValor) {
+        // A expressão é conferida aqui, antes de qualquer varredura
+        AcaoLote acao{ConsultaLote::Filtro};
+        acao.texto = argv[++i];
+        Filtro filtro;
+        std::string erro;
+        if (!filtro.compilar(acao.texto, &erro)) {
+            std::cerr << "[ERRO] Filtro inválido: " << erro << std::endl;
+            return LeituraOpcao::Invalida;
+        }
+        acoes.push_back(std::move(acao));
+    } else if ((arg == "--exportar" || arg == "--resumo") && i + 2 < argc) {
+        AcaoLote acao{arg == "--exportar" ? ConsultaLote::Exportar : ConsultaLote::Resumo};
+        if (!formatoPorNome(argv[i + 1], acao.formato)) {
+            std::cerr << "[ERRO] Formato desconhecido: " << argv[i + 1] << std::endl;
+            return LeituraOpcao::Invalida;
+        }
+        if (acao.consulta == ConsultaLote::Resumo && acao.formato == FormatoSaida::Colunar) {
+            std::cerr << "[ERRO] O formato colunar não se aplica às estatísticas" << std::endl;
+            return LeituraOpcao::Invalida;
+        }
+        acao.texto = argv[i + 2];
+        acoes.push_back(std::move(acao));
+        i += 2;
+    } else {
+        return LeituraOpcao::NaoReconhecida;
+    }
+    return LeituraOpcao::Lida;
+}
+
+// Uma linha de resultado: consulta, valor e caminho separados por TAB (o
+// caminho escapado: um nome com TAB ou quebra de linha não divide o registro)
+static void escreverLinha(SaidaBufferizada& out, std::string_view consulta,
+                          uintmax_t valor, std::string_view caminho) {
+    out.escrever(consulta);
+    out.escrever('\t');
+    out.escreverNumero(valor);
+    out.escrever('\t');
+    out.escreverCampo(caminho);
+    out.escrever('\n');
+}
+
+static void escreverFaixa(SaidaBufferizada& out, std::string_view consulta, FaixaIndice faixa) {
+    for (const auto& e : faixa) escreverLinha(out, consulta, e.tamanho, e.caminho);
+}
+
+// ============================================================================
+// Função: executarLote
+// ============================================================================
+int executarLote(const Percurso& percorrer, const std::vector<AcaoLote>& acoes,
+                 PercursoParalelo paralelo) {
+    IndicesPesquisa indices(percorrer, {}, std::move(paralelo));
+    std::cout.flush();                 // Mensagens anteriores vêm antes
+    SaidaBufferizada out(1);
+    int codigo = 0;
+
+    for (const auto& acao : acoes) {
+        switch (acao.consulta) {
+            case ConsultaLote::Maior:
+                escreverFaixa(out, "maior", indices.maioresArquivos());
+                break;
+            case ConsultaLote::Maiores:
+                escreverFaixa(out, "maiores", indices.maioresArquivos(acao.numero));
+                break;
+            case ConsultaLote::MaiorQue:
+                escreverFaixa(out, "maior-que", indices.arquivosMaioresQue(acao.numero));
+                break;
+            case ConsultaLote::Extensao:
+                escreverFaixa(out, "extensao", indices.arquivosPorExtensao(acao.texto));
+                break;
+            case ConsultaLote::PastasVazias:
+                escreverFaixa(out, "pastas-vazias", indices.pastasVazias());
+                break;
+            case ConsultaLote::MaisFilhos: {
+                size_t filhos = 0;
+                for (const auto& p : indices.pastasComMaisFilhos(filhos)) {
+                    escreverLinha(out, "mais-filhos", filhos, p.caminho);
+                }
+                break;
+            }
+            case ConsultaLote::Duplicados:
+                for (const auto& g : indices.duplicados()) {
+                    out.escrever("duplicados\t");
+                    out.escreverNumero(g.desperdicio());
+                    for (const auto& caminho : g.caminhos) {
+                        out.escrever('\t');
+                        out.escreverCampo(caminho);
+                    }
+                    out.escrever('\n');
+                }
+                break;
+            case ConsultaLote::Filtro: {
+                Filtro filtro;
+                filtro.compilar(acao.texto);
+                escreverFaixa(out, "filtro", indices.filtrar(filtro));
+                break;
+            }
+            case ConsultaLote::Exportar:
+                // A exportação escreve por conta própria: o que está no
+                // buffer precisa sair antes
+                out.descarregar();
+                if (!exportarArvore(percorrer, acao.formato, acao.texto)) codigo = 1;
+                break;
+            case ConsultaLote::Resumo:
+                out.descarregar();
+                if (!exportarEstatisticasArvore(indices.estatisticas(), acao.formato, acao.texto)) {
+                    codigo = 1;
+                }
+                break;
+        }
+    }
+
+    std::string erro;
+    if (!out.fechar(&erro)) {
+        std::cerr << "[ERRO] Falha ao escrever na saída padrão: " << erro << "\n";
+        codigo = 1;
+    }
+    return codigo;
+}
@@ -0,0 +1,102 @@
+// ============================================================================
+// Arquivo: lote.hpp
+// Finalidade: Declarar o modo em lote: consultas e exportações pedidas na
+//             linha de comando, executadas em sequência sobre uma única
+//             varredura, com os resultados enviados à saída padrão e sem
+//             nenhum menu.
+// ============================================================================
+#ifndef LOTE_HPP
+#define LOTE_HPP
+
+#include <charconv>                   // std::from_chars
+#include <cstdint>                    // uintmax_t
+#include <iostream>                   // Aviso de valor inválido
+#include <string>                     // Extensão, arquivo de exportação
+#include <string_view>                // Texto da opção
+#include <vector>                     // Lista de ações
+#include "percurso.hpp"               // Percurso
+#include "serializadores.hpp"         // FormatoSaida
+
+// ============================================================================
+// Enumeração: ConsultaLote (uma por opção da linha de comando)
+//   - Maior:        "--maior"            arquivo(s) de tamanho máximo
+//   - Maiores:      "--maiores K"        os K maiores arquivos
+//   - MaiorQue:     "--maior-que N"      arquivos com mais de N bytes
+//   - Extensao:     "--extensao EXT"     arquivos com a extensão EXT
+//   - PastasVazias: "--pastas-vazias"    pastas sem filhos
+//   - MaisFilhos:   "--mais-filhos"      pasta(s) com mais filhos diretos
+//   - Duplicados:   "--duplicados"       grupos de arquivos de mesmo conteúdo
+//   - Filtro:       "--filtro EXPR"      nós que satisfazem a expressão (filtro.hpp)
+//   - Exportar:     "--exportar FMT ARQ" árvore inteira no formato FMT
+//   - Resumo:       "--resumo FMT ARQ"   resumo estatístico da árvore
+//                                        (estatisticas_arvore.hpp; FMT não
+//                                        pode ser colunar)
+// ============================================================================
+enum class ConsultaLote {
+    Maior, Maiores, MaiorQue, Extensao, PastasVazias, MaisFilhos, Duplicados, Filtro, Exportar,
+    Resumo
+};
+
+// ============================================================================
+// Estrutura: AcaoLote
+// ============================================================================
+struct AcaoLote {
+    ConsultaLote consulta;
+    uintmax_t numero = 0;                           // K ou N
+    std::string texto;                              // Extensão, filtro ou arquivo
+    FormatoSaida formato = FormatoSaida::Terminal;  // Exportar e Resumo
+};
+
+// Resultado de lerOpcaoLote
+enum class LeituraOpcao { NaoReconhecida, Lida, Invalida };
+
+// ============================================================================
+// Função: lerValorOpcao
+// Objetivo: Ler o valor numérico de uma opção da linha de comando (usada
+//           pelo programa e pelo benchmark). O texto inteiro precisa ser o
+//           número, dentro do intervalo do tipo; "minimo" recusa os valores
+//           abaixo dele.
+// Retorno: false em caso de erro (a mensagem já foi exibida em std::cerr)
+// ============================================================================
+template <typename T>
+bool lerValorOpcao(const std::string& opcao, std::string_view texto, T& valor,
+                   T minimo = T()) {
+    const char* fim = texto.data() + texto.size();
+    T lido{};
+    auto [p, ec] = std::from_chars(texto.data(), fim, lido);
+    if (ec != std::errc() || p != fim || texto.empty() || lido < minimo) {
+        std::cerr << "[ERRO] valor inválido para " << opcao << ": " << texto << std::endl;
+        return false;
+    }
+    valor = lido;
+    return true;
+}
+
+// ============================================================================
+// Função: lerOpcaoLote
+// Objetivo: Reconhecer em argv[i] uma opção do modo em lote e anexá-la a
+//           "acoes"; "i" avança sobre os argumentos consumidos.
+// Retorno: Invalida se a opção for do lote mas o argumento estiver errado
+//          (a mensagem já foi exibida em std::cerr)
+// ============================================================================
+LeituraOpcao lerOpcaoLote(int argc, char* argv[], int& i, std::vector<AcaoLote>& acoes);
+
+// ============================================================================
+// Função: executarLote
+// Objetivo: Executar as ações na ordem pedida, todas sobre os mesmos índices
+//           (cada índice é montado uma vez, na primeira consulta que o usa).
+//           Cada resultado é uma linha "consulta<TAB>valor<TAB>caminho" na
+//           saída padrão, onde valor é o tamanho em bytes (em "mais-filhos",
+//           o número de filhos). Em "duplicados", cada grupo é uma linha com
+//           os bytes desperdiçados seguidos de todos os caminhos do grupo,
+//           separados por TAB. Nos caminhos, TAB, quebras de linha e '\'
+//           saem escapados (SaidaBufferizada::escreverCampo). Exportações e
+//           resumos para "-" saem no mesmo fluxo, na posição em que foram
+//           pedidas. Com "paralelo", os índices, os filtros e o resumo são
+//           montados por todos os núcleos.
+// Retorno: Código de saída do programa (1 se alguma exportação falhou)
+// ============================================================================
+int executarLote(const Percurso& percorrer, const std::vector<AcaoLote>& acoes,
+                 PercursoParalelo paralelo = {});
+
+#endif // LOTE_HPP
@@ -6,21 +6,192 @@
 
 #include <iostream>            // std::cout, std::cerr, std::endl
 #include <filesystem>          // std::filesystem::path, exists, is_directory, current_path
+#include <string>              // std::string
+#include <string_view>         // Texto dos valores numéricos
+#include <vector>              // Ações do modo em lote
 #include "nodo.hpp"            // Estrutura Nodo (caminho, nome, tipo, tamanho, filhos)
 #include "arvore.hpp"          // construirArvore(), exibirArvore()
+#include "varredura.hpp"       // construirArvore() com OpcoesVarredura
+#include "arvore_compacta.hpp" // ArvoreCompacta, imprimirRelatorioMemoria()
+#include "snapshot.hpp"        // salvarSnapshot(), carregarSnapshot()
+#include "observador.hpp"      // ObservadorArvore (modo observador)
+#include "lote.hpp"            // Consultas e exportações sem menu
+#include "comparacao.hpp"      // executarComparacao()
+#include "navegacao.hpp"       // ArvorePreguicosa, navegarArvore()
 #include "menu.hpp"            // menuInterativo()
 
 namespace fs = std::filesystem; // Alias para facilitar o uso de filesystem
 
 int main(int argc, char* argv[]) {
     // ------------------------------------------------------------------------
-    // 1) Definir o diretório a ser carregado:
-    //    - Usa argv[1] se fornecido.
-    //    - Caso contrário, usa o diretório de trabalho atual + "esquema de pastas".
+    // 1) Ler as opções e definir o diretório a ser carregado:
+    //    - "--threads N" escolhe quantas threads fazem a varredura
+    //      (1 = serial, que é o padrão; 0 = todos os núcleos).
+    //    - "--backend posix|portavel|io_uring" escolhe como os metadados são
+    //      lidos; "--fila N" é quantos statx cada thread mantém em voo no
+    //      io_uring (sem io_uring, usa o portável).
+    //    - "--estatisticas" mostra entradas e chamadas de sistema por entrada.
+    //    - Acompanhamento da varredura: "--progresso S" escreve o progresso em
+    //      stderr a cada S segundos; "--instrumentar" mostra, ao final, o
+    //      tempo de cada fase, o histograma de latência das pastas e as mais
+    //      lentas; "--relatorio-json ARQ" grava tudo isso em JSON ("-" =
+    //      saída padrão).
+    //    - Limites da varredura: "--um-sistema" não entra em outros sistemas
+    //      de arquivos; "--excluir PADRAO" (repetível) ignora as entradas que
+    //      casam com o glob; "--profundidade N" não lê as pastas do nível N
+    //      (a raiz é o nível 0), e "--somar-podadas" soma o tamanho delas.
+    //    - "--compacta" converte a árvore para a representação compacta e
+    //      usa essa versão no menu (a árvore de Nodo é liberada durante a
+    //      conversão, nó a nó).
+    //    - "--relatorio-memoria" compara os bytes por nó das duas representações
+    //      e mostra o pico de memória do processo.
+    //    - "--salvar ARQ" grava a árvore varrida em um snapshot binário.
+    //    - "--carregar ARQ" não varre nada: mapeia o snapshot e abre o menu.
+    //    - "--incremental ARQ" atualiza a árvore do snapshot ARQ relendo só as
+    //      pastas alteradas (sem diretório, usa a raiz gravada no snapshot).
+    //    - Modo em lote (sem menu; as opções podem ser repetidas e
+    //      combinadas, e rodam na ordem dada sobre a mesma varredura):
+    //        "--maior", "--maiores K", "--maior-que N", "--extensao EXT",
+    //        "--pastas-vazias", "--mais-filhos", "--filtro EXPR" (critérios
+    //        combinados, avaliados em uma passada), "--exportar FORMATO ARQ"
+    //      (grava a árvore em ARQ, "-" = saída padrão, nos formatos html,
+    //      jsonl, csv, colunar ou terminal) e "--resumo FORMATO ARQ"
+    //      (totais por extensão e histogramas, nos mesmos formatos exceto
+    //      colunar). Cada resultado das consultas é uma linha
+    //      "consulta<TAB>valor<TAB>caminho"; no caminho, TAB, quebras de
+    //      linha e '\' saem como \t, \n, \r e \\.
+    //    - "--comparar ANTES DEPOIS" compara duas árvores (cada uma é um
+    //      diretório, varrido com as opções acima, ou um snapshot) e lista os
+    //      arquivos adicionados, removidos e alterados e as pastas que mais
+    //      cresceram; "--comparar-pastas K" limita essa lista (padrão 20).
+    //    - "--observar" mantém a árvore atualizada (inotify) enquanto o menu
+    //      está aberto.
+    //    - "--navegar" não varre a árvore: abre a navegação (ls/cd), que lê
+    //      cada pasta só na primeira visita e soma os tamanhos em segundo
+    //      plano (com "--threads" threads).
+    //    - O primeiro argumento que não é opção é o diretório.
+    //    - Sem diretório, usa o diretório de trabalho atual + "esquema de pastas".
     // ------------------------------------------------------------------------
-    fs::path esquemaDir = (argc > 1)
-        ? fs::path(argv[1])
-        : fs::current_path() / "esquema de pastas";
+    OpcoesVarredura opcoes;
+    bool mostrarEstatisticas = false;
+    std::string relatorioJson;
+    bool usarCompacta = false;
+    bool relatorioMemoria = false;
+    bool observar = false;
+    bool navegar = false;
+    std::vector<AcaoLote> lote;
+    std::string arquivoSalvar, arquivoCarregar, arquivoAnterior;
+    std::string compararAntes, compararDepois;
+    size_t compararPastas = 20;
+    bool diretorioInformado = false;
+    fs::path esquemaDir = fs::current_path() / "esquema de pastas";
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        LeituraOpcao leitura = lerOpcaoLote(argc, argv, i, lote);
+        if (leitura == LeituraOpcao::Invalida) {
+            return 1;
+        } else if (leitura == LeituraOpcao::Lida) {
+            continue;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            if (!lerValorOpcao(arg, argv[++i], opcoes.threads)) return 1;
+        } else if (arg == "--backend" && i + 1 < argc) {
+            std::string nome = argv[++i];
+            if (nome == "posix") {
+                opcoes.backend = BackendVarredura::Posix;
+            } else if (nome == "portavel") {
+                opcoes.backend = BackendVarredura::Portavel;
+            } else if (nome == "io_uring") {
+                opcoes.backend = BackendVarredura::IoUring;
+            } else {
+                std::cerr << "[ERRO] Backend desconhecido: " << nome << std::endl;
+                return 1;
+            }
+        } else if (arg == "--fila" && i + 1 < argc) {
+            if (!lerValorOpcao(arg, argv[++i], opcoes.profundidadeFila)) return 1;
+        } else if (arg == "--um-sistema") {
+            opcoes.umSistemaArquivos = true;
+        } else if (arg == "--excluir" && i + 1 < argc) {
+            opcoes.exclusoes.adicionar(argv[++i]);
+        } else if (arg == "--profundidade" && i + 1 < argc) {
+            // -1 = sem limite
+            if (!lerValorOpcao(arg, argv[++i], opcoes.profundidadeMaxima, -1)) return 1;
+        } else if (arg == "--somar-podadas") {
+            opcoes.somarPodadas = true;
+        } else if (arg == "--estatisticas") {
+            mostrarEstatisticas = true;
+        } else if (arg == "--progresso" && i + 1 < argc) {
+            if (!lerValorOpcao(arg, argv[++i], opcoes.intervaloProgresso)) return 1;
+        } else if (arg == "--instrumentar") {
+            opcoes.instrumentar = true;
+            mostrarEstatisticas = true;
+        } else if (arg == "--relatorio-json" && i + 1 < argc) {
+            relatorioJson = argv[++i];
+            opcoes.instrumentar = true;
+        } else if (arg == "--compacta") {
+            usarCompacta = true;
+        } else if (arg == "--relatorio-memoria") {
+            relatorioMemoria = true;
+        } else if (arg == "--observar") {
+            observar = true;
+        } else if (arg == "--navegar") {
+            navegar = true;
+        } else if (arg == "--salvar" && i + 1 < argc) {
+            arquivoSalvar = argv[++i];
+        } else if (arg == "--carregar" && i + 1 < argc) {
+            arquivoCarregar = argv[++i];
+        } else if (arg == "--incremental" && i + 1 < argc) {
+            arquivoAnterior = argv[++i];
+        } else if (arg == "--comparar" && i + 2 < argc) {
+            compararAntes = argv[++i];
+            compararDepois = argv[++i];
+        } else if (arg == "--comparar-pastas" && i + 1 < argc) {
+            if (!lerValorOpcao(arg, argv[++i], compararPastas)) return 1;
+        } else {
+            esquemaDir = fs::path(arg);
+            diretorioInformado = true;
+        }
+    }
+
+    if (opcoes.backend == BackendVarredura::IoUring && !ioUringDisponivel()) {
+        std::cerr << "[AVISO] io_uring indisponível; usando o backend portável" << std::endl;
+        opcoes.backend = BackendVarredura::Portavel;
+    }
+
+    // A comparação não abre o menu nem usa o diretório padrão
+    if (!compararAntes.empty()) {
+        return executarComparacao(compararAntes, compararDepois, opcoes, compararPastas);
+    }
+
+    // ------------------------------------------------------------------------
+    // Com um snapshot, a árvore é servida direto das páginas mapeadas
+    // ------------------------------------------------------------------------
+    if (!arquivoCarregar.empty()) {
+        ArvoreCompacta compacta;
+        if (!carregarSnapshot(arquivoCarregar, compacta)) {
+            return 1;
+        }
+        if (!lote.empty()) {
+            return executarLote([&](VisitanteArvore& v) { percorrerArvore(compacta, v); }, lote,
+                                [&](size_t n) { return dividirArvore(compacta, n); });
+        }
+        menuInterativo(compacta);
+        return 0;
+    }
+
+    // ------------------------------------------------------------------------
+    // Na atualização incremental, a versão anterior vem de um snapshot
+    // ------------------------------------------------------------------------
+    std::shared_ptr<Nodo> anterior;
+    if (!arquivoAnterior.empty()) {
+        ArvoreCompacta compacta;
+        if (!carregarSnapshot(arquivoAnterior, compacta)) {
+            return 1;
+        }
+        if (!diretorioInformado) {
+            esquemaDir = compacta.caminhoRaiz();
+        }
+        anterior = expandirArvore(compacta);
+    }
 
     // ------------------------------------------------------------------------
     // 2) Validação: checa se o caminho existe e é um diretório
@@ -31,15 +202,85 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // ------------------------------------------------------------------------
+    // Navegação sob demanda: a primeira tela só depende da pasta raiz
+    // ------------------------------------------------------------------------
+    if (navegar) {
+        ArvorePreguicosa arvore(esquemaDir, opcoes);
+        navegarArvore(arvore, std::cin, std::cout);
+        imprimirEstatisticasNavegacao(arvore.estatisticas(), std::cout);
+        imprimirResumoErros(arvore.estatisticas().erros, std::cerr);
+        return 0;
+    }
+
     // ------------------------------------------------------------------------
     // 3) Construir a árvore de arquivos em memória
     // ------------------------------------------------------------------------
-    auto raiz = construirArvore(esquemaDir);
+    EstatisticasVarredura estatisticas;
+    auto raiz = anterior
+        ? atualizarArvore(anterior, esquemaDir, opcoes, &estatisticas)
+        : construirArvore(esquemaDir, opcoes, &estatisticas);
+    anterior.reset();
+    if (mostrarEstatisticas || !arquivoAnterior.empty()) {
+        imprimirEstatisticas(estatisticas, std::cout);
+    }
+    if (mostrarEstatisticas && opcoes.instrumentar) {
+        imprimirInstrumentacao(estatisticas.instrumentacao, std::cout);
+    }
+    imprimirResumoErros(estatisticas.erros, std::cerr);
+    if (!relatorioJson.empty() && !gravarRelatorioJson(estatisticas, relatorioJson)) {
+        return 1;
+    }
 
     // ------------------------------------------------------------------------
     // 4) Chamar o menu interativo, passando a árvore carregada
+    //    (na representação compacta, se pedido)
     // ------------------------------------------------------------------------
-    menuInterativo(raiz);
+    if (usarCompacta || relatorioMemoria || !arquivoSalvar.empty()) {
+        // Estimada antes da conversão, que pode liberar a árvore de Nodo
+        uint64_t bytesNodo = relatorioMemoria ? estimarBytesNodo(raiz) : 0;
+        // Com --compacta, a árvore de Nodo não é mais usada: cada nó é
+        // liberado assim que é convertido, e as duas não convivem inteiras
+        ArvoreCompacta compacta = usarCompacta ? ArvoreCompacta::deNodo(std::move(raiz))
+                                               : ArvoreCompacta::deNodo(raiz);
+        if (!arquivoSalvar.empty()) {
+            salvarSnapshot(compacta, arquivoSalvar);
+        }
+        if (relatorioMemoria) {
+            imprimirRelatorioMemoria(bytesNodo, compacta, std::cout);
+        }
+        if (usarCompacta) {
+            if (observar) {
+                std::cerr << "[AVISO] --observar não se aplica à árvore compacta." << std::endl;
+            }
+            if (!lote.empty()) {
+                return executarLote([&](VisitanteArvore& v) { percorrerArvore(compacta, v); },
+                                    lote, [&](size_t n) { return dividirArvore(compacta, n); });
+            }
+            menuInterativo(compacta, &estatisticas.erros);
+            return 0;
+        }
+    }
+
+    if (!lote.empty()) {
+        return executarLote([&](VisitanteArvore& v) { percorrerArvore(raiz, v); }, lote,
+                            [&](size_t n) { return dividirArvore(raiz, n); });
+    }
+
+    // Modo observador: a árvore é atualizada em segundo plano durante o menu
+    if (observar) {
+        ObservadorArvore observador(raiz, opcoes);
+        if (!observador.iniciar()) {
+            return 1;
+        }
+        // Cada lote aplicado muda a versão (os índices das pesquisas são refeitos)
+        menuInterativo(raiz, [&observador] { return observador.estatisticas().lotes.load(); },
+                       &estatisticas.erros);
+        observador.parar();
+        imprimirEstatisticasObservador(observador.estatisticas(), std::cout);
+        return 0;
+    }
+    menuInterativo(raiz, {}, &estatisticas.erros);
 
     return 0;  // Fim do programa
 }
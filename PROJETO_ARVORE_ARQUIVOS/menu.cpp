@@ -9,21 +9,68 @@
 #include "arvore.hpp"          // Declara construirArvore(), exibirArvore()
 #include "pesquisas.hpp"       // Declara menuPesquisas()
 #include "html_export.hpp"     // Declara exportarParaHTML()
+#include "indices.hpp"         // IndicesPesquisa (montados sob demanda)
+#include "estatisticas_arvore.hpp" // imprimirEstatisticasArvore()
+#include "percurso.hpp"        // percorrerArvore()
 #include <iostream>            // Para std::cin, std::cout
+#include <limits>              // Para descartar o resto da linha
+#include <string>              // Resposta da paginação
+
+// ----------------------------------------------------------------------------
+// Lê os limites da exibição resumida; a cada página, Enter continua e "q"
+// encerra
+// ----------------------------------------------------------------------------
+static OpcoesExibicao lerOpcoesExibicao() {
+    OpcoesExibicao opcoes;
+    char ordenar = 'n';
+    std::cout << "Profundidade máxima (-1 = sem limite): ";
+    std::cin >> opcoes.profundidadeMaxima;
+    std::cout << "Filhos por pasta (0 = todos): ";
+    std::cin >> opcoes.filhosPorPasta;
+    std::cout << "Ordenar por tamanho (s/n): ";
+    std::cin >> ordenar;
+    std::cout << "Linhas por página (0 = sem paginação): ";
+    std::cin >> opcoes.linhasPorPagina;
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+    opcoes.ordenarPorTamanho = (ordenar == 's' || ordenar == 'S');
+    opcoes.proximaPagina = [] {
+        std::cout << "-- Enter continua, q encerra -- " << std::flush;
+        std::string resposta;
+        if (!std::getline(std::cin, resposta)) return false;
+        return resposta.empty() || (resposta[0] != 'q' && resposta[0] != 'Q');
+    };
+    return opcoes;
+}
 
 // ============================================================================
-// Função: menuInterativo
+// Função: executarMenu
 // Objetivo: Exibir opções ao usuário e redirecionar para as funcionalidades.
-// Entrada: Ponteiro para a raiz da árvore (construída previamente).
+//           Escrita uma vez para as duas representações da árvore: as funções
+//           chamadas têm sobrecargas para shared_ptr<Nodo> e ArvoreCompacta.
+//           Os índices das pesquisas duram todo o menu: só a primeira
+//           pesquisa de cada tipo percorre a árvore, dividida em subárvores
+//           entre todos os núcleos.
+// Entrada: Raiz da árvore (construída previamente), a versão da árvore
+//          (opcional; se mudar, os índices são remontados) e os erros da
+//          varredura (nulo quando a árvore veio de um snapshot).
 // ============================================================================
-void menuInterativo(const std::shared_ptr<Nodo>& raiz) {
+template <typename Arvore>
+static void executarMenu(const Arvore& raiz, std::function<uint64_t()> versao,
+                         const TabelaErros* erros) {
     int opcao = -1;
+    IndicesPesquisa indices([&](VisitanteArvore& v) { percorrerArvore(raiz, v); },
+                            std::move(versao),
+                            [&](size_t partes) { return dividirArvore(raiz, partes); });
 
     do {
         std::cout << "\n========== MENU PRINCIPAL ==========\n";
         std::cout << "1. Exibir a árvore completa\n";
         std::cout << "2. Exportar árvore para HTML\n";
         std::cout << "3. Pesquisas\n";
+        std::cout << "4. Exibir a árvore resumida\n";
+        std::cout << "5. Caminhos que não puderam ser lidos\n";
+        std::cout << "6. Estatísticas da árvore\n";
         std::cout << "0. Sair\n";
         std::cout << "Escolha uma opção: ";
         std::cin >> opcao;
@@ -40,7 +87,27 @@ void menuInterativo(const std::shared_ptr<Nodo>& raiz) {
                 break;
 
             case 3:
-                menuPesquisas(raiz);
+                menuPesquisas(indices);
+                break;
+
+            case 4: {
+                OpcoesExibicao opcoes = lerOpcoesExibicao();
+                std::cout << "\n--- Árvore do sistema de arquivos ---\n";
+                exibirArvore(raiz, opcoes);
+                break;
+            }
+
+            case 5:
+                if (erros) {
+                    listarCaminhosIlegiveis(*erros, std::cout);
+                } else {
+                    std::cout << "Sem registro de erros (a árvore veio de um snapshot).\n";
+                }
+                break;
+
+            case 6:
+                std::cout << "\n--- Estatísticas da árvore ---\n";
+                imprimirEstatisticasArvore(indices.estatisticas(), std::cout);
                 break;
 
             case 0:
@@ -52,3 +119,12 @@ void menuInterativo(const std::shared_ptr<Nodo>& raiz) {
         }
     } while (opcao != 0);
 }
+
+void menuInterativo(const std::shared_ptr<Nodo>& raiz, std::function<uint64_t()> versao,
+                    const TabelaErros* erros) {
+    executarMenu(raiz, std::move(versao), erros);
+}
+
+void menuInterativo(const ArvoreCompacta& arvore, const TabelaErros* erros) {
+    executarMenu(arvore, {}, erros);
+}
@@ -6,14 +6,25 @@
 #ifndef MENU_HPP
 #define MENU_HPP
 
+#include <cstdint>      // Para uint64_t
+#include <functional>   // Para std::function
 #include <memory>       // Para std::shared_ptr
 #include "nodo.hpp"     // Estrutura de nó da árvore (Nodo)
+#include "arvore_compacta.hpp"  // Representação compacta (ArvoreCompacta)
+#include "erros_varredura.hpp"   // TabelaErros (caminhos ilegíveis)
 
 // ============================================================================
 // Função: menuInterativo
 // Objetivo: Exibir um menu interativo no terminal com opções para o usuário.
-// Entrada: Ponteiro para o nó raiz da árvore de arquivos
+// Entrada: Ponteiro para o nó raiz da árvore de arquivos, se a árvore puder
+//          mudar durante o menu, uma função que devolve sua versão e, se
+//          houver, os erros da varredura (consultados pela opção 5)
 // ============================================================================
-void menuInterativo(const std::shared_ptr<Nodo>& raiz);
+void menuInterativo(const std::shared_ptr<Nodo>& raiz,
+                    std::function<uint64_t()> versao = {},
+                    const TabelaErros* erros = nullptr);
+
+// Mesmo menu, sobre a representação compacta da árvore
+void menuInterativo(const ArvoreCompacta& arvore, const TabelaErros* erros = nullptr);
 
 #endif // MENU_HPP
@@ -0,0 +1,394 @@
+// ============================================================================
+// Arquivo: navegacao.cpp
+// Finalidade: Implementa a árvore preguiçosa (leitura no primeiro acesso,
+//             pré-leitura e medição em segundo plano) e o laço de navegação.
+// ============================================================================
+#include "navegacao.hpp"
+#include "pool_tarefas.hpp"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <shared_mutex>
+#include <string_view>
+#include <utility>
+
+#include <sys/stat.h>
+
+namespace fs = std::filesystem;
+
+// ============================================================================
+// Construtor / destrutor
+// ============================================================================
+ArvorePreguicosa::ArvorePreguicosa(const fs::path& caminho, OpcoesVarredura opcoes)
+    : opcoes(std::move(opcoes)) {
+    raizArvore = std::make_shared<Nodo>();
+    raizArvore->caminho = caminho.string();
+    raizArvore->nome = caminho.filename().string();
+    raizArvore->tipo = "pasta";
+    raizArvore->podada = true;                 // Ainda não lida
+
+    // Mesmas restrições da varredura (pastas de outro dispositivo são
+    // comparadas ao da raiz)
+    restricoes.profundidadeFila = this->opcoes.profundidadeFila;
+    if (!this->opcoes.exclusoes.vazio()) restricoes.exclusoes = &this->opcoes.exclusoes;
+    if (this->opcoes.umSistemaArquivos) {
+        restricoes.dispositivo = this->opcoes.dispositivo;
+        struct stat st;
+        if (restricoes.dispositivo == 0 && ::stat(raizArvore->caminho.c_str(), &st) == 0) {
+            restricoes.dispositivo = static_cast<uint64_t>(st.st_dev);
+        }
+    }
+
+    poolLeitura = std::make_unique<PoolTarefas>(THREADS_PRE_LEITURA);
+    poolMedicao = std::make_unique<PoolTarefas>(this->opcoes.threads);
+    iniciarMedicao(raizArvore->caminho);
+}
+
+// Com "encerrando", as tarefas ainda nas filas terminam sem ler nada; as que
+// estão lendo param depois da pasta atual. Esvaziar os pools antes de
+// destruí-los garante que nenhuma tarefa submeta a um pool já destruído.
+ArvorePreguicosa::~ArvorePreguicosa() {
+    encerrando.store(true, std::memory_order_relaxed);
+    poolMedicao->esperar();
+    poolLeitura->esperar();
+}
+
+// ============================================================================
+// Método: reservarLeitura
+// Objetivo: Decidir quem lê a pasta. Uma visita a uma pasta em leitura espera
+//           o fim dela; a pré-leitura nunca espera nem relê.
+// ============================================================================
+bool ArvorePreguicosa::reservarLeitura(const Nodo* pasta, bool esperar) {
+    std::unique_lock<std::mutex> lock(travaEstado);
+    Leitura& estado = estados[pasta];          // Referência estável no unordered_map
+    if (estado == Leitura::NaoLida) {
+        estado = Leitura::Lendo;
+        return true;
+    }
+    if (!esperar) return false;
+    leituraConcluida.wait(lock, [&estado] { return estado != Leitura::Lendo; });
+    if (estado == Leitura::PreLida) {
+        estado = Leitura::Lida;
+        estat.acertosPreLeitura.fetch_add(1, std::memory_order_relaxed);
+    }
+    return false;
+}
+
+// ============================================================================
+// Método: lerPasta
+// Objetivo: Uma listagem da pasta; os filhos são publicados de uma vez, sob a
+//           trava exclusiva (as subpastas começam podadas: ainda não lidas)
+// ============================================================================
+void ArvorePreguicosa::lerPasta(Nodo* pasta, bool preLeitura) {
+    ContadoresLeitura cont;
+    std::vector<EntradaLida> entradas;
+    ResultadoLeitura resultado = listarDiretorio(opcoes.backend, pasta->caminho, entradas, cont,
+                                                 nullptr, &restricoes);
+    std::vector<std::shared_ptr<Nodo>> novos;
+    novos.reserve(entradas.size());
+    for (auto& entrada : entradas) {
+        auto filho = std::make_shared<Nodo>();
+        filho->caminho = juntarCaminho(pasta->caminho, entrada.nome);
+        filho->nome = std::move(entrada.nome);
+        filho->tipo = entrada.pasta ? "pasta" : "arquivo";
+        filho->tamanho = entrada.tamanho;
+        filho->alocado = entrada.alocado;
+        filho->vinculo = entrada.vinculo;
+        filho->podada = entrada.pasta;
+        novos.push_back(std::move(filho));
+    }
+    {
+        std::unique_lock<std::shared_mutex> lock(travaFilhos(*pasta));
+        pasta->filhos = std::move(novos);
+        pasta->podada = resultado != ResultadoLeitura::Lida;
+    }
+    estat.erros.anexar(cont.erros);
+    estat.pastasLidas.fetch_add(1, std::memory_order_relaxed);
+    if (preLeitura) estat.preLidas.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(travaEstado);
+        estados[pasta] = preLeitura ? Leitura::PreLida : Leitura::Lida;
+    }
+    leituraConcluida.notify_all();
+}
+
+// ============================================================================
+// Método: filhos
+// ============================================================================
+std::vector<std::shared_ptr<Nodo>> ArvorePreguicosa::filhos(const std::shared_ptr<Nodo>& pasta) {
+    if (reservarLeitura(pasta.get(), true)) lerPasta(pasta.get(), false);
+
+    std::vector<std::shared_ptr<Nodo>> copia;
+    {
+        std::shared_lock<std::shared_mutex> lock(travaFilhos(*pasta));
+        copia = pasta->filhos;
+    }
+    preLer(copia);
+    for (const auto& filho : copia) {
+        if (filho->tipo == "pasta") iniciarMedicao(filho->caminho);
+    }
+    return copia;
+}
+
+// ----------------------------------------------------------------------------
+// Pré-leitura: as subpastas com mais bytes já somados primeiro (as que o
+// usuário mais provavelmente abrirá); nos empates, a ordem de leitura
+// ----------------------------------------------------------------------------
+void ArvorePreguicosa::preLer(const std::vector<std::shared_ptr<Nodo>>& filhos) {
+    std::vector<std::pair<uintmax_t, const std::shared_ptr<Nodo>*>> candidatas;
+    for (const auto& filho : filhos) {
+        if (filho->tipo != "pasta") continue;
+        auto m = medicao(filho->caminho);
+        candidatas.emplace_back(m ? m->tamanho.load(std::memory_order_relaxed) : 0, &filho);
+    }
+    size_t quantidade = std::min(candidatas.size(), MAX_PRE_LEITURA);
+    std::partial_sort(candidatas.begin(), candidatas.begin() + quantidade, candidatas.end(),
+                      [](const auto& a, const auto& b) {
+                          return a.first != b.first ? a.first > b.first : a.second < b.second;
+                      });
+    for (size_t i = 0; i < quantidade; ++i) {
+        poolLeitura->submeter([this, pasta = *candidatas[i].second] {
+            if (encerrando.load(std::memory_order_relaxed)) return;
+            if (reservarLeitura(pasta.get(), false)) lerPasta(pasta.get(), true);
+        });
+    }
+}
+
+// ============================================================================
+// Medição dos tamanhos
+// ----------------------------------------------------------------------------
+// Cada tarefa lista uma pasta, soma os arquivos a todos os seus "alvos" e
+// agenda uma tarefa por subpasta com os mesmos alvos (como somarPodada na
+// varredura). Um alvo fica pronto quando todas as tarefas que somam a ele
+// terminam. A primeira tarefa de uma medição também cria a medição de cada
+// subpasta, que passa a ser um alvo a mais na subárvore dela.
+// ============================================================================
+std::shared_ptr<ArvorePreguicosa::Medicao> ArvorePreguicosa::medicao(const std::string& caminho,
+                                                                     bool* nova) {
+    std::lock_guard<std::mutex> lock(travaMedicoes);
+    if (!nova) {
+        auto it = medicoes.find(caminho);
+        return it != medicoes.end() ? it->second : nullptr;
+    }
+    auto& m = medicoes[caminho];
+    *nova = !m;
+    if (*nova) {
+        m = std::make_shared<Medicao>();
+        m->pendentes.store(1, std::memory_order_relaxed);   // A tarefa da própria pasta
+    }
+    return m;
+}
+
+void ArvorePreguicosa::iniciarMedicao(const std::string& caminho) {
+    bool nova = false;
+    auto m = medicao(caminho, &nova);
+    if (!nova) return;
+    poolMedicao->submeter([this, caminho, alvos = Alvos{std::move(m)}] {
+        medir(caminho, alvos, true);
+    });
+}
+
+void ArvorePreguicosa::medir(const std::string& caminho, const Alvos& alvos, bool medirSubpastas) {
+    uintmax_t tamanho = 0, alocado = 0;
+    if (!encerrando.load(std::memory_order_relaxed)) {
+        ContadoresLeitura cont;
+        std::vector<EntradaLida> entradas;
+        if (listarDiretorio(opcoes.backend, caminho, entradas, cont, nullptr,
+                            &restricoes) == ResultadoLeitura::Lida) {
+            for (auto& entrada : entradas) {
+                if (!entrada.pasta) {
+                    tamanho += entrada.tamanho;
+                    alocado += entrada.alocado;
+                    continue;
+                }
+                std::string sub = juntarCaminho(caminho, entrada.nome);
+                Alvos subAlvos = alvos;
+                for (const auto& alvo : subAlvos) {
+                    alvo->pendentes.fetch_add(1, std::memory_order_relaxed);
+                }
+                bool nova = false;
+                if (medirSubpastas) {
+                    auto m = medicao(sub, &nova);
+                    if (nova) subAlvos.push_back(std::move(m));
+                }
+                poolMedicao->submeter([this, sub = std::move(sub), subAlvos = std::move(subAlvos)] {
+                    medir(sub, subAlvos, false);
+                });
+            }
+        }
+        // Os erros da subárvore não vão para a tabela: a mesma pasta pode ser
+        // medida mais de uma vez
+        estat.pastasMedidas.fetch_add(1, std::memory_order_relaxed);
+    }
+    for (const auto& alvo : alvos) {
+        alvo->tamanho.fetch_add(tamanho, std::memory_order_relaxed);
+        alvo->alocado.fetch_add(alocado, std::memory_order_relaxed);
+        alvo->pendentes.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+// ============================================================================
+// Método: tamanhoPasta
+// ============================================================================
+bool ArvorePreguicosa::tamanhoPasta(Nodo& pasta, uintmax_t& tamanho, uintmax_t& alocado) {
+    auto m = medicao(pasta.caminho);
+    if (!m) {
+        tamanho = alocado = 0;
+        return false;
+    }
+    bool pronta = m->pendentes.load(std::memory_order_acquire) == 0;
+    tamanho = m->tamanho.load(std::memory_order_relaxed);
+    alocado = m->alocado.load(std::memory_order_relaxed);
+    if (pronta) {
+        pasta.tamanho.store(tamanho, std::memory_order_relaxed);
+        pasta.alocado.store(alocado, std::memory_order_relaxed);
+    }
+    return pronta;
+}
+
+// ============================================================================
+// Navegação
+// ============================================================================
+static std::string_view aparar(std::string_view texto) {
+    while (!texto.empty() && std::isspace(static_cast<unsigned char>(texto.front()))) {
+        texto.remove_prefix(1);
+    }
+    while (!texto.empty() && std::isspace(static_cast<unsigned char>(texto.back()))) {
+        texto.remove_suffix(1);
+    }
+    return texto;
+}
+
+// "(X bytes, Y em disco)" ou "(pendente: X bytes até agora)"
+static void escreverTamanho(ArvorePreguicosa& arvore, Nodo& nodo, std::ostream& out) {
+    uintmax_t tamanho = nodo.tamanho.load(std::memory_order_relaxed);
+    uintmax_t alocado = nodo.alocado.load(std::memory_order_relaxed);
+    if (nodo.tipo == "pasta" && !arvore.tamanhoPasta(nodo, tamanho, alocado)) {
+        out << "pendente: " << tamanho << " bytes até agora";
+        return;
+    }
+    out << tamanho << " bytes, " << alocado << " em disco";
+}
+
+// Pasta de destino de "cd"/"ls" a partir da pilha atual (nulo se não existe)
+static std::vector<std::shared_ptr<Nodo>> resolver(ArvorePreguicosa& arvore,
+                                                   std::vector<std::shared_ptr<Nodo>> pilha,
+                                                   std::string_view destino, std::ostream& out) {
+    if (!destino.empty() && destino.front() == '/') pilha.resize(1);
+    while (!destino.empty()) {
+        size_t barra = destino.find('/');
+        std::string_view parte = destino.substr(0, barra);
+        destino = barra == std::string_view::npos ? std::string_view() : destino.substr(barra + 1);
+        if (parte.empty() || parte == ".") continue;
+        if (parte == "..") {
+            if (pilha.size() > 1) pilha.pop_back();
+            continue;
+        }
+        std::shared_ptr<Nodo> encontrada;
+        for (const auto& filho : arvore.filhos(pilha.back())) {
+            if (filho->tipo == "pasta" && filho->nome == parte) {
+                encontrada = filho;
+                break;
+            }
+        }
+        if (!encontrada) {
+            out << "Pasta não encontrada: " << parte << "\n";
+            return {};
+        }
+        pilha.push_back(std::move(encontrada));
+    }
+    return pilha;
+}
+
+// Lista a pasta: pastas primeiro, depois arquivos, cada grupo por nome
+static void listar(ArvorePreguicosa& arvore, const std::shared_ptr<Nodo>& pasta,
+                   std::ostream& out) {
+    auto filhos = arvore.filhos(pasta);
+    std::sort(filhos.begin(), filhos.end(), [](const auto& a, const auto& b) {
+        bool pa = a->tipo == "pasta", pb = b->tipo == "pasta";
+        return pa != pb ? pa : a->nome < b->nome;
+    });
+
+    out << pasta->caminho << " (" << filhos.size() << " filhos, ";
+    escreverTamanho(arvore, *pasta, out);
+    out << ")\n";
+    if (pasta->podada) {
+        out << "[AVISO] A pasta não pôde ser lida (veja \"erros\").\n";
+    }
+    for (size_t i = 0; i < filhos.size(); ++i) {
+        Nodo& filho = *filhos[i];
+        out << (i + 1 < filhos.size() ? "├── " : "└── ") << filho.nome
+            << (filho.tipo == "pasta" ? "/ (" : " (");
+        escreverTamanho(arvore, filho, out);
+        out << ")\n";
+    }
+}
+
+// ============================================================================
+// Função: navegarArvore
+// ============================================================================
+void navegarArvore(ArvorePreguicosa& arvore, std::istream& in, std::ostream& out) {
+    std::vector<std::shared_ptr<Nodo>> pilha{arvore.raiz()};
+    listar(arvore, arvore.raiz(), out);
+    out << "Digite \"ajuda\" para ver os comandos.\n";
+
+    std::string linha;
+    while (true) {
+        out << pilha.back()->caminho << "> " << std::flush;
+        if (!std::getline(in, linha)) {
+            out << "\n";
+            break;
+        }
+        std::string_view comando = aparar(linha);
+        std::string_view argumento;
+        size_t espaco = comando.find(' ');
+        if (espaco != std::string_view::npos) {
+            argumento = aparar(comando.substr(espaco + 1));
+            comando = comando.substr(0, espaco);
+        }
+
+        if (comando.empty()) {
+            continue;
+        } else if (comando == "ls") {
+            auto destino = resolver(arvore, pilha, argumento, out);
+            if (!destino.empty()) listar(arvore, destino.back(), out);
+        } else if (comando == "cd") {
+            auto destino = resolver(arvore, pilha, argumento.empty() ? "/" : argumento, out);
+            if (!destino.empty()) pilha = std::move(destino);
+        } else if (comando == "pwd") {
+            out << pilha.back()->caminho << " (";
+            escreverTamanho(arvore, *pilha.back(), out);
+            out << ")\n";
+        } else if (comando == "erros") {
+            if (arvore.estatisticas().erros.vazia()) {
+                out << "Nenhuma pasta visitada deu erro de leitura.\n";
+            } else {
+                listarCaminhosIlegiveis(arvore.estatisticas().erros, out);
+            }
+        } else if (comando == "ajuda") {
+            out << "  ls [PASTA]   lista a pasta atual (ou PASTA)\n"
+                   "  cd PASTA     entra em PASTA (\"..\" sobe, \"/\" ou só \"cd\" volta à raiz)\n"
+                   "  pwd          mostra a pasta atual e o tamanho dela\n"
+                   "  erros        caminhos que não puderam ser lidos\n"
+                   "  sair         encerra\n"
+                   "Tamanhos \"pendente\" ainda estão sendo somados; um novo \"ls\" mostra o "
+                   "andamento.\n";
+        } else if (comando == "sair" || comando == "q") {
+            break;
+        } else {
+            out << "Comando desconhecido: " << comando << " (digite \"ajuda\")\n";
+        }
+    }
+}
+
+// ============================================================================
+// Função: imprimirEstatisticasNavegacao
+// ============================================================================
+void imprimirEstatisticasNavegacao(const EstatisticasNavegacao& estatisticas,
+                                   std::ostream& out) {
+    out << "[INFO] Navegação: " << estatisticas.pastasLidas.load() << " pastas lidas ("
+        << estatisticas.preLidas.load() << " pela pré-leitura, "
+        << estatisticas.acertosPreLeitura.load() << " visitadas já prontas), "
+        << estatisticas.pastasMedidas.load() << " pastas percorridas para os tamanhos\n";
+}
@@ -0,0 +1,152 @@
+// ============================================================================
+// Arquivo: navegacao.hpp
+// Finalidade: Declarar a navegação sob demanda: a árvore de Nodo é expandida
+//             pasta a pasta conforme é visitada, sem a varredura completa, e
+//             os tamanhos das pastas são calculados em segundo plano. Assim,
+//             o tempo até a primeira tela não depende do tamanho do volume.
+// ============================================================================
+#ifndef NAVEGACAO_HPP
+#define NAVEGACAO_HPP
+
+#include <atomic>                     // Contadores e sinal de encerramento
+#include <condition_variable>         // Espera de uma leitura em andamento
+#include <cstdint>                    // uint64_t, uintmax_t
+#include <filesystem>                 // Caminho da raiz
+#include <istream>                    // Comandos da navegação
+#include <memory>                     // std::shared_ptr, std::unique_ptr
+#include <mutex>                      // Estado das pastas e das medições
+#include <ostream>                    // Resumo final
+#include <string>                     // Caminhos das medições
+#include <unordered_map>              // Estado por pasta, medições por caminho
+#include <vector>                     // Filhos devolvidos
+#include "nodo.hpp"                   // Estrutura de dados Nodo
+#include "varredura.hpp"              // OpcoesVarredura
+#include "erros_varredura.hpp"        // TabelaErros
+
+class PoolTarefas;
+
+// ============================================================================
+// Estrutura: EstatisticasNavegacao
+// Objetivo: Contar o trabalho feito durante a navegação (lidas ao final).
+// ============================================================================
+struct EstatisticasNavegacao {
+    std::atomic<uint64_t> pastasLidas{0};        // Pastas expandidas (na hora ou antes)
+    std::atomic<uint64_t> preLidas{0};           // Expandidas pela pré-leitura
+    std::atomic<uint64_t> acertosPreLeitura{0};  // Visitas a pastas já pré-lidas
+    std::atomic<uint64_t> pastasMedidas{0};      // Pastas percorridas pelos tamanhos
+    TabelaErros erros;                           // Caminhos que não puderam ser lidos
+};
+
+// ============================================================================
+// Classe: ArvorePreguicosa
+// Objetivo: Árvore de Nodo cujas pastas só são lidas no primeiro acesso:
+//           - filhos() lê a pasta (uma única listagem, com as mesmas opções
+//             da varredura) e guarda os filhos no Nodo; as pastas filhas
+//             começam sem filhos.
+//           - Pré-leitura: depois de cada acesso, as subpastas mais prováveis
+//             de serem visitadas (as de maior tamanho conhecido até o
+//             momento) são lidas por um pool próprio, para que o próximo
+//             "cd" já as encontre prontas. Uma visita a uma pasta em leitura
+//             espera essa leitura em vez de repeti-la.
+//           - Tamanhos: cada pasta listada tem o tamanho das subpastas
+//             calculado em segundo plano, sem criar nós (como o
+//             "--somar-podadas" da varredura), por outro pool, com as tarefas
+//             mais recentes na frente. Até terminar, o tamanho é "pendente".
+//             O cálculo de uma pasta também mede as subpastas dela, então a
+//             visita seguinte já as encontra medidas.
+//           O encerramento (destrutor) interrompe os cálculos em andamento
+//           na próxima pasta e descarta os que ainda não começaram.
+// Limitação: links físicos são contados a cada link nos tamanhos, e o limite
+//           de profundidade da varredura não se aplica.
+// ============================================================================
+class ArvorePreguicosa {
+public:
+    // "caminho" é a pasta raiz (ainda não lida); "opcoes" fornece o
+    // backend, as exclusões, o limite de sistema de arquivos e o número de
+    // threads do cálculo dos tamanhos (0 = todos os núcleos)
+    ArvorePreguicosa(const std::filesystem::path& caminho, OpcoesVarredura opcoes);
+    ~ArvorePreguicosa();
+
+    ArvorePreguicosa(const ArvorePreguicosa&) = delete;
+    ArvorePreguicosa& operator=(const ArvorePreguicosa&) = delete;
+
+    const std::shared_ptr<Nodo>& raiz() const { return raizArvore; }
+
+    // Filhos da pasta, lidos no primeiro acesso; agenda a pré-leitura e a
+    // medição das subpastas
+    std::vector<std::shared_ptr<Nodo>> filhos(const std::shared_ptr<Nodo>& pasta);
+
+    // Tamanho total da pasta. Devolve false enquanto o cálculo não termina;
+    // "tamanho" e "alocado" recebem então o que já foi somado. Quando pronto,
+    // o total também é gravado no Nodo.
+    bool tamanhoPasta(Nodo& pasta, uintmax_t& tamanho, uintmax_t& alocado);
+
+    const EstatisticasNavegacao& estatisticas() const { return estat; }
+
+private:
+    // PreLida: lida pela pré-leitura e ainda não visitada
+    enum class Leitura : uint8_t { NaoLida, Lendo, PreLida, Lida };
+
+    // Soma de uma subárvore; pronta quando "pendentes" chega a 0
+    struct Medicao {
+        std::atomic<uintmax_t> tamanho{0};
+        std::atomic<uintmax_t> alocado{0};
+        std::atomic<size_t> pendentes{0};
+    };
+    using Alvos = std::vector<std::shared_ptr<Medicao>>;
+
+    static constexpr size_t MAX_PRE_LEITURA = 16;   // Subpastas pré-lidas por acesso
+    static constexpr unsigned THREADS_PRE_LEITURA = 2;
+
+    // Visita (esperar = true) ou pré-leitura: devolve true se quem chama
+    // deve ler a pasta
+    bool reservarLeitura(const Nodo* pasta, bool esperar);
+    void lerPasta(Nodo* pasta, bool preLeitura);    // Lista e publica os filhos
+    void preLer(const std::vector<std::shared_ptr<Nodo>>& filhos);
+    void iniciarMedicao(const std::string& caminho);
+    void medir(const std::string& caminho, const Alvos& alvos, bool medirSubpastas);
+    std::shared_ptr<Medicao> medicao(const std::string& caminho, bool* nova = nullptr);
+
+    std::shared_ptr<Nodo> raizArvore;
+    OpcoesVarredura opcoes;
+    RestricoesLeitura restricoes;
+    std::atomic<bool> encerrando{false};
+
+    std::mutex travaEstado;
+    std::condition_variable leituraConcluida;
+    std::unordered_map<const Nodo*, Leitura> estados;   // Ausente = NaoLida
+
+    std::mutex travaMedicoes;
+    std::unordered_map<std::string, std::shared_ptr<Medicao>> medicoes;
+
+    EstatisticasNavegacao estat;
+
+    // Por último: destruídos (e as threads encerradas) antes do resto
+    // (o destrutor espera as tarefas)
+    std::unique_ptr<PoolTarefas> poolLeitura;
+    std::unique_ptr<PoolTarefas> poolMedicao;
+};
+
+// ============================================================================
+// Função: navegarArvore
+// Objetivo: Laço interativo sobre a árvore preguiçosa. Comandos (um por linha):
+//             ls [PASTA]      lista a pasta atual (ou PASTA): as pastas
+//                             primeiro, cada grupo por nome
+//             cd [PASTA]      entra em PASTA ("..", "/" e caminhos relativos
+//                             com várias partes, como "a/b", são aceitos;
+//                             sem PASTA, volta à raiz)
+//             pwd             mostra a pasta atual e o tamanho dela
+//             erros           caminhos que não puderam ser lidos
+//             ajuda           lista os comandos
+//             sair            encerra (também no fim da entrada)
+// ============================================================================
+void navegarArvore(ArvorePreguicosa& arvore, std::istream& in, std::ostream& out);
+
+// ============================================================================
+// Função: imprimirEstatisticasNavegacao
+// Objetivo: Escrever um resumo do trabalho feito durante a navegação.
+// ============================================================================
+void imprimirEstatisticasNavegacao(const EstatisticasNavegacao& estatisticas,
+                                   std::ostream& out);
+
+#endif // NAVEGACAO_HPP
@@ -9,6 +9,9 @@
 #include <string>                      // Para manipulação de nomes e caminhos
 #include <vector>                      // Para armazenar múltiplos filhos
 #include <memory>                      // Para uso de ponteiros inteligentes (shared_ptr)
+#include <cstdint>                     // Para uint64_t
+#include <atomic>                      // Para o tamanho atualizado ao vivo
+#include <shared_mutex>                // Para proteger as listas de filhos
 
 // ============================================================================
 // Estrutura: Nodo
@@ -18,10 +21,47 @@ struct Nodo {
     std::string caminho;  // Caminho completo (absoluto ou relativo) do arquivo/pasta
     std::string nome;     // Nome simples do arquivo ou diretório (sem o caminho)
     std::string tipo;     // Tipo do nó: "arquivo" ou "pasta"
-    uintmax_t tamanho;    // Tamanho em bytes. Se for pasta, soma dos tamanhos dos filhos
+    std::atomic<uintmax_t> tamanho{0}; // Tamanho aparente em bytes. Se for pasta, soma dos
+                                       // tamanhos dos filhos (atômico: o observador o
+                                       // atualiza enquanto as consultas o leem)
+    std::atomic<uintmax_t> alocado{0}; // Bytes ocupados no disco (st_blocks * 512); arquivos
+                                       // esparsos ocupam menos que o tamanho aparente.
+                                       // Se for pasta, soma dos filhos
+    std::atomic<uint64_t> vinculo{0};  // Arquivos com mais de um link físico: dispositivo +
+                                       // inode combinados (0 = link único); atômico, como
+                                       // os tamanhos, porque o observador o atualiza
+    std::atomic<bool> vinculoRepetido{false}; // Outro link do mesmo inode já é contado: este
+                                              // arquivo não entra nos totais das pastas
+    uint64_t assinatura = 0; // Pastas: inode + mtime + ctime combinados (0 = desconhecida),
+                             // usada para pular pastas inalteradas na atualização incremental
+    bool podada = false;     // Pasta cujo conteúdo não foi lido (limite de profundidade,
+                             // outro sistema de arquivos ou sem permissão); o tamanho
+                             // não vem dos filhos
 
     // Vetor de ponteiros para os filhos deste nó (apenas se o nó for uma pasta)
+    // (protegido por travaFilhos quando a árvore é mantida ao vivo)
     std::vector<std::shared_ptr<Nodo>> filhos;
 };
 
+// ============================================================================
+// Função: travaFilhos
+// Objetivo: Trava que protege "filhos" quando a árvore é mantida ao vivo
+//           (observador e navegação): quem altera a lista usa a trava
+//           exclusiva; o percurso usa a compartilhada. Em vez de uma trava em
+//           cada nó, as pastas são distribuídas pelo endereço entre
+//           NUM_TRAVAS_FILHOS travas, cada uma em sua linha de cache. Como
+//           duas pastas podem cair na mesma trava, nunca se segura mais de
+//           uma ao mesmo tempo. Caminho, nome e tipo nunca mudam depois que o
+//           nó é publicado na árvore (uma renomeação troca o nó inteiro).
+// ============================================================================
+constexpr size_t NUM_TRAVAS_FILHOS = 256;
+
+inline std::shared_mutex& travaFilhos(const Nodo& pasta) {
+    struct alignas(64) Faixa { std::shared_mutex trava; };
+    static Faixa faixas[NUM_TRAVAS_FILHOS];
+    // Hash multiplicativo: nós alocados lado a lado caem em faixas distintas
+    uint64_t endereco = reinterpret_cast<uintptr_t>(&pasta);
+    return faixas[((endereco * 0x9E3779B97F4A7C15ull) >> 32) % NUM_TRAVAS_FILHOS].trava;
+}
+
 #endif // NODO_HPP
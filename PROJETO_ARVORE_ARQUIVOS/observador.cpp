@@ -0,0 +1,514 @@
+// ============================================================================
+// Arquivo: observador.cpp
+// Finalidade: Implementa o observador da árvore com inotify: uma thread lê os
+//             eventos, agrupa-os em lotes e concilia a árvore com o disco.
+// ============================================================================
+#include "observador.hpp"
+#include "varredura.hpp"        // construirArvore() para pastas novas
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <system_error>
+#include <vector>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Eventos assinados em cada pasta (os da própria pasta, como IN_IGNORED,
+// chegam sempre)
+static constexpr uint32_t MASCARA_VIGIA =
+    IN_CREATE | IN_DELETE | IN_MODIFY | IN_MOVED_FROM | IN_MOVED_TO |
+    IN_ONLYDIR | IN_DONT_FOLLOW | IN_EXCL_UNLINK;
+
+// ============================================================================
+// Construtor / destrutor
+// ============================================================================
+ObservadorArvore::ObservadorArvore(std::shared_ptr<Nodo> raiz, OpcoesVarredura opcoes,
+                                   std::chrono::milliseconds janela)
+    : raiz(std::move(raiz)), opcoes(std::move(opcoes)), janela(janela) {
+    // Pastas novas são comparadas ao dispositivo da raiz, não ao delas
+    struct stat st;
+    if (this->opcoes.umSistemaArquivos && this->opcoes.dispositivo == 0 && this->raiz &&
+        ::stat(this->raiz->caminho.c_str(), &st) == 0) {
+        this->opcoes.dispositivo = static_cast<uint64_t>(st.st_dev);
+    }
+}
+
+ObservadorArvore::~ObservadorArvore() {
+    parar();
+}
+
+// ============================================================================
+// Método: iniciar
+// ============================================================================
+bool ObservadorArvore::iniciar() {
+    if (!raiz || raiz->tipo != "pasta" || thread.joinable()) return false;
+
+    descritor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (descritor < 0) {
+        std::cerr << "[ERRO] inotify indisponível: " << std::strerror(errno) << "\n";
+        return false;
+    }
+    sinalParada = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (sinalParada < 0) {
+        std::cerr << "[ERRO] eventfd indisponível: " << std::strerror(errno) << "\n";
+        close(descritor);
+        descritor = -1;
+        return false;
+    }
+
+    vigiarSubarvore(raiz, nullptr, nullptr);
+    ajustarVinculos();                      // As marcas da varredura já seguem a regra
+    thread = std::thread(&ObservadorArvore::laco, this);
+    return true;
+}
+
+// ============================================================================
+// Método: parar
+// ============================================================================
+void ObservadorArvore::parar() {
+    if (thread.joinable()) {
+        uint64_t um = 1;
+        ssize_t escrito = write(sinalParada, &um, sizeof(um));
+        (void)escrito;
+        thread.join();
+    }
+    if (descritor >= 0) close(descritor);      // Remove todas as vigias
+    if (sinalParada >= 0) close(sinalParada);
+    descritor = sinalParada = -1;
+    vigias.clear();
+    wdDe.clear();
+    vinculos.clear();
+    estat.pastasVigiadas = 0;
+}
+
+// ----------------------------------------------------------------------------
+// Corpo da thread: espera o primeiro evento e, a partir dele, continua lendo
+// enquanto chegarem eventos dentro da janela (no máximo 10 janelas), para
+// aplicar uma rajada inteira de uma só vez.
+// ----------------------------------------------------------------------------
+void ObservadorArvore::laco() {
+    pollfd fds[2] = {{descritor, POLLIN, 0}, {sinalParada, POLLIN, 0}};
+    bool encerrar = false;
+    while (!encerrar) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[1].revents) break;
+
+        Lote lote;
+        lerEventos(lote);
+        auto limite = std::chrono::steady_clock::now() + janela * 10;
+        while (true) {
+            auto resta = std::chrono::duration_cast<std::chrono::milliseconds>(
+                limite - std::chrono::steady_clock::now());
+            if (resta.count() <= 0) break;
+            int prontos = poll(fds, 2, static_cast<int>(std::min(resta, janela).count()));
+            if (prontos < 0 && errno == EINTR) continue;
+            if (prontos <= 0) break;              // Janela sem eventos: fim da rajada
+            if (fds[1].revents) {
+                encerrar = true;
+                break;
+            }
+            lerEventos(lote);
+        }
+        if (!encerrar) aplicarLote(lote);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Lê todos os eventos disponíveis e os acrescenta ao lote. Eventos sobre a
+// mesma entrada se acumulam na mesma chave (máscaras combinadas).
+// ----------------------------------------------------------------------------
+bool ObservadorArvore::lerEventos(Lote& lote) {
+    alignas(inotify_event) char buffer[64 * 1024];
+    bool recebeu = false;
+    while (true) {
+        ssize_t n = read(descritor, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;                        // EAGAIN: nada mais por ora
+        recebeu = true;
+
+        for (char* p = buffer; p < buffer + n; ) {
+            const auto* ev = reinterpret_cast<const inotify_event*>(p);
+            p += sizeof(inotify_event) + ev->len;
+            estat.eventos.fetch_add(1, std::memory_order_relaxed);
+
+            if (ev->mask & IN_Q_OVERFLOW) {
+                // Eventos perdidos: todas as pastas serão relidas
+                lote[{-1, std::string()}] |= IN_Q_OVERFLOW;
+                continue;
+            }
+            if (ev->mask & IN_IGNORED) {
+                // Vigia removida pelo kernel (pasta apagada ou desmontada);
+                // o evento na pasta pai retira o nó da árvore
+                auto it = vigias.find(ev->wd);
+                if (it != vigias.end()) {
+                    wdDe.erase(it->second.pasta.get());
+                    vigias.erase(it);
+                    estat.pastasVigiadas.fetch_sub(1, std::memory_order_relaxed);
+                }
+                continue;
+            }
+            if (ev->len == 0) continue;           // Evento da própria pasta
+            lote[{ev->wd, std::string(ev->name)}] |= ev->mask;
+        }
+    }
+    return recebeu;
+}
+
+// ----------------------------------------------------------------------------
+// Aplica o lote. Conciliar uma pasta nova pode acrescentar entradas ao lote,
+// por isso ele é consumido como uma fila até esvaziar.
+// ----------------------------------------------------------------------------
+void ObservadorArvore::aplicarLote(Lote& lote) {
+    auto estouro = lote.find({-1, std::string()});
+    if (estouro != lote.end()) {
+        lote.erase(estouro);
+        estat.estouros.fetch_add(1, std::memory_order_relaxed);
+        std::cerr << "[AVISO] Fila do inotify transbordou; relendo as pastas vigiadas.\n";
+        std::vector<int> todas;
+        todas.reserve(vigias.size());
+        for (const auto& [wd, vigia] : vigias) todas.push_back(wd);
+        for (int wd : todas) ressincronizar(wd, lote);
+    }
+
+    while (!lote.empty()) {
+        auto item = lote.extract(lote.begin());
+        conciliar(item.key().first, item.key().second, item.mapped(), lote);
+        estat.reconciliacoes.fetch_add(1, std::memory_order_relaxed);
+    }
+    estat.lotes.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ----------------------------------------------------------------------------
+// Faz o filho "nome" da pasta vigiada "wd" refletir o disco. A árvore segue o
+// estado atual da entrada, e não a sequência de eventos, de modo que qualquer
+// combinação agrupada (criar + alterar + apagar...) dá o resultado certo.
+// ----------------------------------------------------------------------------
+void ObservadorArvore::conciliar(int wd, const std::string& nome, uint32_t mascara,
+                                 Lote& lote) {
+    auto it = vigias.find(wd);
+    if (it == vigias.end()) return;               // Pasta já removida da árvore
+    Nodo* pasta = it->second.pasta.get();
+    if (opcoes.exclusoes.exclui(pasta->caminho, nome)) return;
+    std::string caminho = juntarCaminho(pasta->caminho, nome);
+
+    // Estado atual no disco (links simbólicos e especiais são ignorados,
+    // como na varredura)
+    struct stat st;
+    bool ehArquivo = false, ehPasta = false;
+    if (lstat(caminho.c_str(), &st) == 0) {
+        ehArquivo = S_ISREG(st.st_mode);
+        ehPasta = S_ISDIR(st.st_mode);
+    }
+
+    // Somente esta thread altera "filhos": a leitura dispensa a trava
+    auto& filhos = pasta->filhos;
+    auto pos = std::find_if(filhos.begin(), filhos.end(),
+                            [&](const std::shared_ptr<Nodo>& f) { return f->nome == nome; });
+    std::shared_ptr<Nodo> atual = pos != filhos.end() ? *pos : nullptr;
+
+    if (atual && ehArquivo && atual->tipo == "arquivo") {
+        MetadadosArquivo m = metadadosArquivo(st);
+        // Quando os outros links do mesmo inode somem, a chave é mantida:
+        // sozinho no mapa, o arquivo conta, e um link criado depois ainda é
+        // reconhecido. Se a chave muda (o arquivo ganhou links ou o nome
+        // passou a outro inode), ele sai do inode antigo, volta a contar e
+        // entra no novo.
+        uint64_t inode = chaveVinculo(static_cast<uint64_t>(st.st_dev),
+                                      static_cast<uint64_t>(st.st_ino));
+        uint64_t chave = m.vinculo != 0 || atual->vinculo == inode ? inode : 0;
+        if (chave != atual->vinculo) {
+            if (atual->vinculo != 0) retirarVinculo(atual.get());
+            if (atual->vinculoRepetido) contarVinculo({atual.get(), pasta}, true);
+            atual->vinculo = chave;
+            if (chave != 0) registrarVinculo(atual.get(), pasta);
+        }
+        atualizarTamanho(atual.get(), pasta, m);
+        // Os outros links do inode têm o mesmo conteúdo (e não recebem evento)
+        auto links = atual->vinculo != 0 ? vinculos.find(atual->vinculo) : vinculos.end();
+        if (links != vinculos.end()) {
+            for (const Vinculo& v : links->second) {
+                if (v.arquivo != atual.get() && wdDe.count(v.pasta)) {
+                    atualizarTamanho(v.arquivo, v.pasta, m);
+                }
+            }
+        }
+        ajustarVinculos();
+        return;
+    }
+    // Pasta existente: o conteúdo é tratado pela vigia dela, a não ser que
+    // outra pasta tenha sido criada ou movida para o mesmo nome
+    if (atual && ehPasta && atual->tipo == "pasta" &&
+        !(mascara & (IN_CREATE | IN_MOVED_TO))) {
+        return;
+    }
+
+    uintmax_t delta = 0, deltaAlocado = 0;
+    if (atual) {
+        {
+            std::unique_lock<std::shared_mutex> lock(travaFilhos(*pasta));
+            filhos.erase(pos);
+        }
+        if (atual->tipo == "pasta") {
+            esquecerSubarvore(atual.get());
+        } else if (atual->vinculo != 0) {
+            retirarVinculo(atual.get());
+        }
+        if (!atual->vinculoRepetido) {
+            delta -= atual->tamanho.load();
+            deltaAlocado -= atual->alocado.load();
+        }
+    }
+
+    std::shared_ptr<Nodo> novo;
+    if (ehArquivo) {
+        novo = std::make_shared<Nodo>();
+        novo->caminho = caminho;
+        novo->nome = nome;
+        MetadadosArquivo m = metadadosArquivo(st);
+        novo->tipo = "arquivo";
+        novo->tamanho = m.tamanho;
+        novo->alocado = m.alocado;
+        novo->vinculo = m.vinculo;
+        if (m.vinculo != 0) registrarVinculo(novo.get(), pasta);
+    } else if (ehPasta) {
+        // Mesmos limites, com a profundidade contada a partir da raiz
+        OpcoesVarredura sub = opcoes;
+        sub.threads = 1;
+        if (opcoes.profundidadeMaxima >= 0) {
+            sub.profundidadeMaxima = std::max(0, opcoes.profundidadeMaxima - nivelDe(pasta) - 1);
+        }
+        EstatisticasVarredura estatisticasSub;
+        novo = construirArvore(caminho, sub, &estatisticasSub);
+        for (const auto& e : estatisticasSub.erros.listar()) {
+            std::cerr << "[AVISO] Não foi possível ler " << e.caminho << ": "
+                      << std::generic_category().message(e.codigo) << "\n";
+        }
+        if (novo && novo->tipo == "pasta") vigiarSubarvore(novo, pasta, &lote);
+    }
+    if (novo) {
+        delta += novo->tamanho.load();
+        deltaAlocado += novo->alocado.load();
+        std::unique_lock<std::shared_mutex> lock(travaFilhos(*pasta));
+        filhos.push_back(novo);
+    }
+    if (delta != 0 || deltaAlocado != 0) propagar(pasta, delta, deltaAlocado);
+
+    // Com os totais já coerentes com as marcas atuais, a regra do menor
+    // caminho é refeita para os inodes que ganharam ou perderam links
+    ajustarVinculos();
+}
+
+// ----------------------------------------------------------------------------
+// Coloca no lote todas as entradas da pasta (no disco e na árvore), para que
+// sejam conferidas uma a uma
+// ----------------------------------------------------------------------------
+void ObservadorArvore::ressincronizar(int wd, Lote& lote) {
+    auto it = vigias.find(wd);
+    if (it == vigias.end()) return;
+    const Nodo* pasta = it->second.pasta.get();
+
+    std::vector<EntradaLida> entradas;
+    ContadoresLeitura cont;
+    if (listarDiretorio(opcoes.backend, pasta->caminho, entradas, cont) != ResultadoLeitura::Lida) {
+        return;                                   // Pasta sumiu: o pai cuidará dela
+    }
+    for (const auto& entrada : entradas) lote[{wd, entrada.nome}];
+    for (const auto& filho : pasta->filhos) lote[{wd, filho->nome}];
+}
+
+// ----------------------------------------------------------------------------
+// Cria vigias para a pasta e suas subpastas. Uma pasta que não pode ser
+// vigiada (sem permissão ou limite max_user_watches) é pulada com toda a
+// subárvore, para que toda pasta vigiada tenha os ancestrais vigiados.
+// Com "lote", cada pasta nova é ressincronizada: entradas criadas entre a
+// varredura e a criação da vigia não se perdem.
+// ----------------------------------------------------------------------------
+void ObservadorArvore::vigiarSubarvore(const std::shared_ptr<Nodo>& pasta, Nodo* pai,
+                                       Lote* lote) {
+    std::vector<std::pair<std::shared_ptr<Nodo>, Nodo*>> pilha;
+    pilha.emplace_back(pasta, pai);
+    while (!pilha.empty()) {
+        auto [nodo, paiNodo] = std::move(pilha.back());
+        pilha.pop_back();
+        if (nodo->podada) continue;                 // Conteúdo fora da árvore
+
+        int wd = inotify_add_watch(descritor, nodo->caminho.c_str(), MASCARA_VIGIA);
+        if (wd < 0) {
+            if (errno == ENOSPC && !avisouLimite) {
+                std::cerr << "[AVISO] Limite de vigias do inotify atingido "
+                             "(fs.inotify.max_user_watches); parte da árvore não "
+                             "será atualizada.\n";
+                avisouLimite = true;
+            }
+            continue;
+        }
+
+        // O mesmo inode já vigiado (pasta movida ainda não conciliada na
+        // origem) devolve o mesmo wd: a vigia passa para o nó novo
+        auto existente = vigias.find(wd);
+        if (existente != vigias.end()) {
+            wdDe.erase(existente->second.pasta.get());
+        } else {
+            estat.pastasVigiadas.fetch_add(1, std::memory_order_relaxed);
+        }
+        vigias[wd] = Vigia{nodo, paiNodo};
+        wdDe[nodo.get()] = wd;
+        if (lote) ressincronizar(wd, *lote);
+
+        for (const auto& filho : nodo->filhos) {
+            if (filho->tipo == "pasta") {
+                pilha.emplace_back(filho, nodo.get());
+            } else if (filho->vinculo != 0) {
+                registrarVinculo(filho.get(), nodo.get());
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Remove as vigias e os links físicos de uma subárvore que saiu da árvore
+// ----------------------------------------------------------------------------
+void ObservadorArvore::esquecerSubarvore(const Nodo* pasta) {
+    std::vector<const Nodo*> pilha{pasta};
+    while (!pilha.empty()) {
+        const Nodo* nodo = pilha.back();
+        pilha.pop_back();
+
+        auto it = wdDe.find(nodo);
+        if (it != wdDe.end()) {
+            inotify_rm_watch(descritor, it->second);   // Pode já ter sido removida
+            vigias.erase(it->second);
+            wdDe.erase(it);
+            estat.pastasVigiadas.fetch_sub(1, std::memory_order_relaxed);
+        }
+        for (const auto& filho : nodo->filhos) {
+            if (filho->tipo == "pasta") {
+                pilha.push_back(filho.get());
+            } else if (filho->vinculo != 0) {
+                retirarVinculo(filho.get());
+            }
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Sobe pelas vigias até a raiz
+// ----------------------------------------------------------------------------
+int ObservadorArvore::nivelDe(const Nodo* pasta) const {
+    int nivel = 0;
+    while (pasta && pasta != raiz.get()) {
+        auto it = wdDe.find(pasta);
+        if (it == wdDe.end()) break;
+        pasta = vigias.at(it->second).pai;
+        ++nivel;
+    }
+    return nivel;
+}
+
+// ----------------------------------------------------------------------------
+// Soma os deltas à pasta e a todos os ancestrais. Reduções chegam como o
+// complemento (aritmética sem sinal), então fetch_add serve para ambos.
+// ----------------------------------------------------------------------------
+void ObservadorArvore::propagar(Nodo* pasta, uintmax_t delta, uintmax_t deltaAlocado) {
+    while (pasta) {
+        pasta->tamanho.fetch_add(delta, std::memory_order_relaxed);
+        pasta->alocado.fetch_add(deltaAlocado, std::memory_order_relaxed);
+        auto it = wdDe.find(pasta);
+        if (it == wdDe.end()) break;
+        pasta = vigias[it->second].pai;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Novo tamanho de um arquivo da pasta; só um link que conta altera os totais
+// ----------------------------------------------------------------------------
+void ObservadorArvore::atualizarTamanho(Nodo* arquivo, Nodo* pasta, const MetadadosArquivo& m) {
+    uintmax_t antigo = arquivo->tamanho.load();
+    uintmax_t antigoAlocado = arquivo->alocado.load();
+    if (m.tamanho == antigo && m.alocado == antigoAlocado) return;
+    arquivo->tamanho.store(m.tamanho);
+    arquivo->alocado.store(m.alocado);
+    if (!arquivo->vinculoRepetido) {
+        propagar(pasta, m.tamanho - antigo, m.alocado - antigoAlocado);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Mapa dos links físicos: cada entrada ou saída marca o inode, e
+// ajustarVinculos() refaz as marcas depois que os totais foram atualizados
+// ----------------------------------------------------------------------------
+void ObservadorArvore::registrarVinculo(Nodo* arquivo, Nodo* pasta) {
+    vinculos[arquivo->vinculo].push_back({arquivo, pasta});
+    vinculosAlterados.push_back(arquivo->vinculo);
+}
+
+void ObservadorArvore::retirarVinculo(Nodo* arquivo) {
+    auto it = vinculos.find(arquivo->vinculo);
+    if (it == vinculos.end()) return;
+    auto& links = it->second;
+    links.erase(std::remove_if(links.begin(), links.end(),
+                               [arquivo](const Vinculo& v) { return v.arquivo == arquivo; }),
+                links.end());
+    if (links.empty()) vinculos.erase(it);
+    vinculosAlterados.push_back(arquivo->vinculo);
+}
+
+// Passa a contar (ou deixa de contar) o link nos totais das pastas
+void ObservadorArvore::contarVinculo(const Vinculo& vinculo, bool contar) {
+    vinculo.arquivo->vinculoRepetido = !contar;
+    uintmax_t tamanho = vinculo.arquivo->tamanho.load();
+    uintmax_t alocado = vinculo.arquivo->alocado.load();
+    if (contar) {
+        propagar(vinculo.pasta, tamanho, alocado);
+    } else {
+        propagar(vinculo.pasta, 0 - tamanho, 0 - alocado);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Para cada inode alterado, só o link de menor caminho conta. Links em pastas
+// que já não são vigiadas (movidas e ainda não conciliadas na origem) não
+// são considerados: sem a vigia, os ancestrais deles não são alcançáveis, e
+// eles saem do mapa quando a pasta sai da árvore.
+// ----------------------------------------------------------------------------
+void ObservadorArvore::ajustarVinculos() {
+    std::sort(vinculosAlterados.begin(), vinculosAlterados.end());
+    vinculosAlterados.erase(std::unique(vinculosAlterados.begin(), vinculosAlterados.end()),
+                            vinculosAlterados.end());
+    for (uint64_t chave : vinculosAlterados) {
+        auto it = vinculos.find(chave);
+        if (it == vinculos.end()) continue;
+        const Vinculo* dono = nullptr;
+        for (const Vinculo& v : it->second) {
+            if (!wdDe.count(v.pasta)) continue;
+            if (!dono || v.arquivo->caminho < dono->arquivo->caminho) dono = &v;
+        }
+        for (const Vinculo& v : it->second) {
+            if (!wdDe.count(v.pasta)) continue;
+            bool repetido = &v != dono;
+            if (v.arquivo->vinculoRepetido != repetido) contarVinculo(v, !repetido);
+        }
+    }
+    vinculosAlterados.clear();
+}
+
+// ============================================================================
+// Função: imprimirEstatisticasObservador
+// ============================================================================
+void imprimirEstatisticasObservador(const EstatisticasObservador& estatisticas,
+                                    std::ostream& out) {
+    out << "[INFO] Observador: " << estatisticas.eventos.load() << " eventos em "
+        << estatisticas.lotes.load() << " lotes, "
+        << estatisticas.reconciliacoes.load() << " entradas conferidas, "
+        << estatisticas.estouros.load() << " estouros da fila\n";
+}
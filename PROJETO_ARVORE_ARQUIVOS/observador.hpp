@@ -0,0 +1,148 @@
+// ============================================================================
+// Arquivo: observador.hpp
+// Finalidade: Declarar o observador que mantém a árvore de Nodo atualizada
+//             enquanto o menu está aberto, aplicando em segundo plano os
+//             eventos do inotify (criação, remoção, alteração e movimentação).
+// ============================================================================
+#ifndef OBSERVADOR_HPP
+#define OBSERVADOR_HPP
+
+#include <atomic>                     // Contadores e sinal de parada
+#include <chrono>                     // Janela de agrupamento dos eventos
+#include <cstdint>                    // uint32_t, uint64_t
+#include <map>                        // Lote de eventos pendentes
+#include <memory>                     // std::shared_ptr
+#include <ostream>                    // Resumo final
+#include <string>                     // Nomes das entradas
+#include <thread>                     // Thread de observação
+#include <unordered_map>              // Vigias do inotify
+#include <utility>                    // std::pair
+#include <vector>                     // Links físicos de cada inode
+#include "nodo.hpp"                   // Estrutura de dados Nodo
+#include "varredura.hpp"              // OpcoesVarredura
+
+// ============================================================================
+// Estrutura: EstatisticasObservador
+// Objetivo: Contar o trabalho feito pelo observador (lidas ao final).
+// ============================================================================
+struct EstatisticasObservador {
+    std::atomic<uint64_t> eventos{0};         // Eventos recebidos do inotify
+    std::atomic<uint64_t> lotes{0};           // Lotes aplicados à árvore
+    std::atomic<uint64_t> reconciliacoes{0};  // Entradas conferidas (após agrupar)
+    std::atomic<uint64_t> estouros{0};        // Filas do kernel transbordadas
+    std::atomic<uint64_t> pastasVigiadas{0};  // Vigias ativas no momento
+};
+
+// ============================================================================
+// Classe: ObservadorArvore
+// Objetivo: Assinar o inotify para todas as pastas da árvore e aplicar as
+//           mudanças por uma thread própria, sem parar as consultas:
+//           - Os eventos são agrupados em lotes: após o primeiro evento, a
+//             thread continua lendo enquanto chegarem novos dentro da janela
+//             (limitada a 10 janelas). Eventos repetidos sobre a mesma entrada
+//             viram uma única conferência.
+//           - Cada entrada do lote é conferida com um lstat, e a árvore passa a
+//             refletir o estado atual (não a sequência de eventos): arquivos
+//             são criados, removidos ou têm o tamanho corrigido; pastas novas
+//             são varridas e passam a ser vigiadas.
+//           - A diferença de tamanho (aparente e alocado) é somada
+//             atomicamente à pasta e a todos os ancestrais, sem somar a
+//             árvore novamente.
+//           - Somente esta thread altera "filhos", sob travaFilhos exclusiva
+//             da pasta alterada; o percurso lê uma pasta por vez sob a
+//             compartilhada (veja nodo.hpp).
+//           - Os links físicos das pastas vigiadas ficam em um mapa por
+//             inode que cobre a árvore inteira. Quando um link entra ou sai
+//             (inclusive dentro de uma pasta movida ou criada, que é varrida
+//             à parte), a regra da varredura é refeita para o inode: só o
+//             link de menor caminho conta, e os que mudam de marca têm o
+//             tamanho somado ou retirado dos ancestrais.
+//           Se a fila do kernel transbordar, todas as pastas vigiadas são
+//           relidas e comparadas com a árvore.
+// Limitação: o fanotify não é usado, pois exige CAP_SYS_ADMIN; mudanças
+//           ocorridas entre o fim da varredura e iniciar() não são vistas.
+//           Um arquivo que tinha um único link na varredura só entra no mapa
+//           quando é conferido de novo (criar outro link para ele não gera
+//           evento na pasta dele); até lá, os dois links contam. Links em
+//           pastas que não puderam ser vigiadas ficam fora do mapa.
+// ============================================================================
+class ObservadorArvore {
+public:
+    // "opcoes" (backend e limites) valem para as pastas que surgirem durante
+    // a observação; pastas podadas pela varredura não são vigiadas
+    ObservadorArvore(std::shared_ptr<Nodo> raiz, OpcoesVarredura opcoes,
+                     std::chrono::milliseconds janela = std::chrono::milliseconds(50));
+
+    // Para a thread, se ainda estiver ativa
+    ~ObservadorArvore();
+
+    ObservadorArvore(const ObservadorArvore&) = delete;
+    ObservadorArvore& operator=(const ObservadorArvore&) = delete;
+
+    // Cria as vigias e inicia a thread. Retorna false se o inotify não estiver
+    // disponível (o erro é exibido no terminal).
+    bool iniciar();
+
+    // Pede o encerramento e aguarda a thread terminar
+    void parar();
+
+    const EstatisticasObservador& estatisticas() const { return estat; }
+
+private:
+    // Pasta vigiada: o nó e a pasta que o contém (nula para a raiz)
+    struct Vigia {
+        std::shared_ptr<Nodo> pasta;
+        Nodo* pai;
+    };
+
+    // Lote: (vigia, nome da entrada) -> máscara dos eventos recebidos
+    using Lote = std::map<std::pair<int, std::string>, uint32_t>;
+
+    // Link físico na árvore: o arquivo e a pasta que o contém
+    struct Vinculo {
+        Nodo* arquivo;
+        Nodo* pasta;
+    };
+
+    void laco();                                     // Corpo da thread
+    bool lerEventos(Lote& lote);                     // Esvazia o descritor
+    void aplicarLote(Lote& lote);                    // Concilia a árvore
+    void conciliar(int wd, const std::string& nome, uint32_t mascara, Lote& lote);
+    void ressincronizar(int wd, Lote& lote);         // Relê a pasta inteira
+    void vigiarSubarvore(const std::shared_ptr<Nodo>& pasta, Nodo* pai, Lote* lote);
+    void esquecerSubarvore(const Nodo* pasta);
+    int nivelDe(const Nodo* pasta) const;            // Profundidade (raiz = 0)
+    void propagar(Nodo* pasta, uintmax_t delta,      // Soma (módulo 2^N) aos ancestrais
+                  uintmax_t deltaAlocado);
+    void atualizarTamanho(Nodo* arquivo, Nodo* pasta, const MetadadosArquivo& m);
+    void registrarVinculo(Nodo* arquivo, Nodo* pasta);
+    void retirarVinculo(Nodo* arquivo);
+    void contarVinculo(const Vinculo& vinculo, bool contar);
+    void ajustarVinculos();                          // Refaz as marcas dos inodes alterados
+
+    std::shared_ptr<Nodo> raiz;
+    OpcoesVarredura opcoes;
+    std::chrono::milliseconds janela;
+
+    int descritor = -1;                              // inotify
+    int sinalParada = -1;                            // eventfd para acordar a thread
+    std::thread thread;
+    bool avisouLimite = false;                       // Aviso de max_user_watches já dado
+
+    // Só acessados pela thread do observador (ou antes de ela existir)
+    std::unordered_map<int, Vigia> vigias;           // wd -> pasta
+    std::unordered_map<const Nodo*, int> wdDe;       // pasta -> wd
+    std::unordered_map<uint64_t, std::vector<Vinculo>> vinculos;   // inode -> links
+    std::vector<uint64_t> vinculosAlterados;         // Inodes com links novos ou retirados
+
+    EstatisticasObservador estat;
+};
+
+// ============================================================================
+// Função: imprimirEstatisticasObservador
+// Objetivo: Escrever um resumo do trabalho do observador.
+// ============================================================================
+void imprimirEstatisticasObservador(const EstatisticasObservador& estatisticas,
+                                    std::ostream& out);
+
+#endif // OBSERVADOR_HPP
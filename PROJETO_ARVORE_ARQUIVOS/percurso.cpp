@@ -0,0 +1,280 @@
+// ============================================================================
+// Arquivo: percurso.cpp
+// Finalidade: Implementa o percurso em pré-ordem das duas representações da
+//             árvore, entregando cada nó a um VisitanteArvore.
+// ============================================================================
+#include "percurso.hpp"
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// Monta o InfoNodo de um Nodo (o número de filhos é lido sob a trava da pasta)
+// ----------------------------------------------------------------------------
+static InfoNodo infoDe(const Nodo& nodo, int nivel) {
+    bool pasta = (nodo.tipo == "pasta");
+    size_t numFilhos = 0;
+    if (pasta) {
+        std::shared_lock<std::shared_mutex> lock(travaFilhos(nodo));
+        numFilhos = nodo.filhos.size();
+    }
+    return InfoNodo{nodo.nome, nodo.caminho,
+                    pasta ? TipoNodo::Pasta : TipoNodo::Arquivo,
+                    nodo.tamanho.load(std::memory_order_relaxed),
+                    nodo.alocado.load(std::memory_order_relaxed), numFilhos, nivel,
+                    nodo.vinculoRepetido.load(std::memory_order_relaxed)};
+}
+
+// ----------------------------------------------------------------------------
+// Pré-ordem com pilha explícita de (nó, próximo filho a visitar), a partir de
+// um nó qualquer no nível "nivelInicial". Cada filho é obtido sob a trava
+// compartilhada da própria pasta, que é liberada em seguida: o observador
+// pode alterar outras pastas (ou esta, entre dois filhos) durante o percurso,
+// sem trava global. Os quadros guardam shared_ptr para que um nó removido no
+// meio do percurso continue válido até ser deixado.
+// ----------------------------------------------------------------------------
+static void percorrerSubarvore(const std::shared_ptr<Nodo>& inicio, int nivelInicial,
+                               VisitanteArvore& visitante) {
+    struct Quadro { std::shared_ptr<Nodo> nodo; size_t proximo; };
+    std::vector<Quadro> pilha;
+
+    visitante.entrar(infoDe(*inicio, nivelInicial));
+    if (inicio->tipo != "pasta") return;
+    pilha.push_back({inicio, 0});
+
+    while (!pilha.empty()) {
+        Quadro& topo = pilha.back();
+        int nivel = nivelInicial + static_cast<int>(pilha.size());
+
+        std::shared_ptr<Nodo> filho;
+        bool acabou;
+        {
+            std::shared_lock<std::shared_mutex> lock(travaFilhos(*topo.nodo));
+            acabou = topo.proximo >= topo.nodo->filhos.size();
+            if (!acabou) filho = topo.nodo->filhos[topo.proximo++];
+        }
+        if (acabou) {
+            visitante.sair(infoDe(*topo.nodo, nivel - 1));
+            pilha.pop_back();
+            continue;
+        }
+        if (!filho) continue;
+        visitante.entrar(infoDe(*filho, nivel));
+        if (filho->tipo == "pasta") {
+            pilha.push_back({std::move(filho), 0});   // "topo" deixa de ser válido aqui
+        }
+    }
+}
+
+// ============================================================================
+// Função: percorrerArvore (árvore de Nodo)
+// ============================================================================
+void percorrerArvore(const std::shared_ptr<Nodo>& raiz, VisitanteArvore& visitante) {
+    if (raiz) percorrerSubarvore(raiz, 0, visitante);
+}
+
+// ============================================================================
+// Função: pastaDe
+// ============================================================================
+std::string_view pastaDe(const InfoNodo& info) {
+    std::string_view c = info.caminho;
+    if (c.size() < info.nome.size()) return {};
+    c.remove_suffix(info.nome.size());
+    while (c.size() > 1 && c.back() == '/') c.remove_suffix(1);
+    return c;
+}
+
+// ============================================================================
+// Função: anexarNome
+// ============================================================================
+void anexarNome(std::string& caminho, std::string_view nome) {
+    if (!caminho.empty() && caminho.back() != '/') caminho += '/';
+    caminho.append(nome.data(), nome.size());
+}
+
+// ----------------------------------------------------------------------------
+// Pré-ordem seguindo primeiro filho / próximo irmão / pai, sem pilha de nós,
+// a partir do nó "inicio" no nível "nivelInicial". O caminho é mantido em um
+// único buffer: ao descer, o nome é anexado; ao passar ao irmão ou subir, o
+// buffer é truncado.
+// ----------------------------------------------------------------------------
+static void percorrerSubarvore(const ArvoreCompacta& arvore, uint32_t inicio, int nivelInicial,
+                               VisitanteArvore& visitante) {
+    std::string caminho = arvore.caminho(inicio);
+    std::vector<size_t> base;       // Comprimento do caminho de cada pasta aberta
+    uint32_t id = inicio;
+    int nivel = nivelInicial;
+
+    auto info = [&](uint32_t n) {
+        return InfoNodo{arvore.nome(n), caminho, arvore.tipo(n), arvore.tamanho(n),
+                        arvore.alocado(n), arvore.numFilhos(n), nivel,
+                        arvore.vinculoRepetido(n)};
+    };
+
+    while (true) {
+        visitante.entrar(info(id));
+        bool pasta = arvore.tipo(id) == TipoNodo::Pasta;
+        if (pasta && arvore.primeiroFilho(id) != ArvoreCompacta::NENHUM) {
+            base.push_back(caminho.size());
+            id = arvore.primeiroFilho(id);
+            ++nivel;
+            anexarNome(caminho, arvore.nome(id));
+            continue;
+        }
+        if (pasta) visitante.sair(info(id));
+
+        // Sobe até encontrar um irmão ainda não visitado
+        while (true) {
+            if (id == inicio) return;
+            caminho.resize(base.back());
+            uint32_t irmao = arvore.proximoIrmao(id);
+            if (irmao != ArvoreCompacta::NENHUM) {
+                id = irmao;
+                anexarNome(caminho, arvore.nome(id));
+                break;
+            }
+            base.pop_back();
+            id = arvore.pai(id);
+            --nivel;
+            visitante.sair(info(id));
+        }
+    }
+}
+
+// ============================================================================
+// Função: percorrerArvore (árvore compacta)
+// ============================================================================
+void percorrerArvore(const ArvoreCompacta& arvore, VisitanteArvore& visitante) {
+    if (!arvore.vazia()) percorrerSubarvore(arvore, arvore.raiz(), 0, visitante);
+}
+
+// ----------------------------------------------------------------------------
+// Divisão da árvore. A lista de itens começa com a raiz inteira; a cada
+// rodada, cada pasta inteira com filhos é trocada por ela mesma (só o nó) e
+// os filhos (inteiros), o que mantém a pré-ordem. Depois, os itens são
+// agrupados em partes que terminam em uma subárvore de pasta: nós isolados e
+// arquivos vão junto com a subárvore seguinte.
+// ----------------------------------------------------------------------------
+template <typename No>
+struct ItemDivisao {
+    No no;
+    int nivel;
+    bool inteiro;                   // Subárvore inteira (senão, só o nó)
+};
+
+template <typename No, typename EhPasta, typename Filhos>
+static std::vector<std::vector<ItemDivisao<No>>> dividirItens(No raiz, size_t desejadas,
+                                                             EhPasta ehPasta, Filhos filhos) {
+    constexpr int MAX_RODADAS = 16;
+    std::vector<ItemDivisao<No>> itens{{raiz, 0, true}};
+    size_t subarvores = ehPasta(raiz) ? 1 : 0;
+
+    for (int rodada = 0; rodada < MAX_RODADAS && subarvores < desejadas; ++rodada) {
+        std::vector<ItemDivisao<No>> novos;
+        bool desceu = false;
+        subarvores = 0;
+        for (auto& item : itens) {
+            std::vector<No> lista;
+            if (item.inteiro && ehPasta(item.no)) lista = filhos(item.no);
+            if (lista.empty()) {
+                if (item.inteiro && ehPasta(item.no)) ++subarvores;
+                novos.push_back(std::move(item));
+                continue;
+            }
+            desceu = true;
+            int nivel = item.nivel + 1;
+            novos.push_back({std::move(item.no), item.nivel, false});
+            for (auto& filho : lista) {
+                if (ehPasta(filho)) ++subarvores;
+                novos.push_back({std::move(filho), nivel, true});
+            }
+        }
+        itens.swap(novos);
+        if (!desceu) break;
+    }
+
+    std::vector<std::vector<ItemDivisao<No>>> partes;
+    std::vector<ItemDivisao<No>> atual;
+    for (auto& item : itens) {
+        bool fecha = item.inteiro && ehPasta(item.no);
+        atual.push_back(std::move(item));
+        if (fecha) {
+            partes.push_back(std::move(atual));
+            atual.clear();
+        }
+    }
+    if (!atual.empty()) {
+        if (partes.empty()) partes.emplace_back();
+        for (auto& item : atual) partes.back().push_back(std::move(item));
+    }
+    return partes;
+}
+
+// ============================================================================
+// Função: dividirArvore (árvore de Nodo)
+// ============================================================================
+PartesArvore dividirArvore(const std::shared_ptr<Nodo>& raiz, size_t partesDesejadas) {
+    using Item = ItemDivisao<std::shared_ptr<Nodo>>;
+    if (!raiz) return {0, [](size_t, VisitanteArvore&) {}};
+
+    auto partes = std::make_shared<std::vector<std::vector<Item>>>(dividirItens(
+        raiz, partesDesejadas,
+        [](const std::shared_ptr<Nodo>& n) { return n->tipo == "pasta"; },
+        [](const std::shared_ptr<Nodo>& n) {
+            std::vector<std::shared_ptr<Nodo>> lista;
+            std::shared_lock<std::shared_mutex> lock(travaFilhos(*n));
+            lista.reserve(n->filhos.size());
+            for (const auto& f : n->filhos) {
+                if (f) lista.push_back(f);
+            }
+            return lista;
+        }));
+    size_t quantidade = partes->size();
+    return {quantidade, [partes](size_t parte, VisitanteArvore& visitante) {
+        for (const Item& item : (*partes)[parte]) {
+            if (item.inteiro) {
+                percorrerSubarvore(item.no, item.nivel, visitante);
+            } else {
+                visitante.entrar(infoDe(*item.no, item.nivel));
+            }
+        }
+    }};
+}
+
+// ============================================================================
+// Função: dividirArvore (árvore compacta)
+// ============================================================================
+PartesArvore dividirArvore(const ArvoreCompacta& arvore, size_t partesDesejadas) {
+    using Item = ItemDivisao<uint32_t>;
+    if (arvore.vazia()) return {0, [](size_t, VisitanteArvore&) {}};
+
+    auto partes = std::make_shared<std::vector<std::vector<Item>>>(dividirItens(
+        arvore.raiz(), partesDesejadas,
+        [&arvore](uint32_t id) { return arvore.tipo(id) == TipoNodo::Pasta; },
+        [&arvore](uint32_t id) {
+            std::vector<uint32_t> lista;
+            lista.reserve(arvore.numFilhos(id));
+            for (uint32_t f = arvore.primeiroFilho(id); f != ArvoreCompacta::NENHUM;
+                 f = arvore.proximoIrmao(f)) {
+                lista.push_back(f);
+            }
+            return lista;
+        }));
+    size_t quantidade = partes->size();
+    const ArvoreCompacta* a = &arvore;
+    return {quantidade, [partes, a](size_t parte, VisitanteArvore& visitante) {
+        for (const Item& item : (*partes)[parte]) {
+            if (item.inteiro) {
+                percorrerSubarvore(*a, item.no, item.nivel, visitante);
+            } else {
+                std::string caminho = a->caminho(item.no);
+                visitante.entrar(InfoNodo{a->nome(item.no), caminho, a->tipo(item.no),
+                                          a->tamanho(item.no), a->alocado(item.no),
+                                          a->numFilhos(item.no), item.nivel,
+                                          a->vinculoRepetido(item.no)});
+            }
+        }
+    }};
+}
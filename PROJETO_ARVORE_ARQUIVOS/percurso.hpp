@@ -0,0 +1,91 @@
+// ============================================================================
+// Arquivo: percurso.hpp
+// Finalidade: Declarar um percurso único (em pré-ordem) sobre qualquer uma das
+//             representações da árvore. Exibição, exportação e pesquisas são
+//             escritas uma só vez como "visitantes" e funcionam tanto sobre a
+//             árvore de Nodo quanto sobre a ArvoreCompacta.
+// ============================================================================
+#ifndef PERCURSO_HPP
+#define PERCURSO_HPP
+
+#include <cstdint>                    // uintmax_t
+#include <functional>                 // std::function
+#include <memory>                     // std::shared_ptr
+#include <string>                     // anexarNome()
+#include <string_view>                // Nome e caminho sem cópia
+#include "nodo.hpp"                   // Árvore de Nodo
+#include "arvore_compacta.hpp"        // ArvoreCompacta e TipoNodo
+
+// ============================================================================
+// Estrutura: InfoNodo
+// Objetivo: Dados de um nó entregues ao visitante. Os string_view só são
+//           válidos durante a chamada (o caminho pode estar sendo montado em
+//           um buffer reaproveitado).
+// ============================================================================
+struct InfoNodo {
+    std::string_view nome;     // Nome simples
+    std::string_view caminho;  // Caminho completo
+    TipoNodo tipo;             // Arquivo ou pasta
+    uintmax_t tamanho;         // Bytes (soma dos filhos, se pasta)
+    uintmax_t alocado;         // Bytes ocupados em disco (idem)
+    size_t numFilhos;          // Filhos diretos (0 para arquivos)
+    int nivel;                 // Profundidade (a raiz é 0)
+    bool vinculoRepetido;      // Link físico cujo inode já é contado em outro
+                               // caminho: fica fora das somas de bytes
+};
+
+// Pasta que contém o nó: o caminho sem o nome e sem a '/' final (a raiz do
+// sistema, "/", fica como está)
+std::string_view pastaDe(const InfoNodo& info);
+
+// Anexa um nome ao caminho (sem separador duplicado), como nos percursos da
+// árvore compacta, que mantêm o caminho em um único buffer
+void anexarNome(std::string& caminho, std::string_view nome);
+
+// ============================================================================
+// Classe: VisitanteArvore
+// Objetivo: Receber os nós do percurso. "entrar" é chamado em pré-ordem para
+//           todos os nós; "sair" é chamado para as pastas depois dos filhos.
+// ============================================================================
+class VisitanteArvore {
+public:
+    virtual ~VisitanteArvore() = default;
+    virtual void entrar(const InfoNodo& info) = 0;
+    virtual void sair(const InfoNodo& /*info*/) {}
+};
+
+// Percorre a árvore de Nodo (pilha explícita, sem recursão)
+void percorrerArvore(const std::shared_ptr<Nodo>& raiz, VisitanteArvore& visitante);
+
+// Percorre a árvore compacta, montando os caminhos em um único buffer
+void percorrerArvore(const ArvoreCompacta& arvore, VisitanteArvore& visitante);
+
+// Forma genérica de "uma árvore que pode ser percorrida", usada pelos módulos
+// que aceitam as duas representações
+using Percurso = std::function<void(VisitanteArvore&)>;
+
+// ============================================================================
+// Estrutura: PartesArvore
+// Objetivo: A árvore cortada em partes independentes, que podem ser
+//           percorridas em paralelo. Cada parte é um trecho contíguo da
+//           pré-ordem: percorrer as partes 0..quantidade-1 em sequência
+//           entrega os mesmos nós, na mesma ordem, que o percurso inteiro.
+//           "sair" só é chamado para as pastas dentro de uma parte (as pastas
+//           acima do corte recebem apenas "entrar").
+// ============================================================================
+struct PartesArvore {
+    size_t quantidade = 0;
+    std::function<void(size_t parte, VisitanteArvore&)> percorrer;
+};
+
+// Corta a árvore descendo a partir da raiz, um nível por vez, até ter pelo
+// menos "partesDesejadas" subárvores de pastas (ou esgotar as pastas). Na
+// árvore de Nodo, as listas de filhos são lidas sob travaFilhos (nodo.hpp).
+PartesArvore dividirArvore(const std::shared_ptr<Nodo>& raiz, size_t partesDesejadas);
+PartesArvore dividirArvore(const ArvoreCompacta& arvore, size_t partesDesejadas);
+
+// Forma genérica de "uma árvore que pode ser dividida": a divisão é feita na
+// hora da consulta, então acompanha as alterações do observador
+using PercursoParalelo = std::function<PartesArvore(size_t partesDesejadas)>;
+
+#endif // PERCURSO_HPP
@@ -1,174 +1,147 @@
-// ============================================================================
-// Arquivo: pesquisas.hpp
-// Finalidade: Declaração das funções para executar buscas na árvore de arquivos
-// e apresentar ao usuário os resultados de acordo com critérios como maior arquivo,
-// arquivos acima de um determinado tamanho, etc.
-// ============================================================================
-#ifndef PESQUISAS_HPP
-#define PESQUISAS_HPP
-
-#include <memory>
-#include "nodo.hpp"
-
-// ============================================================================
-// Função: menuPesquisas
-// Objetivo: Exibir um menu de opções de pesquisa para o usuário, receber
-//          parâmetros (quando necessário) e chamar as funções de busca
-//          correspondentes.
-// Entrada: Ponteiro para o nó raiz da árvore de arquivos.
-// ============================================================================
-void menuPesquisas(const std::shared_ptr<Nodo>& raiz);
-
-#endif // PESQUISAS_HPP
-
-
-
 // ============================================================================
 // Arquivo: pesquisas.cpp
 // Finalidade: Implementação das funções de busca na árvore de arquivos,
 //            como encontrar o(s) maior(es) arquivo(s), arquivos maiores que
 //            um tamanho N, pasta com mais filhos, arquivos por extensão,
-//            e pastas vazias.
+//            pastas vazias, arquivos duplicados e filtros combinados.
 // ============================================================================
 #include "pesquisas.hpp"
+#include "percurso.hpp"
+#include "duplicados.hpp"
 #include <iostream>
-#include <vector>
-#include <algorithm>
-#include <filesystem>
-
-namespace fs = std::filesystem;
+#include <limits>
+#include <string>
 
 // ----------------------------------------------------------------------------
-// Função auxiliar: recolhe todos os nós de arquivos na árvore
+// 1. Maior(es) arquivo(s) — prefixo do índice por tamanho
 // ----------------------------------------------------------------------------
-static void coletarArquivos(const std::shared_ptr<Nodo>& nodo,
-                             std::vector<std::shared_ptr<Nodo>>& arquivos) {
-    if (!nodo) return;
-    if (nodo->tipo == "arquivo") {
-        arquivos.push_back(nodo);
-    } else {
-        for (const auto& filho : nodo->filhos) {
-            coletarArquivos(filho, arquivos);
-        }
-    }
-}
-
-// ----------------------------------------------------------------------------
-// Função auxiliar: recolhe todas as pastas na árvore
-// ----------------------------------------------------------------------------
-static void coletarPastas(const std::shared_ptr<Nodo>& nodo,
-                           std::vector<std::shared_ptr<Nodo>>& pastas) {
-    if (!nodo) return;
-    if (nodo->tipo == "pasta") {
-        pastas.push_back(nodo);
-        for (const auto& filho : nodo->filhos) {
-            coletarPastas(filho, pastas);
-        }
-    }
-}
-
-// ----------------------------------------------------------------------------
-// 1. Maior(es) arquivo(s)
-// ----------------------------------------------------------------------------
-static void buscarMaiorArquivo(const std::shared_ptr<Nodo>& raiz) {
-    std::vector<std::shared_ptr<Nodo>> arquivos;
-    coletarArquivos(raiz, arquivos);
-    if (arquivos.empty()) {
+static void buscarMaiorArquivo(IndicesPesquisa& indices) {
+    FaixaIndice maiores = indices.maioresArquivos();
+    if (maiores.empty()) {
         std::cout << "Nenhum arquivo encontrado.\n";
         return;
     }
-    // Encontra o tamanho máximo
-    uintmax_t maxTam = 0;
-    for (const auto& a : arquivos) {
-        if (a->tamanho > maxTam) maxTam = a->tamanho;
-    }
-    // Lista todos com tamanho == maxTam
+    // Lista todos com o tamanho máximo
     std::cout << "Maior(es) arquivo(s):\n";
-    for (const auto& a : arquivos) {
-        if (a->tamanho == maxTam) {
-            std::cout << a->caminho << " (" << a->tamanho << " bytes)\n";
-        }
+    for (const auto& a : maiores) {
+        std::cout << a.caminho << " (" << a.tamanho << " bytes, "
+                  << a.alocado << " em disco)\n";
     }
 }
 
 // ----------------------------------------------------------------------------
-// 2. Arquivos com mais do que N bytes
+// 2. Arquivos com mais do que N bytes (do maior para o menor)
 // ----------------------------------------------------------------------------
-static void buscarArquivosMaiorQue(const std::shared_ptr<Nodo>& raiz) {
+static void buscarArquivosMaiorQue(IndicesPesquisa& indices) {
     std::cout << "Informe o valor de N (bytes): ";
     uintmax_t N;
     std::cin >> N;
-    std::vector<std::shared_ptr<Nodo>> arquivos;
-    coletarArquivos(raiz, arquivos);
     std::cout << "Arquivos com mais do que N bytes (N=" << N << "):\n";
-    for (const auto& a : arquivos) {
-        if (a->tamanho > N) {
-            std::cout << a->caminho << " (" << a->tamanho << " bytes)\n";
-        }
+    for (const auto& a : indices.arquivosMaioresQue(N)) {
+        std::cout << a.caminho << " (" << a.tamanho << " bytes, "
+                  << a.alocado << " em disco)\n";
     }
 }
 
 // ----------------------------------------------------------------------------
 // 3. Pasta com mais filhos diretos
 // ----------------------------------------------------------------------------
-static void buscarPastaMaisArquivos(const std::shared_ptr<Nodo>& raiz) {
-    std::vector<std::shared_ptr<Nodo>> pastas;
-    coletarPastas(raiz, pastas);
-    if (pastas.empty()) {
+static void buscarPastaMaisArquivos(IndicesPesquisa& indices) {
+    size_t maxFilhos = 0;
+    FaixaIndice maiores = indices.pastasComMaisFilhos(maxFilhos);
+    if (maiores.empty()) {
         std::cout << "Nenhuma pasta encontrada.\n";
         return;
     }
-    // Encontra o número máximo de filhos
-    size_t maxFilhos = 0;
-    for (const auto& p : pastas) {
-        if (p->filhos.size() > maxFilhos) maxFilhos = p->filhos.size();
-    }
     // Lista todas as pastas com filhos == maxFilhos
     std::cout << "Pasta(s) com mais arquivos diretos:\n";
-    for (const auto& p : pastas) {
-        if (p->filhos.size() == maxFilhos) {
-            std::cout << p->caminho << " (" << p->filhos.size() << " filhos, "
-                      << p->tamanho << " bytes)\n";
-        }
+    for (const auto& p : maiores) {
+        std::cout << p.caminho << " (" << maxFilhos << " filhos, "
+                  << p.tamanho << " bytes, " << p.alocado << " em disco)\n";
     }
 }
 
 // ----------------------------------------------------------------------------
 // 4. Arquivos por extensão
 // ----------------------------------------------------------------------------
-static void buscarArquivosPorExtensao(const std::shared_ptr<Nodo>& raiz) {
+static void buscarArquivosPorExtensao(IndicesPesquisa& indices) {
     std::cout << "Informe a extensão (ex: .txt): ";
     std::string ext;
     std::cin >> ext;
-    std::vector<std::shared_ptr<Nodo>> arquivos;
-    coletarArquivos(raiz, arquivos);
     std::cout << "Arquivos por extensão (" << ext << "):\n";
-    for (const auto& a : arquivos) {
-        if (fs::path(a->caminho).extension() == ext) {
-            std::cout << a->caminho << " (" << a->tamanho << " bytes)\n";
-        }
+    for (const auto& a : indices.arquivosPorExtensao(ext)) {
+        std::cout << a.caminho << " (" << a.tamanho << " bytes, "
+                  << a.alocado << " em disco)\n";
     }
 }
 
 // ----------------------------------------------------------------------------
 // 5. Pastas vazias
 // ----------------------------------------------------------------------------
-static void buscarPastasVazias(const std::shared_ptr<Nodo>& raiz) {
-    std::vector<std::shared_ptr<Nodo>> pastas;
-    coletarPastas(raiz, pastas);
+static void buscarPastasVazias(IndicesPesquisa& indices) {
     std::cout << "Pastas vazias:\n";
-    for (const auto& p : pastas) {
-        if (p->filhos.empty()) {
-            std::cout << p->caminho << "\n";
+    for (const auto& p : indices.pastasVazias()) {
+        std::cout << p.caminho << "\n";
+    }
+}
+
+// ----------------------------------------------------------------------------
+// 6. Arquivos duplicados (grupos do maior desperdício para o menor)
+// ----------------------------------------------------------------------------
+static void buscarDuplicados(IndicesPesquisa& indices) {
+    EstatisticasDuplicados estatisticas;
+    const auto& grupos = indices.duplicados(&estatisticas);
+    if (grupos.empty()) {
+        std::cout << "Nenhum arquivo duplicado encontrado.\n";
+    } else {
+        uintmax_t total = 0;
+        std::cout << "Arquivos duplicados:\n";
+        for (const auto& g : grupos) {
+            std::cout << g.caminhos.size() << " cópias de " << g.tamanho << " bytes ("
+                      << g.desperdicio() << " bytes desperdiçados):\n";
+            for (const auto& caminho : g.caminhos) std::cout << "    " << caminho << "\n";
+            total += g.desperdicio();
         }
+        std::cout << "Total desperdiçado: " << total << " bytes em "
+                  << grupos.size() << " grupo(s)\n";
+    }
+    // Sem candidatos lidos agora, o resultado veio da consulta anterior
+    if (estatisticas.candidatos > 0) imprimirEstatisticasDuplicados(estatisticas, std::cout);
+}
+
+// ----------------------------------------------------------------------------
+// 7. Filtro combinado: a expressão inteira é avaliada em uma única passada
+// ----------------------------------------------------------------------------
+static void buscarPorFiltro(IndicesPesquisa& indices) {
+    std::cout << "Critérios: arquivo, pasta, vazia, tamanho/alocado/filhos/nivel OP N,\n"
+                 "ext = .EXT, nome = GLOB; combinados com e, ou, nao e parênteses.\n"
+                 "Ex.: arquivo e tamanho > 10M e (ext = .log ou ext = .gz)\n";
+    std::cout << "Informe o filtro: ";
+    std::string expressao;
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    std::getline(std::cin, expressao);
+
+    Filtro filtro;
+    std::string erro;
+    if (!filtro.compilar(expressao, &erro)) {
+        std::cout << "Filtro inválido: " << erro << "\n";
+        return;
+    }
+    FaixaIndice resultado = indices.filtrar(filtro);
+    uintmax_t total = 0;
+    for (const auto& e : resultado) {
+        std::cout << e.caminho << " (" << e.tamanho << " bytes, "
+                  << e.alocado << " em disco)\n";
+        total += e.tamanho;
     }
+    std::cout << resultado.size() << " nó(s), " << total << " bytes\n";
 }
 
 // ----------------------------------------------------------------------------
 // Função: menuPesquisas
 // Descrição: Exibe o submenu de pesquisas e chama cada função de busca.
 // ----------------------------------------------------------------------------
-void menuPesquisas(const std::shared_ptr<Nodo>& raiz) {
+void menuPesquisas(IndicesPesquisa& indices) {
     int opc;
     do {
         std::cout << "\n--- MENU DE PESQUISAS ---\n";
@@ -177,18 +150,35 @@ void menuPesquisas(const std::shared_ptr<Nodo>& raiz) {
         std::cout << "3. Pasta com mais arquivos diretos\n";
         std::cout << "4. Arquivos por extensão\n";
         std::cout << "5. Pastas vazias\n";
+        std::cout << "6. Arquivos duplicados\n";
+        std::cout << "7. Filtro combinado\n";
         std::cout << "0. Voltar\n";
         std::cout << "Escolha uma opção: ";
         std::cin >> opc;
 
         switch (opc) {
-            case 1: buscarMaiorArquivo(raiz); break;
-            case 2: buscarArquivosMaiorQue(raiz); break;
-            case 3: buscarPastaMaisArquivos(raiz); break;
-            case 4: buscarArquivosPorExtensao(raiz); break;
-            case 5: buscarPastasVazias(raiz); break;
+            case 1: buscarMaiorArquivo(indices); break;
+            case 2: buscarArquivosMaiorQue(indices); break;
+            case 3: buscarPastaMaisArquivos(indices); break;
+            case 4: buscarArquivosPorExtensao(indices); break;
+            case 5: buscarPastasVazias(indices); break;
+            case 6: buscarDuplicados(indices); break;
+            case 7: buscarPorFiltro(indices); break;
             case 0: std::cout << "Retornando ao menu principal...\n"; break;
             default: std::cout << "Opção inválida! Tente novamente.\n";
         }
     } while (opc != 0);
 }
+
+// Sem índices compartilhados: valem só enquanto o submenu estiver aberto
+void menuPesquisas(const std::shared_ptr<Nodo>& raiz) {
+    IndicesPesquisa indices([&](VisitanteArvore& v) { percorrerArvore(raiz, v); }, {},
+                            [&](size_t partes) { return dividirArvore(raiz, partes); });
+    menuPesquisas(indices);
+}
+
+void menuPesquisas(const ArvoreCompacta& arvore) {
+    IndicesPesquisa indices([&](VisitanteArvore& v) { percorrerArvore(arvore, v); }, {},
+                            [&](size_t partes) { return dividirArvore(arvore, partes); });
+    menuPesquisas(indices);
+}
@@ -7,6 +7,8 @@
 //              3) Pasta com mais arquivos diretos
 //              4) Arquivos por extensão
 //              5) Pastas vazias
+//              6) Arquivos duplicados
+//              7) Filtro combinado (vários critérios em uma passada)
 // ============================================================================
 
 #ifndef PESQUISAS_HPP
@@ -14,6 +16,8 @@
 
 #include <memory>
 #include "nodo.hpp"   // para std::shared_ptr<Nodo>
+#include "arvore_compacta.hpp"   // para ArvoreCompacta
+#include "indices.hpp"   // para IndicesPesquisa
 
 // ======================================
 // Exibe o submenu de pesquisas e chama as
@@ -22,4 +26,12 @@
 // ======================================
 void menuPesquisas(const std::shared_ptr<Nodo>& raiz);
 
+// Mesmo submenu, sobre a representação compacta da árvore
+void menuPesquisas(const ArvoreCompacta& arvore);
+
+// Mesmo submenu, reaproveitando índices já montados (ex.: em uma chamada
+// anterior): as consultas por tamanho, extensão e pastas vazias só percorrem
+// a árvore na primeira vez em que cada índice é usado
+void menuPesquisas(IndicesPesquisa& indices);
+
 #endif // PESQUISAS_HPP
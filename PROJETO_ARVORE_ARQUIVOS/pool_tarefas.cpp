@@ -0,0 +1,130 @@
+// ============================================================================
+// Arquivo: pool_tarefas.cpp
+// Finalidade: Implementa o pool de threads com roubo de tarefas.
+// ============================================================================
+#include "pool_tarefas.hpp"
+
+// Identifica, em cada thread, a qual pool ela pertence e qual é a sua fila.
+// Threads externas (ex.: a thread principal) ficam com poolAtual == nullptr.
+static thread_local const PoolTarefas* poolAtual = nullptr;
+static thread_local unsigned indiceAtual = 0;
+
+PoolTarefas::PoolTarefas(unsigned numThreads) {
+    if (numThreads == 0) {
+        numThreads = std::thread::hardware_concurrency();
+        if (numThreads == 0) numThreads = 1;
+    }
+    for (unsigned i = 0; i < numThreads; ++i) {
+        filas.push_back(std::make_unique<Fila>());
+    }
+    for (unsigned i = 0; i < numThreads; ++i) {
+        threads.emplace_back(&PoolTarefas::laco, this, i);
+    }
+}
+
+PoolTarefas::~PoolTarefas() {
+    {
+        std::lock_guard<std::mutex> lock(travaSinal);
+        encerrar = true;
+    }
+    sinalTarefa.notify_all();
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Submete uma tarefa: fila local quando chamada por uma thread do pool,
+// rodízio entre as filas quando chamada de fora.
+// ----------------------------------------------------------------------------
+void PoolTarefas::submeter(std::function<void()> tarefa) {
+    unsigned indice = (poolAtual == this)
+        ? indiceAtual
+        : proximaFila.fetch_add(1, std::memory_order_relaxed) % filas.size();
+
+    pendentes.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(filas[indice]->trava);
+        filas[indice]->tarefas.push_back(std::move(tarefa));
+    }
+    {
+        // O incremento sob a trava evita que uma thread durma sem ver a tarefa
+        std::lock_guard<std::mutex> lock(travaSinal);
+        naoIniciadas.fetch_add(1);
+    }
+    sinalTarefa.notify_one();
+}
+
+// ----------------------------------------------------------------------------
+// Retira uma tarefa: primeiro do fim da fila local; se vazia, rouba do início
+// das filas das demais threads, começando pela vizinha.
+// ----------------------------------------------------------------------------
+bool PoolTarefas::obterTarefa(unsigned indice, std::function<void()>& t) {
+    {
+        Fila& local = *filas[indice];
+        std::lock_guard<std::mutex> lock(local.trava);
+        if (!local.tarefas.empty()) {
+            t = std::move(local.tarefas.back());
+            local.tarefas.pop_back();
+            naoIniciadas.fetch_sub(1);
+            return true;
+        }
+    }
+    for (size_t passo = 1; passo < filas.size(); ++passo) {
+        Fila& vitima = *filas[(indice + passo) % filas.size()];
+        std::lock_guard<std::mutex> lock(vitima.trava);
+        if (!vitima.tarefas.empty()) {
+            t = std::move(vitima.tarefas.front());
+            vitima.tarefas.pop_front();
+            naoIniciadas.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+// Laço de cada thread: executa tarefas enquanto houver; dorme caso contrário.
+// ----------------------------------------------------------------------------
+void PoolTarefas::laco(unsigned indice) {
+    poolAtual = this;
+    indiceAtual = indice;
+
+    std::function<void()> tarefa;
+    while (true) {
+        if (obterTarefa(indice, tarefa)) {
+            try {
+                tarefa();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(travaErro);
+                if (!primeiroErro) primeiroErro = std::current_exception();
+            }
+            tarefa = nullptr;
+            if (pendentes.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(travaSinal);
+                sinalFim.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(travaSinal);
+        sinalTarefa.wait(lock, [this] { return encerrar || naoIniciadas.load() > 0; });
+        if (encerrar) return;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Aguarda todas as tarefas terminarem e propaga a primeira exceção.
+// ----------------------------------------------------------------------------
+void PoolTarefas::esperar() {
+    {
+        std::unique_lock<std::mutex> lock(travaSinal);
+        sinalFim.wait(lock, [this] { return pendentes.load() == 0; });
+    }
+    std::lock_guard<std::mutex> lock(travaErro);
+    if (primeiroErro) {
+        std::exception_ptr erro = primeiroErro;
+        primeiroErro = nullptr;
+        std::rethrow_exception(erro);
+    }
+}
@@ -0,0 +1,77 @@
+// ============================================================================
+// Arquivo: pool_tarefas.hpp
+// Finalidade: Declarar um pool de threads com roubo de tarefas (work-stealing),
+//             usado para distribuir o trabalho da varredura entre vários núcleos.
+// ============================================================================
+#ifndef POOL_TAREFAS_HPP
+#define POOL_TAREFAS_HPP
+
+#include <atomic>                     // Contadores compartilhados entre threads
+#include <condition_variable>         // Espera de threads ociosas
+#include <deque>                      // Fila dupla de tarefas de cada thread
+#include <exception>                  // std::exception_ptr
+#include <functional>                 // std::function para representar tarefas
+#include <memory>                     // std::unique_ptr
+#include <mutex>                      // Proteção das filas
+#include <thread>                     // std::thread
+#include <vector>                     // Conjunto de filas e de threads
+
+// ============================================================================
+// Classe: PoolTarefas
+// Objetivo: Executar tarefas em paralelo. Cada thread possui sua própria fila:
+//           retira tarefas do fim da fila local (LIFO, boa localidade) e, quando
+//           ela esvazia, "rouba" tarefas do início da fila das outras threads.
+//           Tarefas podem submeter novas tarefas (ex.: um subdiretório).
+// ============================================================================
+class PoolTarefas {
+public:
+    // Cria o pool com numThreads threads (0 = número de núcleos disponíveis)
+    explicit PoolTarefas(unsigned numThreads);
+
+    // Aguarda o término das threads (as tarefas pendentes são descartadas)
+    ~PoolTarefas();
+
+    PoolTarefas(const PoolTarefas&) = delete;
+    PoolTarefas& operator=(const PoolTarefas&) = delete;
+
+    // Enfileira uma tarefa. Se chamada de dentro de uma thread do pool, a
+    // tarefa vai para a fila local; caso contrário, é distribuída em rodízio.
+    void submeter(std::function<void()> tarefa);
+
+    // Bloqueia até que todas as tarefas submetidas (inclusive as geradas por
+    // outras tarefas) terminem. Relança a primeira exceção ocorrida, se houver.
+    void esperar();
+
+    // Número de threads do pool
+    unsigned tamanho() const { return static_cast<unsigned>(threads.size()); }
+
+    // Tarefas submetidas e ainda não concluídas (aproximado; para progresso)
+    size_t tarefasPendentes() const { return pendentes.load(std::memory_order_relaxed); }
+
+private:
+    // Fila de uma thread, protegida por seu próprio mutex
+    struct Fila {
+        std::mutex trava;
+        std::deque<std::function<void()>> tarefas;
+    };
+
+    void laco(unsigned indice);                                  // Corpo de cada thread
+    bool obterTarefa(unsigned indice, std::function<void()>& t); // Fila local ou roubo
+
+    std::vector<std::unique_ptr<Fila>> filas;
+    std::vector<std::thread> threads;
+
+    std::atomic<size_t> pendentes{0};     // Tarefas submetidas e ainda não concluídas
+    std::atomic<size_t> naoIniciadas{0};  // Tarefas nas filas aguardando execução
+    std::atomic<unsigned> proximaFila{0}; // Rodízio para submissões externas
+
+    std::mutex travaSinal;                // Protege a espera das condições abaixo
+    std::condition_variable sinalTarefa;  // Há tarefa nova (ou encerramento)
+    std::condition_variable sinalFim;     // Todas as tarefas terminaram
+    bool encerrar = false;
+
+    std::mutex travaErro;
+    std::exception_ptr primeiroErro;      // Primeira exceção lançada por uma tarefa
+};
+
+#endif // POOL_TAREFAS_HPP
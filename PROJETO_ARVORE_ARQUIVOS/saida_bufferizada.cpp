@@ -0,0 +1,188 @@
+// ============================================================================
+// Arquivo: saida_bufferizada.cpp
+// Finalidade: Implementa a saída com buffer usada pelas exportações.
+// ============================================================================
+#include "saida_bufferizada.hpp"
+#include <algorithm>                    // std::min
+#include <cerrno>
+#include <charconv>                     // std::to_chars
+#include <iostream>                     // Erro de abertura, std::cout
+
+#include <fcntl.h>                     // open
+#include <unistd.h>                    // write, close
+
+// ============================================================================
+// Construtores / destrutor
+// ============================================================================
+SaidaBufferizada::SaidaBufferizada(const std::string& nomeArquivo, size_t capacidade)
+    : buffer(capacidade < 64 ? 64 : capacidade), proprio(true) {
+    fd = ::open(nomeArquivo.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) primeiroErro = errno;
+}
+
+SaidaBufferizada::SaidaBufferizada(int descritor, size_t capacidade)
+    : buffer(capacidade < 64 ? 64 : capacidade), fd(descritor) {}
+
+SaidaBufferizada::~SaidaBufferizada() {
+    fechar();
+}
+
+// ============================================================================
+// Método: descarregar
+// Objetivo: Escrever o buffer inteiro, repetindo write() em escritas parciais.
+// ============================================================================
+void SaidaBufferizada::descarregar() {
+    size_t enviado = 0;
+    while (fd >= 0 && enviado < usado && primeiroErro == 0) {
+        ssize_t n = ::write(fd, buffer.data() + enviado, usado - enviado);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            primeiroErro = errno;
+            break;
+        }
+        enviado += static_cast<size_t>(n);
+    }
+    usado = 0;
+}
+
+// Texto maior que o espaço livre: completa o buffer e segue em blocos
+void SaidaBufferizada::escreverLongo(std::string_view texto) {
+    while (!texto.empty()) {
+        if (usado == buffer.size()) descarregar();
+        size_t parte = std::min(texto.size(), buffer.size() - usado);
+        std::memcpy(buffer.data() + usado, texto.data(), parte);
+        usado += parte;
+        texto.remove_prefix(parte);
+    }
+}
+
+// ============================================================================
+// Método: escreverNumero
+// ============================================================================
+void SaidaBufferizada::escreverNumero(uintmax_t valor) {
+    constexpr size_t MAX_DIGITOS = 20;             // 2^64 - 1 tem 20 dígitos
+    if (buffer.size() - usado < MAX_DIGITOS) descarregar();
+    char* inicio = buffer.data() + usado;
+    auto resultado = std::to_chars(inicio, inicio + MAX_DIGITOS, valor);
+    usado += static_cast<size_t>(resultado.ptr - inicio);
+}
+
+// ============================================================================
+// Método: escreverHtml
+// Objetivo: Copiar os trechos sem caracteres especiais de uma vez e trocar os
+//           especiais por suas entidades.
+// ============================================================================
+void SaidaBufferizada::escreverHtml(std::string_view texto) {
+    size_t inicio = 0;
+    for (size_t i = 0; i < texto.size(); ++i) {
+        std::string_view entidade;
+        switch (texto[i]) {
+            case '&':  entidade = "&amp;";  break;
+            case '<':  entidade = "&lt;";   break;
+            case '>':  entidade = "&gt;";   break;
+            case '"':  entidade = "&quot;"; break;
+            case '\'': entidade = "&#39;";  break;
+            default:   continue;
+        }
+        escrever(texto.substr(inicio, i - inicio));
+        escrever(entidade);
+        inicio = i + 1;
+    }
+    escrever(texto.substr(inicio));
+}
+
+// ============================================================================
+// Método: escreverJson
+// Objetivo: Escapar aspas, barra invertida e caracteres de controle. Bytes
+//           acima de 0x7F são copiados como estão (nomes em UTF-8).
+// ============================================================================
+void SaidaBufferizada::escreverJson(std::string_view texto) {
+    static const char HEX[] = "0123456789abcdef";
+    size_t inicio = 0;
+    for (size_t i = 0; i < texto.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(texto[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+        escrever(texto.substr(inicio, i - inicio));
+        switch (c) {
+            case '"':  escrever("\\\""); break;
+            case '\\': escrever("\\\\"); break;
+            case '\n': escrever("\\n"); break;
+            case '\r': escrever("\\r"); break;
+            case '\t': escrever("\\t"); break;
+            default: {
+                char u[6] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF]};
+                escrever(std::string_view(u, sizeof(u)));
+            }
+        }
+        inicio = i + 1;
+    }
+    escrever(texto.substr(inicio));
+}
+
+// ============================================================================
+// Método: escreverCsv
+// ============================================================================
+void SaidaBufferizada::escreverCsv(std::string_view texto) {
+    if (texto.find_first_of(",\"\r\n") == std::string_view::npos) {
+        escrever(texto);
+        return;
+    }
+    escrever('"');
+    size_t inicio = 0;
+    for (size_t pos; (pos = texto.find('"', inicio)) != std::string_view::npos; ) {
+        escrever(texto.substr(inicio, pos + 1 - inicio));   // Inclui a aspa...
+        escrever('"');                                       // ...e a dobra
+        inicio = pos + 1;
+    }
+    escrever(texto.substr(inicio));
+    escrever('"');
+}
+
+// ============================================================================
+// Método: escreverCampo
+// ============================================================================
+void SaidaBufferizada::escreverCampo(std::string_view texto) {
+    size_t inicio = 0;
+    for (size_t pos; (pos = texto.find_first_of("\t\n\r\\", inicio)) != std::string_view::npos; ) {
+        escrever(texto.substr(inicio, pos - inicio));
+        switch (texto[pos]) {
+            case '\t': escrever("\\t"); break;
+            case '\n': escrever("\\n"); break;
+            case '\r': escrever("\\r"); break;
+            default:   escrever("\\\\"); break;
+        }
+        inicio = pos + 1;
+    }
+    escrever(texto.substr(inicio));
+}
+
+// ============================================================================
+// Método: fechar
+// ============================================================================
+bool SaidaBufferizada::fechar(std::string* erro) {
+    descarregar();
+    if (proprio && fd >= 0) {
+        if (::close(fd) != 0 && primeiroErro == 0) primeiroErro = errno;
+    }
+    fd = -1;
+    if (primeiroErro != 0 && erro) *erro = std::strerror(primeiroErro);
+    return primeiroErro == 0;
+}
+
+// ============================================================================
+// Função: abrirSaida
+// ============================================================================
+std::unique_ptr<SaidaBufferizada> abrirSaida(const std::string& nomeArquivo) {
+    std::unique_ptr<SaidaBufferizada> saida;
+    if (nomeArquivo == "-") {
+        std::cout.flush();
+        saida = std::make_unique<SaidaBufferizada>(1);
+    } else {
+        saida = std::make_unique<SaidaBufferizada>(nomeArquivo);
+    }
+    if (!saida->aberta()) {
+        std::cerr << "[ERRO] Não foi possível criar o arquivo: " << nomeArquivo << "\n";
+        return nullptr;
+    }
+    return saida;
+}
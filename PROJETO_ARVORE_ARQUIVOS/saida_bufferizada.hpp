@@ -0,0 +1,106 @@
+// ============================================================================
+// Arquivo: saida_bufferizada.hpp
+// Finalidade: Declarar uma saída com buffer grande e explícito, usada pelas
+//             exportações: o texto é acumulado em memória e enviado ao arquivo
+//             em blocos, com uma chamada write() por bloco e nenhuma alocação
+//             por nó escrito.
+// ============================================================================
+#ifndef SAIDA_BUFFERIZADA_HPP
+#define SAIDA_BUFFERIZADA_HPP
+
+#include <cstddef>                    // size_t
+#include <cstdint>                    // uintmax_t
+#include <cstring>                    // std::memcpy
+#include <memory>                     // std::unique_ptr
+#include <string>                     // Nome do arquivo
+#include <string_view>                // Texto a escrever
+#include <vector>                     // Buffer
+
+// ============================================================================
+// Classe: SaidaBufferizada
+// Objetivo: Escrever em um descritor de arquivo através de um buffer de
+//           tamanho fixo. Erros de escrita são guardados (errno) e consultados
+//           ao final com fechar(), para não testar a cada nó.
+// ============================================================================
+class SaidaBufferizada {
+public:
+    static constexpr size_t CAPACIDADE_PADRAO = size_t(1) << 20;   // 1 MiB
+
+    // Cria (ou trunca) o arquivo; verifique com aberta()
+    explicit SaidaBufferizada(const std::string& nomeArquivo,
+                              size_t capacidade = CAPACIDADE_PADRAO);
+
+    // Usa um descritor já aberto (ex.: 1 = saída padrão), sem fechá-lo
+    explicit SaidaBufferizada(int descritor, size_t capacidade = CAPACIDADE_PADRAO);
+
+    // Descarrega o que restar (e fecha o arquivo, se foi aberto aqui)
+    ~SaidaBufferizada();
+
+    SaidaBufferizada(const SaidaBufferizada&) = delete;
+    SaidaBufferizada& operator=(const SaidaBufferizada&) = delete;
+
+    bool aberta() const { return fd >= 0; }
+
+    void escrever(char c) {
+        if (usado == buffer.size()) descarregar();
+        buffer[usado++] = c;
+    }
+
+    void escrever(std::string_view texto) {
+        if (texto.size() > buffer.size() - usado) {
+            escreverLongo(texto);
+            return;
+        }
+        std::memcpy(buffer.data() + usado, texto.data(), texto.size());
+        usado += texto.size();
+    }
+
+    // Número decimal, convertido direto no buffer (std::to_chars)
+    void escreverNumero(uintmax_t valor);
+
+    // Dados binários (sem conversão)
+    void escreverBytes(const void* dados, size_t bytes) {
+        if (bytes > 0) escrever(std::string_view(static_cast<const char*>(dados), bytes));
+    }
+
+    // Texto com &, <, >, " e ' escapados para HTML
+    void escreverHtml(std::string_view texto);
+
+    // Conteúdo de uma string JSON (sem as aspas): ", \ e controles escapados
+    void escreverJson(std::string_view texto);
+
+    // Campo CSV (RFC 4180): entre aspas, com aspas dobradas, só se preciso
+    void escreverCsv(std::string_view texto);
+
+    // Campo de uma linha separada por TAB: TAB, quebras de linha e barra
+    // invertida viram \t, \n, \r e \\ (nenhum outro byte muda)
+    void escreverCampo(std::string_view texto);
+
+    // Envia o conteúdo do buffer ao descritor
+    void descarregar();
+
+    // Descarrega, fecha (se aberto aqui) e informa se tudo foi escrito.
+    // "erro" recebe a descrição do primeiro erro, se houver.
+    bool fechar(std::string* erro = nullptr);
+
+private:
+    void escreverLongo(std::string_view texto);
+
+    std::vector<char> buffer;
+    size_t usado = 0;
+    int fd = -1;
+    bool proprio = false;              // O descritor foi aberto por esta classe?
+    int primeiroErro = 0;              // errno da primeira falha
+};
+
+// ============================================================================
+// Função: abrirSaida
+// Objetivo: Abrir o destino de uma exportação: "-" é a saída padrão (o que
+//           estiver pendente em std::cout é enviado antes); outro nome cria
+//           ou trunca o arquivo.
+// Retorno: a saída, ou nulo se o arquivo não pôde ser criado (o erro é
+//          exibido no terminal)
+// ============================================================================
+std::unique_ptr<SaidaBufferizada> abrirSaida(const std::string& nomeArquivo);
+
+#endif // SAIDA_BUFFERIZADA_HPP
@@ -0,0 +1,254 @@
+// ============================================================================
+// Arquivo: serializadores.cpp
+// Finalidade: Implementa os formatos de saída da árvore sobre o percurso
+//             comum e a SaidaBufferizada.
+// ============================================================================
+#include "serializadores.hpp"
+#include <iostream>
+
+// Nome do tipo como aparece nas exportações
+static std::string_view nomeTipo(TipoNodo tipo) {
+    return tipo == TipoNodo::Pasta ? "pasta" : "arquivo";
+}
+
+// ============================================================================
+// Função: formatoPorNome
+// ============================================================================
+bool formatoPorNome(std::string_view nome, FormatoSaida& formato) {
+    if (nome == "terminal")     formato = FormatoSaida::Terminal;
+    else if (nome == "html")    formato = FormatoSaida::Html;
+    else if (nome == "jsonl")   formato = FormatoSaida::JsonLinhas;
+    else if (nome == "csv")     formato = FormatoSaida::Csv;
+    else if (nome == "colunar") formato = FormatoSaida::Colunar;
+    else return false;
+    return true;
+}
+
+// ============================================================================
+// Terminal: 4 espaços por nível, "├── nome (...)"
+// ============================================================================
+void SerializadorTerminal::recuar(int nivel) {
+    static constexpr std::string_view ESPACOS = "                                ";
+    for (size_t falta = static_cast<size_t>(nivelBase + nivel) * 4; falta > 0; ) {
+        size_t parte = falta < ESPACOS.size() ? falta : ESPACOS.size();
+        out.escrever(ESPACOS.substr(0, parte));
+        falta -= parte;
+    }
+}
+
+void SerializadorTerminal::entrar(const InfoNodo& info) {
+    recuar(info.nivel);
+    out.escrever("├── ");
+    out.escrever(info.nome);
+    out.escrever(" (");
+    if (info.tipo == TipoNodo::Pasta) {
+        out.escreverNumero(info.numFilhos);
+        out.escrever(" filhos, ");
+    }
+    out.escreverNumero(info.tamanho);
+    out.escrever(" bytes, ");
+    out.escreverNumero(info.alocado);
+    out.escrever(" em disco)\n");
+}
+
+void SerializadorTerminal::resumo(int nivel, size_t ocultos, uintmax_t bytes) {
+    recuar(nivel);
+    out.escrever("└── ... ");
+    out.escreverNumero(ocultos);
+    out.escrever(" mais (");
+    out.escreverNumero(bytes);
+    out.escrever(" bytes)\n");
+}
+
+// ============================================================================
+// HTML: cada pasta é um <details> (recolhido, exceto a raiz) e cada arquivo
+// uma linha. O recuo vem do aninhamento no CSS, portanto nada é montado por
+// nó: nomes são escapados direto no buffer.
+// ============================================================================
+void SerializadorHtml::iniciar() {
+    out.escrever("<!DOCTYPE html>\n<html lang=\"pt-BR\">\n<head>\n"
+                 "  <meta charset=\"UTF-8\">\n"
+                 "  <title>Árvore de Arquivos</title>\n"
+                 "  <style>\n"
+                 "    body { font-family: monospace; }\n"
+                 "    details > details, details > div { margin-left: 1.5em; }\n"
+                 "    summary { cursor: pointer; }\n"
+                 "  </style>\n"
+                 "</head>\n<body>\n");
+}
+
+void SerializadorHtml::entrar(const InfoNodo& info) {
+    if (info.tipo == TipoNodo::Arquivo) {
+        out.escrever("<div>");
+        out.escreverHtml(info.nome);
+        out.escrever(" (");
+        out.escreverNumero(info.tamanho);
+        out.escrever(" bytes, ");
+        out.escreverNumero(info.alocado);
+        out.escrever(" em disco)</div>\n");
+    } else {
+        out.escrever(info.nivel == 0 ? "<details open><summary>" : "<details><summary>");
+        out.escreverHtml(info.nome);
+        out.escrever(" (");
+        out.escreverNumero(info.numFilhos);
+        out.escrever(" filhos, ");
+        out.escreverNumero(info.tamanho);
+        out.escrever(" bytes, ");
+        out.escreverNumero(info.alocado);
+        out.escrever(" em disco)</summary>\n");
+    }
+}
+
+void SerializadorHtml::sair(const InfoNodo&) {
+    out.escrever("</details>\n");
+}
+
+void SerializadorHtml::terminar() {
+    out.escrever("</body>\n</html>\n");
+}
+
+// ============================================================================
+// JSON Lines
+// ============================================================================
+void SerializadorJsonLinhas::entrar(const InfoNodo& info) {
+    out.escrever("{\"caminho\":\"");
+    out.escreverJson(info.caminho);
+    out.escrever("\",\"nome\":\"");
+    out.escreverJson(info.nome);
+    out.escrever("\",\"tipo\":\"");
+    out.escrever(nomeTipo(info.tipo));
+    out.escrever("\",\"tamanho\":");
+    out.escreverNumero(info.tamanho);
+    out.escrever(",\"alocado\":");
+    out.escreverNumero(info.alocado);
+    out.escrever(",\"nivel\":");
+    out.escreverNumero(static_cast<uintmax_t>(info.nivel));
+    out.escrever(info.vinculoRepetido ? ",\"vinculo_repetido\":true}\n"
+                                      : ",\"vinculo_repetido\":false}\n");
+}
+
+// ============================================================================
+// CSV
+// ============================================================================
+void SerializadorCsv::iniciar() {
+    out.escrever("caminho,nome,tipo,tamanho,alocado,nivel,vinculo_repetido\n");
+}
+
+void SerializadorCsv::entrar(const InfoNodo& info) {
+    out.escreverCsv(info.caminho);
+    out.escrever(',');
+    out.escreverCsv(info.nome);
+    out.escrever(',');
+    out.escrever(nomeTipo(info.tipo));
+    out.escrever(',');
+    out.escreverNumero(info.tamanho);
+    out.escrever(',');
+    out.escreverNumero(info.alocado);
+    out.escrever(',');
+    out.escreverNumero(static_cast<uintmax_t>(info.nivel));
+    out.escrever(info.vinculoRepetido ? ",1\n" : ",0\n");
+}
+
+// ============================================================================
+// Colunar: as colunas de um bloco são acumuladas e gravadas juntas
+// ============================================================================
+static void completarAte8(SaidaBufferizada& out, size_t bytes) {
+    static const char zeros[8] = {};
+    out.escreverBytes(zeros, (8 - bytes % 8) % 8);
+}
+
+template <typename T>
+static void escreverColuna(SaidaBufferizada& out, const std::vector<T>& coluna) {
+    out.escreverBytes(coluna.data(), coluna.size() * sizeof(T));
+}
+
+void SerializadorColunar::escreverCabecalho(std::string_view caminhoRaiz) {
+    const char magica[8] = {'A', 'R', 'V', 'C', 'O', 'L', '1', '\0'};
+    uint32_t campos[4] = {VERSAO, 0x01020304u, static_cast<uint32_t>(caminhoRaiz.size()), 0};
+    out.escreverBytes(magica, sizeof(magica));
+    out.escreverBytes(campos, sizeof(campos));
+    out.escrever(caminhoRaiz);
+    completarAte8(out, caminhoRaiz.size());
+    cabecalhoEscrito = true;
+}
+
+void SerializadorColunar::entrar(const InfoNodo& info) {
+    // O cabeçalho leva o caminho da raiz, o primeiro nó do percurso
+    if (!cabecalhoEscrito) escreverCabecalho(info.caminho);
+
+    tamanhos.push_back(info.tamanho);
+    alocados.push_back(info.alocado);
+    niveis.push_back(static_cast<uint32_t>(info.nivel));
+    nomes.append(info.nome.data(), info.nome.size());
+    fimNomes.push_back(static_cast<uint32_t>(nomes.size()));
+    tipos.push_back(info.tipo == TipoNodo::Pasta ? 1 : 0);
+    if (tamanhos.size() == LINHAS_POR_BLOCO) escreverBloco();
+}
+
+void SerializadorColunar::escreverBloco() {
+    uint32_t n = static_cast<uint32_t>(tamanhos.size());
+    uint32_t cabecalho[2] = {n, static_cast<uint32_t>(nomes.size())};
+    out.escreverBytes(cabecalho, sizeof(cabecalho));
+    escreverColuna(out, tamanhos);
+    escreverColuna(out, alocados);
+    escreverColuna(out, niveis);
+    escreverColuna(out, fimNomes);
+    escreverColuna(out, tipos);
+    out.escrever(nomes);
+    completarAte8(out, tipos.size() + nomes.size());   // Colunas anteriores já alinhadas
+
+    tamanhos.clear();
+    alocados.clear();
+    niveis.clear();
+    fimNomes.clear();
+    tipos.clear();
+    nomes.clear();
+}
+
+void SerializadorColunar::terminar() {
+    if (!cabecalhoEscrito) escreverCabecalho({});     // Árvore vazia
+    if (!tamanhos.empty()) escreverBloco();
+    escreverBloco();                                   // Bloco vazio: fim
+}
+
+// ============================================================================
+// Função: criarSerializador
+// ============================================================================
+std::unique_ptr<Serializador> criarSerializador(FormatoSaida formato, SaidaBufferizada& out) {
+    switch (formato) {
+        case FormatoSaida::Terminal:   return std::make_unique<SerializadorTerminal>(out);
+        case FormatoSaida::Html:       return std::make_unique<SerializadorHtml>(out);
+        case FormatoSaida::JsonLinhas: return std::make_unique<SerializadorJsonLinhas>(out);
+        case FormatoSaida::Csv:        return std::make_unique<SerializadorCsv>(out);
+        case FormatoSaida::Colunar:    return std::make_unique<SerializadorColunar>(out);
+    }
+    return nullptr;
+}
+
+// ============================================================================
+// Função: serializarArvore
+// ============================================================================
+void serializarArvore(const Percurso& percorrer, Serializador& serializador) {
+    serializador.iniciar();
+    percorrer(serializador);
+    serializador.terminar();
+}
+
+// ============================================================================
+// Função: exportarArvore
+// ============================================================================
+bool exportarArvore(const Percurso& percorrer, FormatoSaida formato,
+                    const std::string& nomeArquivo) {
+    auto out = abrirSaida(nomeArquivo);
+    if (!out) return false;
+
+    auto serializador = criarSerializador(formato, *out);
+    serializarArvore(percorrer, *serializador);
+
+    std::string erro;
+    if (!out->fechar(&erro)) {
+        std::cerr << "[ERRO] Falha ao gravar " << nomeArquivo << ": " << erro << "\n";
+        return false;
+    }
+    return true;
+}
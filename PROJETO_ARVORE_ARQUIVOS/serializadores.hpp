@@ -0,0 +1,138 @@
+// ============================================================================
+// Arquivo: serializadores.hpp
+// Finalidade: Declarar a camada de serialização da árvore. Um serializador é
+//             um visitante do percurso que escreve cada nó em uma
+//             SaidaBufferizada; terminal, HTML, JSON Lines, CSV e o formato
+//             binário colunar compartilham o mesmo percurso e a mesma saída.
+// ============================================================================
+#ifndef SERIALIZADORES_HPP
+#define SERIALIZADORES_HPP
+
+#include <cstdint>                    // Colunas do formato binário
+#include <memory>                     // std::unique_ptr
+#include <string>                     // Nome do arquivo e dos nomes do lote
+#include <string_view>                // Nome do formato
+#include <vector>                     // Colunas do formato binário
+#include "percurso.hpp"               // VisitanteArvore, Percurso
+#include "saida_bufferizada.hpp"      // SaidaBufferizada
+
+// ============================================================================
+// Enumeração: FormatoSaida
+// ============================================================================
+enum class FormatoSaida { Terminal, Html, JsonLinhas, Csv, Colunar };
+
+// Converte "terminal", "html", "jsonl", "csv" ou "colunar"; false se desconhecido
+bool formatoPorNome(std::string_view nome, FormatoSaida& formato);
+
+// ============================================================================
+// Classe: Serializador
+// Objetivo: Base dos formatos. iniciar() e terminar() escrevem o que vem
+//           antes e depois dos nós (cabeçalho, rodapé, último bloco).
+// ============================================================================
+class Serializador : public VisitanteArvore {
+public:
+    explicit Serializador(SaidaBufferizada& out) : out(out) {}
+    virtual void iniciar() {}
+    virtual void terminar() {}
+
+protected:
+    SaidaBufferizada& out;
+};
+
+// Texto recuado, como a opção "Exibir a árvore" sempre mostrou
+class SerializadorTerminal : public Serializador {
+public:
+    SerializadorTerminal(SaidaBufferizada& out, int nivelBase = 0)
+        : Serializador(out), nivelBase(nivelBase) {}
+    void entrar(const InfoNodo& info) override;
+
+    // Linha "... N mais (T bytes)" no lugar dos filhos omitidos de uma pasta
+    void resumo(int nivel, size_t ocultos, uintmax_t bytes);
+
+private:
+    void recuar(int nivel);
+
+    int nivelBase;
+};
+
+// Documento HTML com pastas recolhíveis (<details>)
+class SerializadorHtml : public Serializador {
+public:
+    using Serializador::Serializador;
+    void iniciar() override;
+    void entrar(const InfoNodo& info) override;
+    void sair(const InfoNodo& info) override;
+    void terminar() override;
+};
+
+// Um objeto JSON por linha: caminho, nome, tipo, tamanho, alocado, nivel,
+// vinculo_repetido (link físico cujo inode já é contado em outro caminho)
+class SerializadorJsonLinhas : public Serializador {
+public:
+    using Serializador::Serializador;
+    void entrar(const InfoNodo& info) override;
+};
+
+// CSV (RFC 4180) com cabeçalho: caminho,nome,tipo,tamanho,alocado,nivel,
+// vinculo_repetido (0 ou 1)
+class SerializadorCsv : public Serializador {
+public:
+    using Serializador::Serializador;
+    void iniciar() override;
+    void entrar(const InfoNodo& info) override;
+};
+
+// ============================================================================
+// Classe: SerializadorColunar
+// Objetivo: Formato binário em colunas, na ordem de bytes da máquina:
+//   - Cabeçalho (24 bytes): mágica "ARVCOL1\0", versão (u32), marca de ordem
+//     de bytes 0x01020304 (u32), bytes do caminho da raiz (u32), preenchimento
+//     (u32); segue o caminho da raiz, completado até múltiplo de 8.
+//   - Blocos de até LINHAS_POR_BLOCO nós em pré-ordem: número de nós (u32),
+//     bytes de nomes (u32), tamanho[n] (u64), alocado[n] (u64, a partir da
+//     versão 2), nivel[n] (u32), fimNome[n] (u32,
+//     fim de cada nome no bloco de nomes), tipo[n] (u8: 0 = arquivo,
+//     1 = pasta), nomes; cada bloco é completado até múltiplo de 8.
+//   - Um bloco com 0 nós encerra o arquivo.
+//   O caminho de cada nó não é gravado: em pré-ordem ele é o caminho do último
+//   nó de nível "nivel - 1" seguido do nome (a raiz é o caminho do cabeçalho).
+//   A memória usada é a de um bloco, independentemente do tamanho da árvore.
+// ============================================================================
+class SerializadorColunar : public Serializador {
+public:
+    static constexpr uint32_t LINHAS_POR_BLOCO = 65536;
+    static constexpr uint32_t VERSAO = 2;          // v2: coluna "alocado"
+
+    using Serializador::Serializador;
+    void entrar(const InfoNodo& info) override;
+    void terminar() override;
+
+private:
+    void escreverCabecalho(std::string_view caminhoRaiz);
+    void escreverBloco();
+
+    bool cabecalhoEscrito = false;
+    std::vector<uint64_t> tamanhos;
+    std::vector<uint64_t> alocados;
+    std::vector<uint32_t> niveis;
+    std::vector<uint32_t> fimNomes;
+    std::vector<uint8_t> tipos;
+    std::string nomes;
+};
+
+// Cria o serializador de um formato, escrevendo em "out"
+std::unique_ptr<Serializador> criarSerializador(FormatoSaida formato, SaidaBufferizada& out);
+
+// Percorre a árvore entregando os nós ao serializador (iniciar/nós/terminar)
+void serializarArvore(const Percurso& percorrer, Serializador& serializador);
+
+// ============================================================================
+// Função: exportarArvore
+// Objetivo: Gravar a árvore em "nomeArquivo" ("-" = saída padrão) no formato
+//           pedido.
+// Retorno: true se o arquivo foi gravado (erros são exibidos no terminal)
+// ============================================================================
+bool exportarArvore(const Percurso& percorrer, FormatoSaida formato,
+                    const std::string& nomeArquivo);
+
+#endif // SERIALIZADORES_HPP
@@ -0,0 +1,251 @@
+// ============================================================================
+// Arquivo: snapshot.cpp
+// Finalidade: Implementa a gravação do snapshot binário e o carregamento por
+//             mapeamento em memória (mmap).
+// ============================================================================
+#include "snapshot.hpp"
+#include <cstddef>              // offsetof
+#include <cstring>              // std::memcmp, std::memcpy
+#include <fstream>              // Gravação
+#include <iostream>             // Mensagens de erro
+#include <memory>
+#include <vector>
+
+#include <fcntl.h>              // open
+#include <sys/mman.h>           // mmap, munmap
+#include <sys/stat.h>           // fstat
+#include <unistd.h>             // close
+
+static const char MAGICA[8] = {'A', 'R', 'V', 'S', 'N', 'A', 'P', '\0'};
+static const uint32_t VERSAO = 3;         // v2: assinatura; v3: alocado e vínculo
+static const uint32_t VERSAO_MINIMA = 1;
+static const uint32_t MARCA_ENDIAN = 0x01020304u;
+
+// Seções do arquivo, na ordem em que são gravadas
+enum SecaoSnapshot : uint32_t {
+    SEC_PAI, SEC_PRIMEIRO_FILHO, SEC_PROXIMO_IRMAO, SEC_NUM_FILHOS, SEC_NOME_ID,
+    SEC_TAMANHO, SEC_TIPO, SEC_NOME_INICIO, SEC_NOMES, SEC_CAMINHO_RAIZ,
+    SEC_ASSINATURA,                       // A partir da versão 2
+    SEC_ALOCADO, SEC_VINCULO,             // A partir da versão 3
+    NUM_SECOES
+};
+static const uint32_t NUM_SECOES_V1 = SEC_ASSINATURA;
+static const uint32_t NUM_SECOES_V2 = SEC_ALOCADO;
+
+struct Secao {
+    uint64_t deslocamento;
+    uint64_t bytes;
+};
+
+struct Cabecalho {
+    char     magica[8];
+    uint32_t versao;
+    uint32_t marcaEndian;
+    uint32_t numNodos;
+    uint32_t numNomes;
+    uint64_t bytesNomes;
+    uint32_t numSecoes;
+    uint32_t reservado;
+    Secao    secoes[NUM_SECOES];
+};
+
+static uint64_t alinhar8(uint64_t valor) {
+    return (valor + 7) & ~uint64_t(7);
+}
+
+// ============================================================================
+// Função: salvarSnapshot
+// ============================================================================
+bool salvarSnapshot(const ArvoreCompacta& arvore, const std::string& nomeArquivo) {
+    ArvoreCompacta::Vetores v = arvore.vetores();
+    const std::string& raiz = arvore.caminhoRaiz();
+    uint64_t n = v.numNodos;
+
+    // Origem e tamanho de cada seção
+    const void* origem[NUM_SECOES] = {
+        v.pai, v.primeiroFilho, v.proximoIrmao, v.numFilhos, v.nomeId,
+        v.tamanho, v.tipo, v.nomeInicio, v.nomes, raiz.data(), v.assinatura,
+        v.alocado, v.vinculo
+    };
+    uint64_t bytes[NUM_SECOES] = {
+        n * 4, n * 4, n * 4, n * 4, n * 4,
+        n * 8, n, n ? (uint64_t(v.numNomes) + 1) * 4 : 0, v.bytesNomes, raiz.size(),
+        n * 8, n * 8, n * 8
+    };
+    std::vector<uint64_t> zerados;          // Vetor ausente: grava zeros
+    if (!v.assinatura || !v.vinculo) {
+        zerados.assign(n, 0);
+        if (!v.assinatura) origem[SEC_ASSINATURA] = zerados.data();
+        if (!v.vinculo) origem[SEC_VINCULO] = zerados.data();
+    }
+    if (!v.alocado) origem[SEC_ALOCADO] = v.tamanho;    // Como em alocado()
+
+    Cabecalho cab{};
+    std::memcpy(cab.magica, MAGICA, sizeof(MAGICA));
+    cab.versao = VERSAO;
+    cab.marcaEndian = MARCA_ENDIAN;
+    cab.numNodos = v.numNodos;
+    cab.numNomes = v.numNomes;
+    cab.bytesNomes = v.bytesNomes;
+    cab.numSecoes = NUM_SECOES;
+    uint64_t posicao = alinhar8(sizeof(Cabecalho));
+    for (uint32_t s = 0; s < NUM_SECOES; ++s) {
+        cab.secoes[s] = {posicao, bytes[s]};
+        posicao = alinhar8(posicao + bytes[s]);
+    }
+
+    std::ofstream out(nomeArquivo, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "[ERRO] Não foi possível criar o arquivo: " << nomeArquivo << "\n";
+        return false;
+    }
+
+    static const char zeros[8] = {};
+    out.write(reinterpret_cast<const char*>(&cab), sizeof(cab));
+    out.write(zeros, alinhar8(sizeof(cab)) - sizeof(cab));
+    for (uint32_t s = 0; s < NUM_SECOES; ++s) {
+        if (bytes[s] > 0) {
+            out.write(static_cast<const char*>(origem[s]), bytes[s]);
+        }
+        out.write(zeros, alinhar8(bytes[s]) - bytes[s]);
+    }
+    out.close();
+    if (!out) {
+        std::cerr << "[ERRO] Falha ao gravar o snapshot: " << nomeArquivo << "\n";
+        return false;
+    }
+
+    std::cerr << "[OK] Snapshot gravado: " << nomeArquivo << " ("
+              << v.numNodos << " nós)\n";
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Confere os índices dos vetores antes de aceitar o arquivo (uma passada
+// linear): um índice corrompido faria a árvore ler fora do mapeamento. Como os
+// nós estão em pré-ordem, o pai vem antes do nó e o primeiro filho e o próximo
+// irmão vêm depois dele, o que também impede ciclos nos percursos.
+// ----------------------------------------------------------------------------
+static bool validarVetores(const ArvoreCompacta::Vetores& v) {
+    const uint32_t NENHUM = ArvoreCompacta::NENHUM;
+    uint32_t n = v.numNodos;
+    if (n == 0) return true;
+    if (v.pai[0] != NENHUM) return false;
+    for (uint32_t id = 0; id < n; ++id) {
+        if (id > 0 && v.pai[id] >= id) return false;
+        if (v.primeiroFilho[id] != NENHUM &&
+            (v.primeiroFilho[id] <= id || v.primeiroFilho[id] >= n)) return false;
+        if (v.proximoIrmao[id] != NENHUM &&
+            (v.proximoIrmao[id] <= id || v.proximoIrmao[id] >= n)) return false;
+        if (v.numFilhos[id] >= n || v.nomeId[id] >= v.numNomes) return false;
+        if (v.tipo[id] > static_cast<uint8_t>(TipoNodo::Pasta)) return false;
+    }
+    if (v.nomeInicio[0] != 0) return false;
+    for (uint32_t i = 0; i < v.numNomes; ++i) {
+        if (v.nomeInicio[i] > v.nomeInicio[i + 1]) return false;
+    }
+    return v.nomeInicio[v.numNomes] == v.bytesNomes;
+}
+
+// ============================================================================
+// Função: carregarSnapshot
+// Objetivo: Validar o cabeçalho e a tabela de seções (tamanhos coerentes com o
+//           número de nós e dentro do arquivo), conferir os índices dos
+//           vetores e apontar a árvore para elas.
+// ============================================================================
+bool carregarSnapshot(const std::string& nomeArquivo, ArvoreCompacta& arvore) {
+    int fd = ::open(nomeArquivo.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "[ERRO] Não foi possível abrir o snapshot: " << nomeArquivo << "\n";
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<uint64_t>(st.st_size) < offsetof(Cabecalho, secoes)) {
+        ::close(fd);
+        std::cerr << "[ERRO] Snapshot inválido (muito pequeno): " << nomeArquivo << "\n";
+        return false;
+    }
+    size_t tamanhoArquivo = static_cast<size_t>(st.st_size);
+    void* endereco = ::mmap(nullptr, tamanhoArquivo, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);                        // O mapeamento continua válido
+    if (endereco == MAP_FAILED) {
+        std::cerr << "[ERRO] Falha no mmap do snapshot: " << nomeArquivo << "\n";
+        return false;
+    }
+    // O munmap ocorre quando a última cópia da árvore é liberada
+    std::shared_ptr<const void> mapa(endereco, [tamanhoArquivo](const void* p) {
+        ::munmap(const_cast<void*>(p), tamanhoArquivo);
+    });
+    const char* base = static_cast<const char*>(endereco);
+
+    const Cabecalho& cab = *reinterpret_cast<const Cabecalho*>(base);
+    if (std::memcmp(cab.magica, MAGICA, sizeof(MAGICA)) != 0) {
+        std::cerr << "[ERRO] Arquivo não é um snapshot: " << nomeArquivo << "\n";
+        return false;
+    }
+    if (cab.marcaEndian != MARCA_ENDIAN) {
+        std::cerr << "[ERRO] Snapshot gravado em máquina com outra ordem de bytes\n";
+        return false;
+    }
+    uint32_t secoesExigidas = (cab.versao >= 3) ? NUM_SECOES
+                            : (cab.versao == 2) ? NUM_SECOES_V2 : NUM_SECOES_V1;
+    if (cab.versao < VERSAO_MINIMA || cab.versao > VERSAO || cab.numSecoes < secoesExigidas) {
+        std::cerr << "[ERRO] Versão de snapshot não suportada: " << cab.versao << "\n";
+        return false;
+    }
+    // O cabeçalho das versões antigas é menor: a tabela só tem as suas seções
+    uint64_t bytesCabecalho = sizeof(Cabecalho) - (NUM_SECOES - secoesExigidas) * sizeof(Secao);
+    if (tamanhoArquivo < bytesCabecalho) {
+        std::cerr << "[ERRO] Snapshot inválido (muito pequeno): " << nomeArquivo << "\n";
+        return false;
+    }
+
+    // Tamanho esperado de cada seção a partir das contagens do cabeçalho
+    uint64_t n = cab.numNodos;
+    uint64_t esperado[NUM_SECOES] = {
+        n * 4, n * 4, n * 4, n * 4, n * 4,
+        n * 8, n, n ? (uint64_t(cab.numNomes) + 1) * 4 : 0, cab.bytesNomes,
+        cab.secoes[SEC_CAMINHO_RAIZ].bytes, n * 8, n * 8, n * 8
+    };
+    for (uint32_t s = 0; s < secoesExigidas; ++s) {
+        const Secao& sec = cab.secoes[s];
+        if (sec.bytes != esperado[s] || sec.deslocamento % 8 != 0 ||
+            sec.deslocamento > tamanhoArquivo ||
+            sec.bytes > tamanhoArquivo - sec.deslocamento) {
+            std::cerr << "[ERRO] Snapshot corrompido (seção " << s << "): "
+                      << nomeArquivo << "\n";
+            return false;
+        }
+    }
+
+    auto secao = [&](SecaoSnapshot s) { return base + cab.secoes[s].deslocamento; };
+    ArvoreCompacta::Vetores v;
+    v.numNodos = cab.numNodos;
+    v.numNomes = cab.numNomes;
+    v.bytesNomes = cab.bytesNomes;
+    v.pai           = reinterpret_cast<const uint32_t*>(secao(SEC_PAI));
+    v.primeiroFilho = reinterpret_cast<const uint32_t*>(secao(SEC_PRIMEIRO_FILHO));
+    v.proximoIrmao  = reinterpret_cast<const uint32_t*>(secao(SEC_PROXIMO_IRMAO));
+    v.numFilhos     = reinterpret_cast<const uint32_t*>(secao(SEC_NUM_FILHOS));
+    v.nomeId        = reinterpret_cast<const uint32_t*>(secao(SEC_NOME_ID));
+    v.tamanho       = reinterpret_cast<const uint64_t*>(secao(SEC_TAMANHO));
+    if (secoesExigidas > SEC_ASSINATURA) {
+        v.assinatura = reinterpret_cast<const uint64_t*>(secao(SEC_ASSINATURA));
+    }
+    if (secoesExigidas > SEC_VINCULO) {
+        v.alocado = reinterpret_cast<const uint64_t*>(secao(SEC_ALOCADO));
+        v.vinculo = reinterpret_cast<const uint64_t*>(secao(SEC_VINCULO));
+    }
+    v.tipo          = reinterpret_cast<const uint8_t*>(secao(SEC_TIPO));
+    v.nomeInicio    = reinterpret_cast<const uint32_t*>(secao(SEC_NOME_INICIO));
+    v.nomes         = secao(SEC_NOMES);
+
+    if (!validarVetores(v)) {
+        std::cerr << "[ERRO] Snapshot corrompido (índices inválidos): " << nomeArquivo << "\n";
+        return false;
+    }
+
+    std::string raiz(secao(SEC_CAMINHO_RAIZ), cab.secoes[SEC_CAMINHO_RAIZ].bytes);
+    arvore = ArvoreCompacta::deVetores(v, std::move(raiz), std::move(mapa));
+    return true;
+}
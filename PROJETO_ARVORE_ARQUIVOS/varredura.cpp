@@ -0,0 +1,603 @@
+// ============================================================================
+// Arquivo: varredura.cpp
+// Finalidade: Implementa a varredura paralela do sistema de arquivos usando o
+//             pool de threads com roubo de tarefas e os backends de leitura.
+// ============================================================================
+#include "varredura.hpp"
+#include "pool_tarefas.hpp"     // PoolTarefas
+#include "saida_bufferizada.hpp" // Relatório JSON
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <system_error>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+// ============================================================================
+// Classe: MapaVinculos
+// Objetivo: Conjunto concorrente dos inodes com mais de um link físico,
+//           dividido em fatias com trava própria (as tarefas raramente
+//           disputam a mesma fatia). Para cada inode, o link de menor caminho
+//           é o que conta nos totais; os demais são marcados como repetidos.
+//           A escolha não depende da ordem em que as threads chegam, então a
+//           árvore continua idêntica à da varredura serial.
+// ============================================================================
+class MapaVinculos {
+public:
+    // Registra um arquivo com vinculo != 0, que está na pasta "pasta"
+    void registrar(Nodo* arquivo, Nodo* pasta) {
+        Fatia& f = fatias[arquivo->vinculo % NUM_FATIAS];
+        std::lock_guard<std::mutex> lock(f.trava);
+        f.registros.push_back({arquivo, pasta, arquivo->vinculoRepetido});
+        auto [it, novo] = f.donos.emplace(arquivo->vinculo, arquivo);
+        if (novo) {
+            arquivo->vinculoRepetido = false;
+        } else if (arquivo->caminho < it->second->caminho) {
+            it->second->vinculoRepetido = true;
+            it->second = arquivo;
+            arquivo->vinculoRepetido = false;
+        } else {
+            arquivo->vinculoRepetido = true;
+        }
+    }
+
+    // Pastas com algum arquivo cuja marca mudou em relação à versão anterior
+    // (chamada depois que todas as tarefas terminaram)
+    template <typename Acao>
+    void paraCadaPastaAlterada(Acao acao) const {
+        for (const auto& f : fatias) {
+            for (const auto& r : f.registros) {
+                if (r.arquivo->vinculoRepetido != r.antes) acao(r.pasta);
+            }
+        }
+    }
+
+private:
+    static constexpr size_t NUM_FATIAS = 64;
+
+    struct Registro { Nodo* arquivo; Nodo* pasta; bool antes; };
+    struct Fatia {
+        std::mutex trava;
+        std::unordered_map<uint64_t, Nodo*> donos;
+        std::vector<Registro> registros;
+    };
+    std::array<Fatia, NUM_FATIAS> fatias;
+};
+
+// Estado compartilhado pelas tarefas de uma varredura
+struct ContextoVarredura {
+    PoolTarefas& pool;
+    const OpcoesVarredura& opcoes;
+    EstatisticasVarredura* estatisticas;
+    bool incremental;                           // Há uma árvore anterior?
+
+    RestricoesLeitura restricoes;               // Exclusões e dispositivo
+    InstrumentacaoVarredura* instrumentacao;    // Nulo: sem cronometragem
+
+    std::mutex travaRelidas;
+    std::unordered_set<const Nodo*> relidas;    // Pastas relidas (só no incremental)
+
+    MapaVinculos vinculos;                      // Links físicos encontrados
+};
+
+// ----------------------------------------------------------------------------
+// Cria o nó raiz aplicando os mesmos critérios da versão serial: ignora links
+// simbólicos, inexistentes (ou inacessíveis) e tipos especiais. Pastas são
+// devolvidas vazias.
+// ----------------------------------------------------------------------------
+static std::shared_ptr<Nodo> criarRaiz(const fs::path& caminho) {
+    std::error_code ec;
+    if (!fs::exists(caminho, ec) || fs::is_symlink(caminho, ec))
+        return nullptr;
+
+    auto nodo = std::make_shared<Nodo>();
+    nodo->caminho = caminho.string();
+    nodo->nome = caminho.filename().string();
+    nodo->tamanho = 0;
+
+    struct stat st;
+    if (fs::is_regular_file(caminho, ec) && ::stat(nodo->caminho.c_str(), &st) == 0) {
+        MetadadosArquivo m = metadadosArquivo(st);
+        nodo->tipo = "arquivo";
+        nodo->tamanho = m.tamanho;
+        nodo->alocado = m.alocado;
+    } else if (fs::is_directory(caminho, ec)) {
+        nodo->tipo = "pasta";
+    } else {
+        return nullptr;
+    }
+    return nodo;
+}
+
+// ----------------------------------------------------------------------------
+// Soma os contadores locais de uma tarefa às estatísticas globais (os erros
+// são movidos para a tabela)
+// ----------------------------------------------------------------------------
+static void contabilizar(ContextoVarredura& ctx, ContadoresLeitura& cont,
+                         bool reaproveitada, uintmax_t bytes = 0) {
+    if (!ctx.estatisticas) return;
+    EstatisticasVarredura& e = *ctx.estatisticas;
+    e.pastas.fetch_add(1, std::memory_order_relaxed);
+    e.entradas.fetch_add(cont.entradas, std::memory_order_relaxed);
+    e.bytesVistos.fetch_add(bytes, std::memory_order_relaxed);
+    e.chamadasMetadados.fetch_add(cont.chamadasMetadados, std::memory_order_relaxed);
+    e.chamadasDiretorio.fetch_add(cont.chamadasDiretorio, std::memory_order_relaxed);
+    e.metadadosEmLote.fetch_add(cont.metadadosEmLote, std::memory_order_relaxed);
+    e.chamadasAnel.fetch_add(cont.chamadasAnel, std::memory_order_relaxed);
+    e.entradasExcluidas.fetch_add(cont.excluidas, std::memory_order_relaxed);
+    e.erros.anexar(cont.erros);
+    if (ctx.incremental) {
+        (reaproveitada ? e.pastasReaproveitadas : e.pastasRelidas)
+            .fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+static void varrerPasta(Nodo* pasta, const Nodo* anterior, int nivel, ContextoVarredura& ctx);
+
+// Agenda a leitura de uma subpasta (com sua versão anterior, se houver)
+static void agendar(Nodo* sub, const Nodo* anterior, int nivel, ContextoVarredura& ctx) {
+    ctx.pool.submeter([sub, anterior, nivel, &ctx] { varrerPasta(sub, anterior, nivel, ctx); });
+}
+
+// Registra a pasta entre as que precisam ser somadas de novo (incremental)
+static void marcarRelida(Nodo* pasta, ContextoVarredura& ctx) {
+    if (!ctx.incremental) return;
+    std::lock_guard<std::mutex> lock(ctx.travaRelidas);
+    ctx.relidas.insert(pasta);
+}
+
+// ----------------------------------------------------------------------------
+// Tarefa: soma ao nó podado "alvo" os arquivos de uma pasta da subárvore
+// podada e agenda o mesmo para as subpastas. Nenhum nó é criado; os totais
+// chegam ao alvo por fetch_add, em qualquer ordem.
+// ----------------------------------------------------------------------------
+static void somarPodada(Nodo* alvo, const std::string& caminho, ContextoVarredura& ctx) {
+    ContadoresLeitura cont;
+    std::vector<EntradaLida> entradas;
+    uintmax_t tamanho = 0, alocado = 0;
+    uint64_t inicio = ctx.instrumentacao ? instanteNs() : 0;
+    if (listarDiretorio(ctx.opcoes.backend, caminho, entradas, cont, nullptr,
+                        &ctx.restricoes) == ResultadoLeitura::Lida) {
+        for (auto& entrada : entradas) {
+            if (!entrada.pasta) {
+                tamanho += entrada.tamanho;
+                alocado += entrada.alocado;
+                continue;
+            }
+            ctx.pool.submeter([alvo, sub = juntarCaminho(caminho, entrada.nome), &ctx] {
+                somarPodada(alvo, sub, ctx);
+            });
+        }
+    }
+    alvo->tamanho.fetch_add(tamanho, std::memory_order_relaxed);
+    alvo->alocado.fetch_add(alocado, std::memory_order_relaxed);
+    if (ctx.instrumentacao) {
+        ctx.instrumentacao->registrarPasta(caminho, instanteNs() - inicio, cont.nsMetadados, 0);
+    }
+    contabilizar(ctx, cont, false, tamanho);
+}
+
+// ----------------------------------------------------------------------------
+// Pasta no limite de profundidade: fica sem filhos e sem assinatura (para que
+// a próxima atualização incremental não reaproveite uma lista vazia)
+// ----------------------------------------------------------------------------
+static void podarPasta(Nodo* pasta, ContextoVarredura& ctx) {
+    pasta->podada = true;
+    pasta->assinatura = 0;
+    pasta->tamanho = 0;
+    pasta->alocado = 0;
+    if (ctx.estatisticas) {
+        ctx.estatisticas->pastasPodadas.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (ctx.opcoes.somarPodadas) {
+        ctx.pool.submeter([pasta, &ctx] { somarPodada(pasta, pasta->caminho, ctx); });
+    }
+    marcarRelida(pasta, ctx);
+}
+
+// ----------------------------------------------------------------------------
+// Pasta inalterada: copia os filhos da versão anterior sem ler o diretório.
+// Arquivos são compartilhados (o mesmo shared_ptr); subpastas ganham um novo
+// nó, pois podem ter mudado mesmo que esta pasta não tenha, e são conferidas
+// por suas próprias tarefas.
+// ----------------------------------------------------------------------------
+static void reaproveitarPasta(Nodo* pasta, const Nodo* anterior, int nivel,
+                              ContextoVarredura& ctx) {
+    pasta->assinatura = anterior->assinatura;
+    pasta->tamanho = anterior->tamanho.load();
+    pasta->alocado = anterior->alocado.load();
+    pasta->filhos.reserve(anterior->filhos.size());
+    for (const auto& velho : anterior->filhos) {
+        if (velho->tipo != "pasta") {
+            if (velho->vinculo != 0) ctx.vinculos.registrar(velho.get(), pasta);
+            pasta->filhos.push_back(velho);
+            continue;
+        }
+        auto filho = std::make_shared<Nodo>();
+        filho->caminho = velho->caminho;
+        filho->nome = velho->nome;
+        filho->tipo = velho->tipo;
+        filho->tamanho = velho->tamanho.load();
+        filho->alocado = velho->alocado.load();
+        agendar(filho.get(), velho.get(), nivel + 1, ctx);
+        pasta->filhos.push_back(std::move(filho));
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Tarefa: lê as entradas de uma pasta e agenda uma nova tarefa para cada
+// subpasta. Somente esta tarefa altera pasta->filhos, portanto não há disputa;
+// a ordem dos filhos é a ordem de leitura, independente do escalonamento.
+// Com uma versão anterior, a pasta só é lida se a assinatura mudou; as
+// subpastas relidas são associadas às anteriores pelo nome.
+// ----------------------------------------------------------------------------
+static void varrerPasta(Nodo* pasta, const Nodo* anterior, int nivel, ContextoVarredura& ctx) {
+    if (ctx.opcoes.profundidadeMaxima >= 0 && nivel >= ctx.opcoes.profundidadeMaxima) {
+        podarPasta(pasta, ctx);
+        return;
+    }
+
+    ContadoresLeitura cont;
+    uint64_t* destinoAssinatura = &pasta->assinatura;
+    if (anterior && anterior->assinatura != 0) {
+        pasta->assinatura = lerAssinaturaPasta(pasta->caminho, cont);
+        if (pasta->assinatura == anterior->assinatura) {
+            reaproveitarPasta(pasta, anterior, nivel, ctx);
+            contabilizar(ctx, cont, true);
+            return;
+        }
+        destinoAssinatura = nullptr;            // Já lida, antes da listagem
+    }
+
+    std::vector<EntradaLida> entradas;
+    uint64_t inicio = ctx.instrumentacao ? instanteNs() : 0;
+    ResultadoLeitura resultado = listarDiretorio(ctx.opcoes.backend, pasta->caminho, entradas,
+                                                 cont, destinoAssinatura, &ctx.restricoes);
+    uint64_t lida = ctx.instrumentacao ? instanteNs() : 0;
+    if (resultado != ResultadoLeitura::Lida) {
+        // Ponto de montagem de outro sistema de arquivos ou pasta sem acesso
+        // (o erro já está em cont.erros)
+        pasta->podada = true;
+        pasta->assinatura = 0;
+        if (resultado == ResultadoLeitura::OutroDispositivo && ctx.estatisticas) {
+            ctx.estatisticas->pastasOutroSistema.fetch_add(1, std::memory_order_relaxed);
+        }
+        marcarRelida(pasta, ctx);
+        if (ctx.instrumentacao) {
+            ctx.instrumentacao->registrarPasta(pasta->caminho, lida - inicio, cont.nsMetadados, 0);
+        }
+        contabilizar(ctx, cont, false);
+        return;
+    }
+    if (!cont.erros.empty()) {
+        pasta->assinatura = 0;      // Algo ficou de fora por erro: relida na próxima atualização
+    }
+
+    // Subpastas da versão anterior, por nome
+    std::unordered_map<std::string_view, const Nodo*> subpastasAnteriores;
+    if (anterior) {
+        for (const auto& velho : anterior->filhos) {
+            if (velho->tipo == "pasta") subpastasAnteriores.emplace(velho->nome, velho.get());
+        }
+    }
+
+    pasta->filhos.reserve(entradas.size());
+    uintmax_t bytes = 0;
+    for (auto& entrada : entradas) {
+        bytes += entrada.tamanho;
+        auto filho = std::make_shared<Nodo>();
+        filho->caminho = juntarCaminho(pasta->caminho, entrada.nome);
+        filho->nome = std::move(entrada.nome);
+        filho->tipo = entrada.pasta ? "pasta" : "arquivo";
+        filho->tamanho = entrada.tamanho;
+        filho->alocado = entrada.alocado;
+        filho->vinculo = entrada.vinculo;
+        if (entrada.pasta) {
+            auto it = subpastasAnteriores.find(filho->nome);
+            agendar(filho.get(), it != subpastasAnteriores.end() ? it->second : nullptr,
+                    nivel + 1, ctx);
+        } else if (filho->vinculo != 0) {
+            ctx.vinculos.registrar(filho.get(), pasta);
+        }
+        pasta->filhos.push_back(std::move(filho));
+    }
+
+    marcarRelida(pasta, ctx);
+    if (ctx.instrumentacao) {
+        ctx.instrumentacao->registrarPasta(pasta->caminho, lida - inicio, cont.nsMetadados,
+                                           instanteNs() - lida);
+    }
+    contabilizar(ctx, cont, false, bytes);
+}
+
+// ----------------------------------------------------------------------------
+// Soma os tamanhos (aparente e alocado) de baixo para cima (pós-ordem) com
+// pilha explícita, evitando recursão profunda em árvores muito aninhadas.
+// Links repetidos de um mesmo inode não entram nos totais, e pastas podadas
+// mantêm o total calculado por somarPodada.
+// Na atualização incremental ("relidas" não nulo), só são somadas as pastas
+// relidas e seus ancestrais; as demais mantêm o total da versão anterior.
+// ----------------------------------------------------------------------------
+static void agregarTamanhos(Nodo* raiz, std::unordered_set<const Nodo*>* relidas) {
+    std::vector<std::pair<Nodo*, bool>> pilha;   // (nó, filhos já processados?)
+    pilha.emplace_back(raiz, false);
+    while (!pilha.empty()) {
+        auto [nodo, processado] = pilha.back();
+        pilha.pop_back();
+        if (!processado) {
+            pilha.emplace_back(nodo, true);
+            for (const auto& filho : nodo->filhos) {
+                if (filho->tipo == "pasta") pilha.emplace_back(filho.get(), false);
+            }
+            continue;
+        }
+
+        if (relidas) {
+            // Pasta alterada: relida ou com alguma subpasta alterada
+            bool alterada = relidas->count(nodo) > 0;
+            for (size_t i = 0; !alterada && i < nodo->filhos.size(); ++i) {
+                alterada = relidas->count(nodo->filhos[i].get()) > 0;
+            }
+            if (!alterada) continue;
+            relidas->insert(nodo);               // Propaga a alteração ao pai
+        }
+        if (nodo->podada) continue;
+        uintmax_t total = 0, alocado = 0;
+        for (const auto& filho : nodo->filhos) {
+            if (filho->vinculoRepetido) continue;
+            total += filho->tamanho.load(std::memory_order_relaxed);
+            alocado += filho->alocado.load(std::memory_order_relaxed);
+        }
+        nodo->tamanho.store(total, std::memory_order_relaxed);
+        nodo->alocado.store(alocado, std::memory_order_relaxed);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Linha de progresso em std::cerr a cada "intervalo" segundos, escrita por uma
+// thread própria até a destruição. Lê só contadores atômicos já mantidos pela
+// varredura.
+// ----------------------------------------------------------------------------
+class ProgressoVarredura {
+public:
+    ProgressoVarredura(double intervalo, const EstatisticasVarredura& e, const PoolTarefas& pool)
+        : thread([this, intervalo, &e, &pool] { laco(intervalo, e, pool); }) {}
+
+    ~ProgressoVarredura() {
+        {
+            std::lock_guard<std::mutex> lock(trava);
+            fim = true;
+        }
+        sinal.notify_one();
+        thread.join();
+    }
+
+private:
+    void laco(double intervalo, const EstatisticasVarredura& e, const PoolTarefas& pool) {
+        auto periodo = std::chrono::duration<double>(intervalo);
+        uint64_t inicio = instanteNs(), anterior = inicio, entradasAntes = 0;
+        std::unique_lock<std::mutex> lock(trava);
+        while (!sinal.wait_for(lock, periodo, [this] { return fim; })) {
+            uint64_t agora = instanteNs();
+            uint64_t entradas = e.entradas.load(std::memory_order_relaxed);
+            double taxa = static_cast<double>(entradas - entradasAntes) * 1e9
+                        / static_cast<double>(std::max<uint64_t>(agora - anterior, 1));
+            std::ostringstream linha;
+            linha << "[PROGRESSO] " << std::fixed << std::setprecision(1)
+                  << static_cast<double>(agora - inicio) / 1e9 << " s: " << entradas
+                  << " entradas (" << std::setprecision(0) << taxa << "/s), "
+                  << e.pastas.load(std::memory_order_relaxed) << " pastas lidas, "
+                  << pool.tarefasPendentes() << " pendentes, "
+                  << e.bytesVistos.load(std::memory_order_relaxed) << " bytes vistos\n";
+            std::cerr << linha.str() << std::flush;
+            anterior = agora;
+            entradasAntes = entradas;
+        }
+    }
+
+    std::mutex trava;
+    std::condition_variable sinal;
+    bool fim = false;
+    std::thread thread;                 // Último membro: começa com os demais prontos
+};
+
+// ----------------------------------------------------------------------------
+// Executa a varredura a partir de uma raiz já criada
+// ----------------------------------------------------------------------------
+static void executarVarredura(Nodo* raiz, const Nodo* anterior,
+                              const OpcoesVarredura& opcoes,
+                              EstatisticasVarredura* estatisticas) {
+    // Restrições aplicadas pelos backends durante a leitura
+    RestricoesLeitura restricoes;
+    restricoes.profundidadeFila = opcoes.profundidadeFila;
+    if (!opcoes.exclusoes.vazio()) restricoes.exclusoes = &opcoes.exclusoes;
+    if (opcoes.umSistemaArquivos) {
+        restricoes.dispositivo = opcoes.dispositivo;
+        struct stat st;
+        if (restricoes.dispositivo == 0 && ::stat(raiz->caminho.c_str(), &st) == 0) {
+            restricoes.dispositivo = static_cast<uint64_t>(st.st_dev);
+        }
+    }
+
+    InstrumentacaoVarredura* instrumentacao =
+        opcoes.instrumentar && estatisticas ? &estatisticas->instrumentacao : nullptr;
+    restricoes.cronometrar = instrumentacao != nullptr;
+
+    PoolTarefas pool(opcoes.threads);
+    ContextoVarredura ctx{pool, opcoes, estatisticas, anterior != nullptr, restricoes,
+                          instrumentacao};
+    uint64_t inicio = instanteNs();
+    {
+        std::unique_ptr<ProgressoVarredura> progresso;
+        if (opcoes.intervaloProgresso > 0 && estatisticas) {
+            progresso = std::make_unique<ProgressoVarredura>(opcoes.intervaloProgresso,
+                                                             *estatisticas, pool);
+        }
+        agendar(raiz, anterior, 0, ctx);
+        pool.esperar();                    // Todas as pastas foram lidas
+    }
+    uint64_t varrida = instanteNs();
+
+    // Pastas inalteradas cujo arquivo ganhou ou perdeu a posse de um inode
+    // (ex.: o outro link foi apagado) precisam ser somadas de novo
+    if (ctx.incremental) {
+        ctx.vinculos.paraCadaPastaAlterada([&](Nodo* pasta) { ctx.relidas.insert(pasta); });
+    }
+
+    agregarTamanhos(raiz, ctx.incremental ? &ctx.relidas : nullptr);
+    if (instrumentacao) {
+        instrumentacao->registrarVarredura(varrida - inicio);
+        instrumentacao->registrarAgregacao(instanteNs() - varrida);
+    }
+}
+
+// ============================================================================
+// Função: construirArvore (com opções)
+// ============================================================================
+std::shared_ptr<Nodo> construirArvore(const fs::path& caminho,
+                                      const OpcoesVarredura& opcoes,
+                                      EstatisticasVarredura* estatisticas) {
+    auto raiz = criarRaiz(caminho);
+    if (!raiz || raiz->tipo != "pasta") {
+        return raiz;
+    }
+
+    executarVarredura(raiz.get(), nullptr, opcoes, estatisticas);
+    return raiz;
+}
+
+// ============================================================================
+// Função: atualizarArvore
+// ============================================================================
+std::shared_ptr<Nodo> atualizarArvore(const std::shared_ptr<Nodo>& anterior,
+                                      const fs::path& caminho,
+                                      const OpcoesVarredura& opcoes,
+                                      EstatisticasVarredura* estatisticas) {
+    auto raiz = criarRaiz(caminho);
+    if (!raiz || raiz->tipo != "pasta") {
+        return raiz;
+    }
+
+    // Os nós reaproveitados guardam caminhos completos: só serve a mesma raiz
+    const Nodo* base = anterior.get();
+    if (base && (base->tipo != "pasta" || base->caminho != raiz->caminho)) {
+        std::cerr << "[AVISO] Árvore anterior tem outra raiz (" << base->caminho
+                  << "); fazendo varredura completa.\n";
+        base = nullptr;
+    }
+
+    executarVarredura(raiz.get(), base, opcoes, estatisticas);
+    return raiz;
+}
+
+// ============================================================================
+// Função: imprimirEstatisticas
+// ============================================================================
+void imprimirEstatisticas(const EstatisticasVarredura& estatisticas,
+                          std::ostream& out) {
+    uint64_t entradas = estatisticas.entradas.load();
+    uint64_t metadados = estatisticas.chamadasMetadados.load();
+    uint64_t diretorio = estatisticas.chamadasDiretorio.load();
+    uint64_t anel = estatisticas.chamadasAnel.load();
+
+    out << "[INFO] Varredura: " << estatisticas.pastas.load() << " pastas, "
+        << entradas << " entradas\n"
+        << "[INFO] Chamadas de metadados: " << metadados
+        << ", de leitura de diretório: " << diretorio;
+    if (anel > 0) out << ", io_uring_enter: " << anel;
+    out << "\n";
+    if (entradas > 0) {
+        out << "[INFO] Chamadas de sistema por entrada: "
+            << static_cast<double>(metadados + diretorio + anel) / entradas << "\n";
+    }
+    uint64_t emLote = estatisticas.metadadosEmLote.load();
+    if (emLote > 0) {
+        out << "[INFO] io_uring: " << emLote << " statx em lote ("
+            << static_cast<double>(emLote) / std::max<uint64_t>(anel, 1)
+            << " por io_uring_enter)\n";
+    }
+    uint64_t reaproveitadas = estatisticas.pastasReaproveitadas.load();
+    uint64_t relidas = estatisticas.pastasRelidas.load();
+    if (reaproveitadas + relidas > 0) {
+        out << "[INFO] Atualização incremental: " << reaproveitadas
+            << " pastas inalteradas (puladas), " << relidas << " relidas\n";
+    }
+    uint64_t excluidas = estatisticas.entradasExcluidas.load();
+    uint64_t podadas = estatisticas.pastasPodadas.load();
+    uint64_t outroSistema = estatisticas.pastasOutroSistema.load();
+    if (excluidas + podadas + outroSistema > 0) {
+        out << "[INFO] Limites: " << excluidas << " entradas excluídas, " << podadas
+            << " pastas podadas pela profundidade, " << outroSistema
+            << " em outro sistema de arquivos\n";
+    }
+}
+
+// ============================================================================
+// Função: gravarRelatorioJson
+// ============================================================================
+bool gravarRelatorioJson(const EstatisticasVarredura& estatisticas, const std::string& arquivo) {
+    auto saida = abrirSaida(arquivo);
+    if (!saida) return false;
+    SaidaBufferizada& out = *saida;
+    auto campo = [&](std::string_view nome, uint64_t valor) {
+        out.escrever("\"");
+        out.escrever(nome);
+        out.escrever("\":");
+        out.escreverNumero(valor);
+        out.escrever(',');
+    };
+
+    out.escrever("{\"contadores\":{");
+    campo("pastas", estatisticas.pastas.load());
+    campo("entradas", estatisticas.entradas.load());
+    campo("bytes_vistos", estatisticas.bytesVistos.load());
+    campo("chamadas_metadados", estatisticas.chamadasMetadados.load());
+    campo("chamadas_diretorio", estatisticas.chamadasDiretorio.load());
+    campo("statx_em_lote", estatisticas.metadadosEmLote.load());
+    campo("chamadas_io_uring_enter", estatisticas.chamadasAnel.load());
+    campo("pastas_reaproveitadas", estatisticas.pastasReaproveitadas.load());
+    campo("pastas_relidas", estatisticas.pastasRelidas.load());
+    campo("entradas_excluidas", estatisticas.entradasExcluidas.load());
+    campo("pastas_podadas", estatisticas.pastasPodadas.load());
+    out.escrever("\"pastas_outro_sistema\":");
+    out.escreverNumero(estatisticas.pastasOutroSistema.load());
+
+    // Erros por tipo: {"codigo":13,"mensagem":"Permission denied","quantidade":2}
+    out.escrever("},\"erros\":[");
+    bool primeiro = true;
+    for (const auto& [codigo, n] : estatisticas.erros.contagemPorCodigo()) {
+        if (!primeiro) out.escrever(',');
+        primeiro = false;
+        out.escrever("{");
+        campo("codigo", static_cast<uint64_t>(codigo));
+        out.escrever("\"mensagem\":\"");
+        out.escreverJson(std::generic_category().message(codigo));
+        out.escrever("\",\"quantidade\":");
+        out.escreverNumero(n);
+        out.escrever("}");
+    }
+    out.escrever("]");
+    if (estatisticas.instrumentacao.pastas() > 0) {
+        out.escrever(",\"instrumentacao\":");
+        escreverInstrumentacaoJson(estatisticas.instrumentacao, out);
+    }
+    out.escrever("}\n");
+
+    std::string erro;
+    if (!out.fechar(&erro)) {
+        std::cerr << "[ERRO] Falha ao gravar " << arquivo << ": " << erro << "\n";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,134 @@
+// ============================================================================
+// Arquivo: varredura.hpp
+// Finalidade: Declarar a varredura configurável do sistema de arquivos, que
+//             pode distribuir a leitura dos diretórios entre várias threads e
+//             escolher como os metadados de cada entrada são obtidos.
+// ============================================================================
+#ifndef VARREDURA_HPP
+#define VARREDURA_HPP
+
+#include <atomic>                     // Contadores compartilhados
+#include <cstdint>                    // uint64_t
+#include <memory>                     // Para std::shared_ptr
+#include <filesystem>                 // Para std::filesystem::path
+#include <ostream>                    // Para o relatório de estatísticas
+#include <string>                     // Arquivo do relatório JSON
+#include "nodo.hpp"                   // Estrutura de dados Nodo
+#include "leitor_diretorio.hpp"       // BackendVarredura
+#include "instrumentacao.hpp"         // InstrumentacaoVarredura
+
+// ============================================================================
+// Estrutura: OpcoesVarredura
+// Objetivo: Reunir os parâmetros que controlam como a árvore é construída.
+// ============================================================================
+struct OpcoesVarredura {
+    unsigned threads = 1;  // Número de threads (1 = serial, 0 = todos os núcleos)
+    BackendVarredura backend = BackendVarredura::Portavel;  // Origem dos metadados
+    // IoUring: statx em voo por thread. Os lotes são por pasta (os statx de
+    // uma pasta terminam antes da próxima ser lida), então o número em voo é
+    // no máximo o de arquivos da pasta: em árvores de pastas pequenas, um
+    // valor alto não aumenta a concorrência.
+    unsigned profundidadeFila = 256;
+
+    // Limites da varredura (veja construirArvore)
+    bool umSistemaArquivos = false;  // Não entra em pastas de outro st_dev
+    uint64_t dispositivo = 0;        // st_dev exigido com umSistemaArquivos (0 = o da raiz)
+    PadroesExclusao exclusoes;       // Entradas ignoradas antes de qualquer stat
+    int profundidadeMaxima = -1;     // Pastas neste nível não são lidas (-1 = sem limite)
+    bool somarPodadas = false;       // Soma o tamanho das subárvores podadas pela profundidade
+
+    // Acompanhamento (só com estatísticas; veja construirArvore)
+    double intervaloProgresso = 0;   // Segundos entre as linhas de progresso (0 = nenhuma)
+    bool instrumentar = false;       // Mede fases e pastas em EstatisticasVarredura::instrumentacao
+};
+
+// ============================================================================
+// Estrutura: EstatisticasVarredura
+// Objetivo: Contar entradas e chamadas de sistema feitas durante a varredura,
+//           para comparar o custo dos backends (chamadas por entrada).
+// ============================================================================
+struct EstatisticasVarredura {
+    std::atomic<uint64_t> pastas{0};             // Diretórios lidos
+    std::atomic<uint64_t> entradas{0};           // Entradas encontradas
+    std::atomic<uint64_t> chamadasMetadados{0};  // stat/lstat/statx/fstatat
+    std::atomic<uint64_t> chamadasDiretorio{0};  // open/getdents64/close (estimadas no portável)
+    std::atomic<uint64_t> metadadosEmLote{0};    // statx enviados pelo io_uring
+    std::atomic<uint64_t> chamadasAnel{0};       // io_uring_enter
+    std::atomic<uint64_t> bytesVistos{0};        // Tamanho dos arquivos lidos até agora
+    std::atomic<uint64_t> pastasReaproveitadas{0}; // Incremental: não relidas
+    std::atomic<uint64_t> pastasRelidas{0};        // Incremental: relidas
+    std::atomic<uint64_t> entradasExcluidas{0};    // Descartadas pelos padrões
+    std::atomic<uint64_t> pastasPodadas{0};        // Limite de profundidade
+    std::atomic<uint64_t> pastasOutroSistema{0};   // Outro sistema de arquivos
+    TabelaErros erros;                             // Caminhos que não puderam ser lidos
+    InstrumentacaoVarredura instrumentacao;        // Preenchida com OpcoesVarredura::instrumentar
+};
+
+// ============================================================================
+// Função: construirArvore
+// Objetivo: Construir a árvore segundo as opções fornecidas. Cada
+//           subdiretório vira uma tarefa de um pool com roubo de tarefas e os
+//           tamanhos das pastas são somados de baixo para cima depois que
+//           todos os filhos terminam.
+//           Limites (OpcoesVarredura):
+//           - Exclusões: a entrada cujo nome (ou caminho) casa com um padrão
+//             não aparece na árvore nem nos totais.
+//           - umSistemaArquivos: uma pasta de outro dispositivo (ponto de
+//             montagem) aparece vazia, com tamanho 0 e Nodo::podada.
+//           - profundidadeMaxima: as pastas desse nível (a raiz é o nível 0)
+//             aparecem sem filhos e com Nodo::podada. Com somarPodadas, o
+//             conteúdo delas é lido só para somar os tamanhos, sem criar nós
+//             (links físicos dentro delas são contados a cada link).
+//           Erros de leitura não interrompem a varredura: uma pasta que não
+//           pode ser aberta aparece vazia e com Nodo::podada, uma entrada
+//           que não pode ser consultada fica fora da árvore, e ambas vão
+//           para estatisticas->erros.
+//           Acompanhamento (exige "estatisticas"): com intervaloProgresso,
+//           uma thread escreve em std::cerr, a cada intervalo, entradas/s,
+//           pastas pendentes e bytes vistos; com instrumentar, cada pasta
+//           tem a leitura cronometrada. Sem os dois, o custo é um teste por
+//           pasta.
+// Entrada: Caminho inicial, opções de varredura e, opcionalmente, onde
+//          acumular as estatísticas
+// Saída:   Ponteiro para o nó raiz, idêntico ao produzido pela versão serial
+//          (mesma ordem dos filhos, que segue a ordem de leitura do diretório)
+// ============================================================================
+std::shared_ptr<Nodo> construirArvore(const std::filesystem::path& caminho,
+                                      const OpcoesVarredura& opcoes,
+                                      EstatisticasVarredura* estatisticas = nullptr);
+
+// ============================================================================
+// Função: atualizarArvore
+// Objetivo: Atualização incremental a partir de uma árvore anterior (mesma
+//           raiz). Cada pasta é conferida com um único stat: se a assinatura
+//           (inode, mtime, ctime) não mudou, seus filhos são copiados da versão
+//           anterior sem ler o diretório; caso contrário, ela é relida. As
+//           subpastas são sempre conferidas, e somente as pastas relidas e
+//           seus ancestrais têm o tamanho somado novamente.
+// Limitação: a mtime de uma pasta muda quando entradas são criadas, removidas
+//           ou renomeadas, mas não quando um arquivo existente é reescrito no
+//           lugar; nesse caso o tamanho antigo do arquivo é mantido.
+// Entrada: Árvore anterior (pode ser nula = varredura completa), caminho,
+//          opções e estatísticas (com as contagens de pastas puladas/relidas)
+// ============================================================================
+std::shared_ptr<Nodo> atualizarArvore(const std::shared_ptr<Nodo>& anterior,
+                                      const std::filesystem::path& caminho,
+                                      const OpcoesVarredura& opcoes,
+                                      EstatisticasVarredura* estatisticas = nullptr);
+
+// ============================================================================
+// Função: imprimirEstatisticas
+// Objetivo: Escrever um resumo das estatísticas (inclui chamadas por entrada).
+// ============================================================================
+void imprimirEstatisticas(const EstatisticasVarredura& estatisticas,
+                          std::ostream& out);
+
+// ============================================================================
+// Função: gravarRelatorioJson
+// Objetivo: Gravar em "arquivo" ("-" = saída padrão) os contadores, os erros
+//           por tipo e, se houver, a instrumentação, como um objeto JSON.
+// Retorno: false se o arquivo não pôde ser gravado
+// ============================================================================
+bool gravarRelatorioJson(const EstatisticasVarredura& estatisticas, const std::string& arquivo);
+
+#endif // VARREDURA_HPP